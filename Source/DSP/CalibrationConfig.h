@@ -4,7 +4,8 @@
     CalibrationConfig.h
     Centralized calibration configuration for GRAIN DSP pipeline (Task 007b).
     All tuning values grouped by module as typed structs.
-    Compile-time only — no file I/O, no runtime loading.
+    Defaults are compiled in; profiles can be loaded at runtime
+    (State/CalibrationProfileFile) and hot-swapped via PreparedCalibration.
 
   ==============================================================================
 */
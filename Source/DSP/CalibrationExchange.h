@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    CalibrationExchange.h
+    Lock-free hand-over of prepared calibrations to the audio thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "PreparedCalibration.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace GrainDSP
+{
+//==============================================================================
+/**
+ * Read-copy-update slot for PreparedCalibration.
+ *
+ * Writer side (message thread, or prepareToPlay — one writer at a time):
+ * publish() swaps in a new object and retires the previous one. Retired
+ * objects are deleted by publish() / collectGarbage(), never by the reader.
+ *
+ * Reader side (audio thread): acquire() returns the newest object and keeps
+ * it alive until the reader's next acquire(). Its hazard pointer is what
+ * the writer checks before deleting: the reader announces the object, then
+ * confirms it is still current, so the writer either sees the announcement
+ * or the reader sees the newer object and moves on. Two loads and a store
+ * per call, no allocation, and the reader never waits for the writer.
+ */
+class CalibrationExchange
+{
+public:
+    CalibrationExchange() = default;
+    CalibrationExchange(const CalibrationExchange&) = delete;
+    CalibrationExchange& operator=(const CalibrationExchange&) = delete;
+
+    /**
+     * Make a new calibration current. Writer side only.
+     * @param next Prepared calibration to hand to the reader
+     */
+    void publish(std::unique_ptr<const PreparedCalibration> next)
+    {
+        current.store(next.get(), std::memory_order_seq_cst);
+
+        if (latest != nullptr)
+        {
+            retired.push_back(std::move(latest));
+        }
+
+        latest = std::move(next);
+        collectGarbage();
+    }
+
+    /** Delete retired calibrations the reader no longer holds. Writer side only. */
+    void collectGarbage()
+    {
+        const PreparedCalibration* held = inUse.load(std::memory_order_seq_cst);
+        retired.erase(std::remove_if(retired.begin(), retired.end(),
+                                     [held](const std::unique_ptr<const PreparedCalibration>& calibration)
+                                     { return calibration.get() != held; }),
+                      retired.end());
+    }
+
+    /**
+     * Newest published calibration. Reader side only (one reader thread at a time).
+     * @return Calibration valid until the next acquire(), or nullptr before the first publish()
+     */
+    const PreparedCalibration* acquire()
+    {
+        const PreparedCalibration* candidate = current.load(std::memory_order_seq_cst);
+
+        for (;;)
+        {
+            inUse.store(candidate, std::memory_order_seq_cst);
+            const PreparedCalibration* confirmed = current.load(std::memory_order_seq_cst);
+
+            if (confirmed == candidate)
+            {
+                return candidate;
+            }
+
+            candidate = confirmed;  // A publish() raced the announcement: announce the newer one
+        }
+    }
+
+    /** @return Retired calibrations still waiting for the reader to let go. Writer side only. */
+    int getNumRetired() const { return static_cast<int>(retired.size()); }
+
+private:
+    std::atomic<const PreparedCalibration*> current{nullptr};
+    std::atomic<const PreparedCalibration*> inUse{nullptr};  // Reader's hazard pointer
+
+    // Writer side only
+    std::unique_ptr<const PreparedCalibration> latest;
+    std::vector<std::unique_ptr<const PreparedCalibration>> retired;
+};
+
+}  // namespace GrainDSP
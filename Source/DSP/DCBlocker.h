@@ -30,10 +30,18 @@ struct DCBlocker
      * @param sampleRate Sample rate in Hz
      * @param cal DC blocker calibration parameters
      */
-    void prepare(float sampleRate, const DCBlockerCalibration& cal)
+    void prepare(float sampleRate, const DCBlockerCalibration& cal) { coeff = calculateCoeff(sampleRate, cal); }
+
+    /**
+     * Calculate the feedback coefficient for a sample rate.
+     * @param sampleRate Sample rate in Hz
+     * @param cal DC blocker calibration parameters
+     * @return Value for coeff
+     */
+    static float calculateCoeff(float sampleRate, const DCBlockerCalibration& cal)
     {
         constexpr float kTwoPi = 6.283185307f;
-        coeff = 1.0f - (kTwoPi * cal.cutoffHz / sampleRate);
+        return 1.0f - (kTwoPi * cal.cutoffHz / sampleRate);
     }
 
     /**
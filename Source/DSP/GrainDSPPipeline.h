@@ -6,7 +6,7 @@
     Each instance is mono — stereo is managed by creating two instances.
 
     Signal chain (with oversampling):
-    [Upsample] → Dynamic Bias → Waveshaper → Warmth → Focus → [Downsample] → Mix → DC Blocker → Gain
+    [Upsample] → Dynamic Bias → Waveshaper → Warmth → Focus → [Downsample] → DC Blocker → Mix → Gain
 
   ==============================================================================
 */
@@ -17,12 +17,25 @@
 #include "DCBlocker.h"
 #include "DSPHelpers.h"
 #include "DynamicBias.h"
+#include "PreparedCalibration.h"
 #include "SpectralFocus.h"
 #include "WarmthProcessor.h"
 #include "Waveshaper.h"
 
 namespace GrainDSP
 {
+//==============================================================================
+/** Filter memory of one DSPPipeline (coefficients are derived from parameters, not state). */
+struct PipelineState
+{
+    float dcX1 = 0.0f;
+    float dcY1 = 0.0f;
+    float lowShelfZ1 = 0.0f;
+    float lowShelfZ2 = 0.0f;
+    float highShelfZ1 = 0.0f;
+    float highShelfZ2 = 0.0f;
+};
+
 //==============================================================================
 /**
  * Per-channel DSP pipeline. Owns all stateful modules for one channel.
@@ -46,6 +59,19 @@ struct DSPPipeline
         spectralFocus.prepare(sampleRate, focusMode, cal.focus);
     }
 
+    /**
+     * Adopt a prepared calibration: coefficients are copied in, filter state is kept.
+     * No math and no allocation, so it is safe mid-stream on the audio thread.
+     * @param prepared Calibration prepared at this pipeline's sample rate
+     * @param focusMode Current spectral focus mode
+     */
+    void setCalibration(const PreparedCalibration& prepared, FocusMode focusMode)
+    {
+        config = prepared.config;
+        dcBlocker.coeff = prepared.dcBlockerCoeff;
+        spectralFocus.setCoefficients(prepared.getFocus(focusMode));
+    }
+
     /**
      * Update spectral focus coefficients for a new mode.
      * Does NOT reset filter state (avoids clicks on mode change).
@@ -66,6 +92,36 @@ struct DSPPipeline
         spectralFocus.reset();
     }
 
+    /**
+     * Capture the filter memory of every stateful module.
+     * @return State that setState() resumes from exactly
+     */
+    PipelineState getState() const
+    {
+        PipelineState state;
+        state.dcX1 = dcBlocker.x1;
+        state.dcY1 = dcBlocker.y1;
+        state.lowShelfZ1 = spectralFocus.lowShelf.z1;
+        state.lowShelfZ2 = spectralFocus.lowShelf.z2;
+        state.highShelfZ1 = spectralFocus.highShelf.z1;
+        state.highShelfZ2 = spectralFocus.highShelf.z2;
+        return state;
+    }
+
+    /**
+     * Restore filter memory captured by getState(). Coefficients are untouched.
+     * @param state Previously captured state
+     */
+    void setState(const PipelineState& state)
+    {
+        dcBlocker.x1 = state.dcX1;
+        dcBlocker.y1 = state.dcY1;
+        spectralFocus.lowShelf.z1 = state.lowShelfZ1;
+        spectralFocus.lowShelf.z2 = state.lowShelfZ2;
+        spectralFocus.highShelf.z1 = state.highShelfZ1;
+        spectralFocus.highShelf.z2 = state.highShelfZ2;
+    }
+
     /**
      * Process the nonlinear ("wet") stages of the DSP chain.
      * Runs at oversampled rate when oversampling is active.
@@ -84,9 +140,11 @@ struct DSPPipeline
     }
 
     /**
-     * Process the linear stages: dry/wet mix, DC blocker, output gain.
+     * Process the linear stages: DC blocker (wet only), dry/wet mix, output gain.
      * Runs at original sample rate (no need to oversample linear operations).
-     * @param dry The original dry signal
+     * Only the wet carries the bias offset, so the dry passes untouched: at mix 0 the
+     * output is exactly dry × gain.
+     * @param dry The original dry signal, aligned with the wet (see LatencyDelay)
      * @param wet The processed wet signal (from processWet, after downsampling)
      * @param mix Mix amount (0.0 = full dry, 1.0 = full wet)
      * @param gain Linear gain multiplier (1.0 = unity)
@@ -94,9 +152,8 @@ struct DSPPipeline
      */
     float processMixGain(float dry, float wet, float mix, float gain)
     {
-        const float mixed = applyMix(dry, wet, mix);
-        const float dcBlocked = dcBlocker.process(mixed);
-        return applyGain(dcBlocked, gain);
+        const float dcBlocked = dcBlocker.process(wet);
+        return applyGain(applyMix(dry, dcBlocked, mix), gain);
     }
 
     /**
@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    LatencyDelay.h
+    Whole-sample delay that lines the dry signal up with the oversampled wet.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace GrainDSP
+{
+//==============================================================================
+/**
+ * Delays each channel by a fixed number of samples, one block at a time.
+ *
+ * The wet path comes back from the oversampler late by its latency; delaying
+ * the dry by the same amount before the mix keeps partial mixes free of comb
+ * filtering and makes a bypassed output the input delayed by exactly the
+ * latency the host compensates for.
+ *
+ * Each channel line holds latency samples of history followed by the current
+ * block, so a block costs two copies and a move of the history.
+ * prepare() allocates; process() does not.
+ */
+class LatencyDelay
+{
+public:
+    /**
+     * Allocate the lines and clear them.
+     * @param numChannels Channels to delay
+     * @param latencySamples Delay in samples (negative values are treated as 0)
+     * @param maxBlockSize Largest block passed to process()
+     */
+    void prepare(int numChannels, int latencySamples, int maxBlockSize)
+    {
+        latency = std::max(latencySamples, 0);
+        blockCapacity = std::max(maxBlockSize, 0);
+        lines.assign(static_cast<size_t>(std::max(numChannels, 0)),
+                     std::vector<float>(static_cast<size_t>(latency + blockCapacity), 0.0f));
+    }
+
+    /** Clear the history (the next latency output samples are silence). */
+    void reset()
+    {
+        for (auto& line : lines)
+        {
+            std::fill(line.begin(), line.end(), 0.0f);
+        }
+    }
+
+    /** @return The delay in samples */
+    int getLatency() const { return latency; }
+
+    /**
+     * Delay one block of a channel in place.
+     * @param channel Channel index (ignored if out of range)
+     * @param samples Block to delay, replaced by the delayed block
+     * @param numSamples Block length, at most the prepared maxBlockSize
+     */
+    void process(int channel, float* samples, int numSamples)
+    {
+        if (channel < 0 || channel >= static_cast<int>(lines.size()) || numSamples <= 0 || latency == 0)
+        {
+            return;
+        }
+
+        numSamples = std::min(numSamples, blockCapacity);
+        float* line = lines[static_cast<size_t>(channel)].data();
+        const auto blockBytes = sizeof(float) * static_cast<size_t>(numSamples);
+
+        std::memcpy(line + latency, samples, blockBytes);
+        std::memcpy(samples, line, blockBytes);
+        std::memmove(line, line + numSamples, sizeof(float) * static_cast<size_t>(latency));
+    }
+
+    /**
+     * Replace a channel's history, e.g. after restoring a processor state.
+     * @param channel Channel index (ignored if out of range)
+     * @param recent The most recent input samples, oldest first
+     * @param numSamples Number of samples in recent; only the last getLatency() are used,
+     *                   and a shorter history is padded with leading silence
+     */
+    void setHistory(int channel, const float* recent, int numSamples)
+    {
+        if (channel < 0 || channel >= static_cast<int>(lines.size()))
+        {
+            return;
+        }
+
+        float* line = lines[static_cast<size_t>(channel)].data();
+        const int numCopied = std::clamp(numSamples, 0, latency);
+
+        std::fill(line, line + (latency - numCopied), 0.0f);
+        std::memcpy(line + (latency - numCopied), recent + (numSamples - numCopied),
+                    sizeof(float) * static_cast<size_t>(numCopied));
+    }
+
+private:
+    int latency = 0;
+    int blockCapacity = 0;
+    std::vector<std::vector<float>> lines;
+};
+
+}  // namespace GrainDSP
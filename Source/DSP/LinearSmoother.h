@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    LinearSmoother.h
+    Linear parameter ramp with plain-data state.
+    Behaves exactly like juce::SmoothedValue<float> (linear), but every
+    field is public so a ramp can be captured and resumed mid-way.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cmath>
+
+namespace GrainDSP
+{
+//==============================================================================
+/**
+ * Linear ramp towards a target over a fixed number of steps.
+ * Sample-for-sample identical to juce::SmoothedValue<float, Linear>: same
+ * step computation, same countdown and same snap to the target on the last
+ * step. Trivially copyable — the whole struct is its own snapshot.
+ */
+struct LinearSmoother
+{
+    float current = 0.0f;
+    float target = 0.0f;
+    float step = 0.0f;
+    int countdown = 0;      ///< Steps left in the current ramp
+    int stepsToTarget = 0;  ///< Ramp length for new targets
+
+    /**
+     * Set the ramp length and jump to the current target.
+     * @param sampleRate Rate at which getNextValue() is called
+     * @param rampLengthSeconds Ramp duration
+     */
+    void reset(double sampleRate, double rampLengthSeconds)
+    {
+        stepsToTarget = static_cast<int>(std::floor(rampLengthSeconds * sampleRate));
+        setCurrentAndTargetValue(target);
+    }
+
+    /** Jump to a value without ramping. */
+    void setCurrentAndTargetValue(float newValue)
+    {
+        current = newValue;
+        target = newValue;
+        countdown = 0;
+    }
+
+    /** Start a ramp from the current value to a new target (no-op if the target is unchanged). */
+    void setTargetValue(float newValue)
+    {
+        if (newValue == target)
+        {
+            return;
+        }
+
+        if (stepsToTarget <= 0)
+        {
+            setCurrentAndTargetValue(newValue);
+            return;
+        }
+
+        target = newValue;
+        countdown = stepsToTarget;
+        step = (target - current) / static_cast<float>(countdown);
+    }
+
+    /** Advance one step. @return The new current value */
+    float getNextValue()
+    {
+        if (!isSmoothing())
+        {
+            return target;
+        }
+
+        --countdown;
+        current = isSmoothing() ? current + step : target;
+        return current;
+    }
+
+    /** @return true while a ramp is in progress. */
+    bool isSmoothing() const { return countdown > 0; }
+
+    float getCurrentValue() const { return current; }
+    float getTargetValue() const { return target; }
+};
+
+}  // namespace GrainDSP
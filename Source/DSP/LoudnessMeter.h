@@ -0,0 +1,306 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.h
+    ITU-R BS.1770-4 / EBU R128 loudness meter.
+    K-weighting + 100 ms gating blocks: momentary, short-term and integrated.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace GrainDSP
+{
+//==============================================================================
+/**
+ * BS.1770 loudness meter (mono or stereo).
+ *
+ * Per sample: two K-weighting biquads per channel and one squared
+ * accumulate — O(1), no allocation. Every 100 ms the accumulated energy
+ * becomes one sub-block:
+ *   - momentary  = mean of the last 4 sub-blocks (400 ms)
+ *   - short-term = mean of the last 30 sub-blocks (3 s)
+ *   - integrated = 400 ms blocks (75 % overlap) gated at -70 LUFS absolute
+ *                  and -10 LU relative, via a 0.1 LU histogram so the cost
+ *                  stays constant no matter how long the programme runs.
+ *
+ * Filter coefficients follow the libebur128 closed forms, so any sample
+ * rate (not only 48 kHz) is measured correctly.
+ */
+struct LoudnessMeter
+{
+    static constexpr float kSilenceLufs = -120.0f;
+    static constexpr double kAbsoluteGateLufs = -70.0;
+    static constexpr double kRelativeGateLu = -10.0;
+    static constexpr int kMomentaryBlocks = 4;   // 400 ms
+    static constexpr int kShortTermBlocks = 30;  // 3 s
+    static constexpr int kHistogramBins = 750;   // -70 … +5 LUFS in 0.1 LU steps
+    static constexpr double kHistogramStepLu = 0.1;
+
+    /**
+     * Prepare filters and sub-block length for a sample rate.
+     * @param sampleRate Sample rate in Hz
+     */
+    void prepare(double sampleRate)
+    {
+        const double fs = sampleRate > 0.0 ? sampleRate : 48000.0;
+        constexpr double kPi = 3.14159265358979323846;
+
+        // Stage 1: high shelf (head model)
+        {
+            const double f0 = 1681.974450955533;
+            const double gainDb = 3.999843853973347;
+            const double q = 0.7071752369554196;
+            const double k = std::tan(kPi * f0 / fs);
+            const double vh = std::pow(10.0, gainDb / 20.0);
+            const double vb = std::pow(vh, 0.4996667741545416);
+            const double a0 = 1.0 + k / q + k * k;
+
+            shelf.b0 = (vh + vb * k / q + k * k) / a0;
+            shelf.b1 = 2.0 * (k * k - vh) / a0;
+            shelf.b2 = (vh - vb * k / q + k * k) / a0;
+            shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+            shelf.a2 = (1.0 - k / q + k * k) / a0;
+        }
+
+        // Stage 2: RLB high-pass
+        {
+            const double f0 = 38.13547087602444;
+            const double q = 0.5003270373238773;
+            const double k = std::tan(kPi * f0 / fs);
+            const double a0 = 1.0 + k / q + k * k;
+
+            highPass.b0 = 1.0;
+            highPass.b1 = -2.0;
+            highPass.b2 = 1.0;
+            highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+            highPass.a2 = (1.0 - k / q + k * k) / a0;
+        }
+
+        subBlockLength = std::max(1, static_cast<int>(std::lround(fs * 0.1)));
+
+        // Bin-centre energies for the gating histogram (keeps pow() out of the update path)
+        for (size_t bin = 0; bin < binEnergy.size(); ++bin)
+        {
+            binEnergy[bin] = lufsToEnergy(kAbsoluteGateLufs + (static_cast<double>(bin) + 0.5) * kHistogramStepLu);
+        }
+
+        reset();
+    }
+
+    /**
+     * Clear all filter state, sub-blocks and the integrated history.
+     */
+    void reset()
+    {
+        for (auto& state : channelState)
+        {
+            state = {};
+        }
+
+        subBlockEnergy.fill(0.0);
+        histogram.fill(0);
+        accumulator = 0.0;
+        samplesInSubBlock = 0;
+        subBlockWritePos = 0;
+        subBlocksCollected = 0;
+        momentaryLufs = kSilenceLufs;
+        shortTermLufs = kSilenceLufs;
+        integratedLufs = kSilenceLufs;
+    }
+
+    /**
+     * Clear only the integrated (gated) history — e.g. when playback restarts.
+     */
+    void resetIntegrated()
+    {
+        histogram.fill(0);
+        integratedLufs = kSilenceLufs;
+    }
+
+    /**
+     * Measure a block.
+     * @param left Left (or mono) channel samples
+     * @param right Right channel samples, or nullptr for mono
+     * @param numSamples Number of samples
+     * @return true if at least one 100 ms sub-block completed (readings updated)
+     */
+    bool process(const float* left, const float* right, int numSamples)
+    {
+        bool updated = false;
+        int pos = 0;
+
+        while (pos < numSamples)
+        {
+            const int chunk = std::min(numSamples - pos, subBlockLength - samplesInSubBlock);
+
+            accumulator += weightedEnergy(channelState[0], left + pos, chunk);
+            if (right != nullptr)
+            {
+                accumulator += weightedEnergy(channelState[1], right + pos, chunk);
+            }
+
+            pos += chunk;
+            samplesInSubBlock += chunk;
+
+            if (samplesInSubBlock >= subBlockLength)
+            {
+                completeSubBlock();
+                updated = true;
+            }
+        }
+
+        return updated;
+    }
+
+    /** @return Momentary loudness (400 ms) in LUFS */
+    float getMomentaryLufs() const { return momentaryLufs; }
+
+    /** @return Short-term loudness (3 s) in LUFS */
+    float getShortTermLufs() const { return shortTermLufs; }
+
+    /** @return Gated integrated loudness in LUFS */
+    float getIntegratedLufs() const { return integratedLufs; }
+
+private:
+    //==============================================================================
+    struct Coefficients
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+    };
+
+    struct ChannelState
+    {
+        double shelfZ1 = 0.0, shelfZ2 = 0.0;
+        double highPassZ1 = 0.0, highPassZ2 = 0.0;
+    };
+
+    /** K-weight a run of samples (transposed direct form II) and return the sum of squares. */
+    double weightedEnergy(ChannelState& state, const float* input, int numSamples) const
+    {
+        double energy = 0.0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto x = static_cast<double>(input[i]);
+
+            const double s = shelf.b0 * x + state.shelfZ1;
+            state.shelfZ1 = shelf.b1 * x - shelf.a1 * s + state.shelfZ2;
+            state.shelfZ2 = shelf.b2 * x - shelf.a2 * s;
+
+            const double y = highPass.b0 * s + state.highPassZ1;
+            state.highPassZ1 = highPass.b1 * s - highPass.a1 * y + state.highPassZ2;
+            state.highPassZ2 = highPass.b2 * s - highPass.a2 * y;
+
+            energy += y * y;
+        }
+
+        return energy;
+    }
+
+    static float energyToLufs(double meanSquare)
+    {
+        return meanSquare > 1.0e-12 ? static_cast<float>(-0.691 + 10.0 * std::log10(meanSquare)) : kSilenceLufs;
+    }
+
+    static double lufsToEnergy(double lufs) { return std::pow(10.0, (lufs + 0.691) / 10.0); }
+
+    /** Mean energy of the most recent `count` sub-blocks. */
+    double meanOfRecent(int count) const
+    {
+        const int available = std::min(count, subBlocksCollected);
+        double sum = 0.0;
+
+        for (int i = 1; i <= available; ++i)
+        {
+            const int index = (subBlockWritePos - i + kShortTermBlocks) % kShortTermBlocks;
+            sum += subBlockEnergy[static_cast<size_t>(index)];
+        }
+
+        return available > 0 ? sum / static_cast<double>(available) : 0.0;
+    }
+
+    void completeSubBlock()
+    {
+        subBlockEnergy[static_cast<size_t>(subBlockWritePos)] = accumulator / static_cast<double>(subBlockLength);
+        subBlockWritePos = (subBlockWritePos + 1) % kShortTermBlocks;
+        subBlocksCollected = std::min(subBlocksCollected + 1, kShortTermBlocks);
+        accumulator = 0.0;
+        samplesInSubBlock = 0;
+
+        const double momentaryEnergy = meanOfRecent(kMomentaryBlocks);
+        momentaryLufs = energyToLufs(momentaryEnergy);
+        shortTermLufs = energyToLufs(meanOfRecent(kShortTermBlocks));
+
+        // Each completed 400 ms block (stepped by 100 ms = 75 % overlap) feeds the gate
+        if (subBlocksCollected >= kMomentaryBlocks && momentaryLufs >= kAbsoluteGateLufs)
+        {
+            const auto bin = static_cast<int>((momentaryLufs - kAbsoluteGateLufs) / kHistogramStepLu);
+            ++histogram[static_cast<size_t>(std::clamp(bin, 0, kHistogramBins - 1))];
+            updateIntegrated();
+        }
+    }
+
+    void updateIntegrated()
+    {
+        // Absolute-gated mean → relative gate → mean above the relative gate
+        double energySum = 0.0;
+        std::uint64_t count = 0;
+
+        for (int bin = 0; bin < kHistogramBins; ++bin)
+        {
+            const auto n = histogram[static_cast<size_t>(bin)];
+            energySum += static_cast<double>(n) * binEnergy[static_cast<size_t>(bin)];
+            count += n;
+        }
+
+        if (count == 0)
+        {
+            integratedLufs = kSilenceLufs;
+            return;
+        }
+
+        const double relativeGate = energyToLufs(energySum / static_cast<double>(count)) + kRelativeGateLu;
+        const int firstBin = std::clamp(static_cast<int>((relativeGate - kAbsoluteGateLufs) / kHistogramStepLu), 0,
+                                        kHistogramBins - 1);
+
+        energySum = 0.0;
+        count = 0;
+        for (int bin = firstBin; bin < kHistogramBins; ++bin)
+        {
+            const auto n = histogram[static_cast<size_t>(bin)];
+            energySum += static_cast<double>(n) * binEnergy[static_cast<size_t>(bin)];
+            count += n;
+        }
+
+        integratedLufs = count > 0 ? energyToLufs(energySum / static_cast<double>(count)) : kSilenceLufs;
+    }
+
+    //==============================================================================
+    Coefficients shelf;
+    Coefficients highPass;
+    std::array<ChannelState, 2> channelState{};
+
+    int subBlockLength = 4800;
+    int samplesInSubBlock = 0;
+    double accumulator = 0.0;
+
+    std::array<double, kShortTermBlocks> subBlockEnergy{};
+    int subBlockWritePos = 0;
+    int subBlocksCollected = 0;
+
+    std::array<std::uint32_t, kHistogramBins> histogram{};
+    std::array<double, kHistogramBins> binEnergy{};
+
+    float momentaryLufs = kSilenceLufs;
+    float shortTermLufs = kSilenceLufs;
+    float integratedLufs = kSilenceLufs;
+};
+
+}  // namespace GrainDSP
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    PeakDecimator.h
+    Min/max decimation of a positioned sample stream into fixed-size peaks.
+    Used on the audio thread so display FIFOs carry summaries, not samples.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace GrainDSP
+{
+//==============================================================================
+/** Min/max of up to PeakDecimator::kSamplesPerPeak consecutive samples. */
+struct PeakSummary
+{
+    float minVal = 0.0f;
+    float maxVal = 0.0f;
+    std::int64_t startPosition = 0;  ///< Stream position of the first sample
+    int numSamples = 0;
+};
+
+//==============================================================================
+/**
+ * Reduces a stream of (samples, start position) blocks into PeakSummary
+ * records of kSamplesPerPeak samples each.
+ *
+ * Peaks are aligned to multiples of kSamplesPerPeak in stream position, so
+ * the same file region always yields the same buckets regardless of block
+ * size. A block that does not continue the previous one (seek, loop
+ * wrap-around) first emits the partial peak in progress.
+ *
+ * O(1) per sample, no allocation — real-time safe.
+ */
+struct PeakDecimator
+{
+    static constexpr int kSamplesPerPeak = 128;
+
+    /** Drop the partial peak in progress. */
+    void reset()
+    {
+        pending = {};
+        nextPosition = -1;
+    }
+
+    /**
+     * Accumulate one block.
+     * @param samples Sample data
+     * @param numSamples Number of samples
+     * @param startPosition Stream position of samples[0]
+     * @param emit Called with each completed PeakSummary
+     */
+    template <typename EmitFn>
+    void process(const float* samples, int numSamples, std::int64_t startPosition, EmitFn&& emit)
+    {
+        if (startPosition != nextPosition)
+        {
+            flush(emit);
+        }
+
+        std::int64_t position = startPosition;
+        int index = 0;
+
+        while (index < numSamples)
+        {
+            if (pending.numSamples == 0)
+            {
+                pending.startPosition = position;
+                pending.minVal = samples[index];
+                pending.maxVal = samples[index];
+            }
+
+            // Samples left until the next kSamplesPerPeak boundary
+            const auto toBoundary = static_cast<int>(kSamplesPerPeak - (position % kSamplesPerPeak));
+            const int count = std::min(toBoundary, numSamples - index);
+
+            for (int i = 0; i < count; ++i)
+            {
+                pending.minVal = std::min(pending.minVal, samples[index + i]);
+                pending.maxVal = std::max(pending.maxVal, samples[index + i]);
+            }
+
+            pending.numSamples += count;
+            index += count;
+            position += count;
+
+            if (position % kSamplesPerPeak == 0)
+            {
+                flush(emit);
+            }
+        }
+
+        nextPosition = position;
+    }
+
+    /**
+     * Emit the partial peak in progress, if any.
+     * @param emit Called with the PeakSummary
+     */
+    template <typename EmitFn>
+    void flush(EmitFn&& emit)
+    {
+        if (pending.numSamples > 0)
+        {
+            emit(pending);
+            pending = {};
+        }
+    }
+
+private:
+    PeakSummary pending;
+    std::int64_t nextPosition = -1;
+};
+
+}  // namespace GrainDSP
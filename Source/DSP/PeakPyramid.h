@@ -0,0 +1,246 @@
+/*
+  ==============================================================================
+
+    PeakPyramid.h
+    Multi-resolution (mip-mapped) min/max summary of a sample stream.
+    Level 0 holds one bucket per PeakDecimator peak; each level above halves
+    the bucket count, so any zoom can be drawn from a handful of buckets per
+    pixel.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "PeakDecimator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace GrainDSP
+{
+//==============================================================================
+/**
+ * Min/max pyramid over a stream of known length.
+ *
+ * Level L buckets cover kBaseSamples << L samples, aligned to multiples of
+ * that size. merge() folds a PeakSummary into every bucket it overlaps on
+ * every level (O(levels) per peak), so peaks may arrive in any order and any
+ * number of times — real-time wet accumulation and background renders both
+ * just merge.
+ *
+ * Progressive readers: when peaks are merged in stream order by one writer,
+ * buckets that end at or before the writer's published position are final
+ * and never written again. getRange() takes that position as a limit and
+ * ignores later buckets, so a reader on another thread may query while the
+ * writer appends.
+ *
+ * All memory is allocated in reset(); merge() and getRange() do not allocate.
+ */
+struct PeakPyramid
+{
+    static constexpr int kBaseSamples = PeakDecimator::kSamplesPerPeak;
+
+    /** Min/max of one bucket; empty until something is merged into it. */
+    struct Bucket
+    {
+        float minVal = std::numeric_limits<float>::max();
+        float maxVal = std::numeric_limits<float>::lowest();
+
+        bool isEmpty() const { return minVal > maxVal; }
+    };
+
+    /**
+     * Allocate every level for a stream of the given length and empty it.
+     * @param numSamples Stream length in samples (0 releases the memory)
+     */
+    void reset(std::int64_t numSamples)
+    {
+        totalSamples = std::max<std::int64_t>(numSamples, 0);
+        levels.clear();
+
+        auto numBuckets = static_cast<size_t>((totalSamples + kBaseSamples - 1) / kBaseSamples);
+
+        while (numBuckets > 0)
+        {
+            levels.emplace_back(numBuckets);
+
+            if (numBuckets == 1)
+            {
+                break;
+            }
+
+            numBuckets = (numBuckets + 1) / 2;
+        }
+    }
+
+    /** Empty every bucket, keeping the allocation. */
+    void clear()
+    {
+        for (auto& level : levels)
+        {
+            std::fill(level.begin(), level.end(), Bucket{});
+        }
+    }
+
+    /**
+     * Fold one peak into all buckets it overlaps. Peaks outside the stream are ignored.
+     * @param peak Min/max of a run of samples
+     */
+    void merge(const PeakSummary& peak)
+    {
+        if (levels.empty() || peak.numSamples <= 0 || peak.startPosition < 0 || peak.startPosition >= totalSamples)
+        {
+            return;
+        }
+
+        const std::int64_t last = std::min<std::int64_t>(peak.startPosition + peak.numSamples, totalSamples) - 1;
+
+        for (size_t level = 0; level < levels.size(); ++level)
+        {
+            const auto shift = static_cast<int>(level);
+            const auto first = static_cast<size_t>((peak.startPosition / kBaseSamples) >> shift);
+            const auto end = static_cast<size_t>((last / kBaseSamples) >> shift);
+
+            for (size_t i = first; i <= end; ++i)
+            {
+                auto& bucket = levels[level][i];
+                bucket.minVal = std::min(bucket.minVal, peak.minVal);
+                bucket.maxVal = std::max(bucket.maxVal, peak.maxVal);
+            }
+        }
+    }
+
+    /**
+     * Replace level 0 (e.g. from a disk cache) and rebuild every level above it.
+     * @param buckets Level 0 buckets as returned by getBaseLevel()
+     * @param numBuckets Must match the size allocated by reset()
+     * @return false (pyramid unchanged) if the count does not match
+     */
+    bool setBaseLevel(const Bucket* buckets, size_t numBuckets)
+    {
+        if (levels.empty() || numBuckets != levels.front().size())
+        {
+            return false;
+        }
+
+        std::copy(buckets, buckets + numBuckets, levels.front().begin());
+
+        for (size_t level = 1; level < levels.size(); ++level)
+        {
+            const auto& below = levels[level - 1];
+
+            for (size_t i = 0; i < levels[level].size(); ++i)
+            {
+                auto& bucket = levels[level][i];
+                bucket = below[2 * i];
+
+                if (2 * i + 1 < below.size())
+                {
+                    bucket.minVal = std::min(bucket.minVal, below[2 * i + 1].minVal);
+                    bucket.maxVal = std::max(bucket.maxVal, below[2 * i + 1].maxVal);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    //==============================================================================
+    /** @return Level 0 buckets (empty before reset()). */
+    const std::vector<Bucket>& getBaseLevel() const
+    {
+        static const std::vector<Bucket> none;
+        return levels.empty() ? none : levels.front();
+    }
+
+    /** @return Stream length passed to reset(). */
+    std::int64_t getTotalSamples() const { return totalSamples; }
+
+    /** @return Number of levels (0 when empty). */
+    int getNumLevels() const { return static_cast<int>(levels.size()); }
+
+    /** @return Samples covered by one bucket of the given level. */
+    static std::int64_t getBucketSamples(int level) { return static_cast<std::int64_t>(kBaseSamples) << level; }
+
+    /**
+     * Coarsest level whose buckets are no longer than the given span, so a
+     * span is covered by at most a few buckets.
+     * @param samplesPerSpan Samples per pixel (or per query)
+     * @return Level index (0 when even the base is coarser than the span)
+     */
+    int getLevelForSpan(double samplesPerSpan) const
+    {
+        int level = 0;
+
+        while (level + 1 < getNumLevels() && static_cast<double>(getBucketSamples(level + 1)) <= samplesPerSpan)
+        {
+            ++level;
+        }
+
+        return level;
+    }
+
+    /**
+     * Min/max of the non-empty buckets of one level overlapping [start, end).
+     * @param level Level to read (see getLevelForSpan())
+     * @param start First sample of the range
+     * @param end One past the last sample of the range
+     * @param limit Only buckets ending at or before this position are read
+     *              (the stream length counts as the end of the last bucket)
+     * @param result Receives the min/max when something was found
+     * @return false if no non-empty bucket overlaps the range
+     */
+    bool getRange(int level, std::int64_t start, std::int64_t end, std::int64_t limit, Bucket& result) const
+    {
+        if (level < 0 || level >= getNumLevels())
+        {
+            return false;
+        }
+
+        start = std::max<std::int64_t>(start, 0);
+        end = std::min(end, totalSamples);
+
+        if (start >= end)
+        {
+            return false;
+        }
+
+        const auto& buckets = levels[static_cast<size_t>(level)];
+        const std::int64_t bucketSamples = getBucketSamples(level);
+        const auto first = static_cast<size_t>(start / bucketSamples);
+        const auto last = static_cast<size_t>((end - 1) / bucketSamples);
+
+        Bucket merged;
+
+        for (size_t i = first; i <= last; ++i)
+        {
+            const std::int64_t bucketEnd =
+                std::min(static_cast<std::int64_t>(i + 1) * bucketSamples, totalSamples);
+
+            if (bucketEnd > limit)
+            {
+                break;
+            }
+
+            merged.minVal = std::min(merged.minVal, buckets[i].minVal);
+            merged.maxVal = std::max(merged.maxVal, buckets[i].maxVal);
+        }
+
+        if (merged.isEmpty())
+        {
+            return false;
+        }
+
+        result = merged;
+        return true;
+    }
+
+private:
+    std::vector<std::vector<Bucket>> levels;
+    std::int64_t totalSamples = 0;
+};
+
+}  // namespace GrainDSP
@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    PreparedCalibration.h
+    A calibration together with every coefficient derived from it,
+    built off the audio thread and handed to it through CalibrationExchange.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CalibrationConfig.h"
+#include "DCBlocker.h"
+#include "DSPHelpers.h"
+#include "SpectralFocus.h"
+
+#include <array>
+#include <cstddef>
+
+namespace GrainDSP
+{
+//==============================================================================
+/**
+ * Immutable, preprocessed calibration for one sample rate.
+ *
+ * create() does all the exp/pow/trig work (RMS ballistics, DC blocker, the
+ * shelf pair of every focus mode); adopting a prepared calibration on the
+ * audio thread is then plain copies, so neither a new profile nor a focus
+ * change costs any math there. Never modified after create().
+ */
+struct PreparedCalibration
+{
+    static constexpr std::size_t kNumFocusModes = 3;
+
+    CalibrationConfig config;  ///< Source values (bias and warmth are used directly per sample)
+    float sampleRate = 0.0f;   ///< Rate the coefficients were derived for (the oversampled rate)
+
+    float rmsAttackCoeff = 0.0f;   ///< RMSDetector::attackCoeff
+    float rmsReleaseCoeff = 0.0f;  ///< RMSDetector::releaseCoeff
+    float dcBlockerCoeff = 0.0f;   ///< DCBlocker::coeff
+    std::array<SpectralFocus::ShelfPair, kNumFocusModes> focus{};  ///< Indexed by FocusMode
+
+    /**
+     * Derive every coefficient of a calibration at a sample rate.
+     * @param cal Calibration values
+     * @param rate Sample rate in Hz the DSP modules run at
+     * @return Prepared calibration, ready to publish
+     */
+    static PreparedCalibration create(const CalibrationConfig& cal, float rate)
+    {
+        PreparedCalibration prepared;
+        prepared.config = cal;
+        prepared.sampleRate = rate;
+        prepared.rmsAttackCoeff = calculateCoefficient(rate, cal.rms.attackMs);
+        prepared.rmsReleaseCoeff = calculateCoefficient(rate, cal.rms.releaseMs);
+        prepared.dcBlockerCoeff = DCBlocker::calculateCoeff(rate, cal.dcBlocker);
+
+        for (std::size_t mode = 0; mode < kNumFocusModes; ++mode)
+        {
+            prepared.focus[mode] = SpectralFocus::calculateCoefficients(rate, static_cast<FocusMode>(mode), cal.focus);
+        }
+
+        return prepared;
+    }
+
+    /** @return Shelf pair for a focus mode */
+    const SpectralFocus::ShelfPair& getFocus(FocusMode mode) const { return focus[static_cast<std::size_t>(mode)]; }
+};
+
+}  // namespace GrainDSP
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    ProcessorState.h
+    Complete GRAIN processing state as one plain-data blob.
+    Captured and restored by the processor so renders can resume from a
+    checkpoint, hand state across chunk boundaries or warm-start.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "GrainDSPPipeline.h"
+#include "LinearSmoother.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace GrainDSP
+{
+//==============================================================================
+/**
+ * Snapshot of everything that makes one processing pass differ from another
+ * with the same parameters: per-channel pipeline filter memory, the RMS
+ * envelope, every parameter smoother mid-ramp, the auto-gain trim, and the
+ * last kHistorySamples of oversampler input and wet output.
+ *
+ * The oversampler's own filter memory is not reachable, so it is carried as
+ * history instead: the processor replays it through a reset oversampler on
+ * restore, which leaves the (decaying, IIR) filters converged to the
+ * captured state.
+ *
+ * Trivially copyable and self-describing (magic, version, size), so it can
+ * be memcpy'd to disk or across threads; fromBytes() validates the header.
+ * Meters (loudness, true peak) are not processing state and are excluded.
+ */
+struct ProcessorState
+{
+    static constexpr std::uint32_t kMagic = 0x54535247;  // "GRST"
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr int kMaxChannels = 2;
+    static constexpr int kHistorySamples = 512;  // Base-rate samples of oversampler history
+    static constexpr int kMaxOversamplingFactor = 4;
+
+    std::uint32_t magic = kMagic;
+    std::uint32_t version = kVersion;
+    std::uint32_t size = sizeof(ProcessorState);
+
+    // Configuration the state is only valid for
+    double sampleRate = 0.0;
+    std::int32_t oversamplingFactor = 0;
+    std::int32_t numChannels = 0;
+
+    // DSP modules
+    std::array<PipelineState, kMaxChannels> pipelines{};
+    float rmsEnvelope = 0.0f;
+    float currentEnvelope = 0.0f;
+
+    // Parameter smoothers and auto-gain
+    LinearSmoother drive;
+    LinearSmoother warmth;
+    LinearSmoother mix;
+    LinearSmoother gain;
+    LinearSmoother inputGain;
+    float autoGainTrimDb = 0.0f;
+
+    // Oversampler history, oldest sample first: input at base rate, wet output at the oversampled rate
+    std::array<std::array<float, kHistorySamples>, kMaxChannels> inputHistory{};
+    std::array<std::array<float, kHistorySamples * kMaxOversamplingFactor>, kMaxChannels> wetHistory{};
+
+    /** @return true if the header matches this build's layout. */
+    bool isValid() const { return magic == kMagic && version == kVersion && size == sizeof(ProcessorState); }
+
+    /**
+     * Copy a blob back into a state.
+     * @param data Bytes previously copied out of a ProcessorState
+     * @param numBytes Must be sizeof(ProcessorState)
+     * @param result Receives the state (untouched on failure)
+     * @return false if the size or header does not match
+     */
+    static bool fromBytes(const void* data, std::size_t numBytes, ProcessorState& result)
+    {
+        if (data == nullptr || numBytes != sizeof(ProcessorState))
+        {
+            return false;
+        }
+
+        ProcessorState candidate;
+        std::memcpy(&candidate, data, sizeof(ProcessorState));
+
+        if (!candidate.isValid())
+        {
+            return false;
+        }
+
+        result = candidate;
+        return true;
+    }
+};
+
+static_assert(std::is_trivially_copyable<ProcessorState>::value, "ProcessorState must stay a POD blob");
+
+}  // namespace GrainDSP
@@ -74,6 +74,19 @@ struct SpectralFocus
         }
     };
 
+    /** Normalized biquad coefficients (a0 already divided out). */
+    struct Coefficients
+    {
+        float b0, b1, b2, a1, a2;
+    };
+
+    /** Coefficients of the low/high shelf pair for one focus mode. */
+    struct ShelfPair
+    {
+        Coefficients lowShelf;
+        Coefficients highShelf;
+    };
+
     // One filter pair per mono instance: low shelf + high shelf
     BiquadState lowShelf;
     BiquadState highShelf;
@@ -87,6 +100,18 @@ struct SpectralFocus
      * @param cal Focus calibration parameters
      */
     void prepare(float sampleRate, FocusMode mode, const FocusCalibration& cal)
+    {
+        setCoefficients(calculateCoefficients(sampleRate, mode, cal));
+    }
+
+    /**
+     * Calculate the shelf pair for a focus mode (pow/trig — keep off the audio thread where possible).
+     * @param sampleRate Sample rate in Hz
+     * @param mode Focus mode (Low, Mid, High)
+     * @param cal Focus calibration parameters
+     * @return Coefficients for setCoefficients()
+     */
+    static ShelfPair calculateCoefficients(float sampleRate, FocusMode mode, const FocusCalibration& cal)
     {
         float lowGainDb = 0.0f;
         float highGainDb = 0.0f;
@@ -109,20 +134,27 @@ struct SpectralFocus
                 break;
         }
 
-        const auto lowCoeffs = calculateLowShelf(sampleRate, cal.lowShelfFreq, cal.shelfQ, lowGainDb);
-        const auto highCoeffs = calculateHighShelf(sampleRate, cal.highShelfFreq, cal.shelfQ, highGainDb);
-
-        lowShelf.b0 = lowCoeffs.b0;
-        lowShelf.b1 = lowCoeffs.b1;
-        lowShelf.b2 = lowCoeffs.b2;
-        lowShelf.a1 = lowCoeffs.a1;
-        lowShelf.a2 = lowCoeffs.a2;
+        return {calculateLowShelf(sampleRate, cal.lowShelfFreq, cal.shelfQ, lowGainDb),
+                calculateHighShelf(sampleRate, cal.highShelfFreq, cal.shelfQ, highGainDb)};
+    }
 
-        highShelf.b0 = highCoeffs.b0;
-        highShelf.b1 = highCoeffs.b1;
-        highShelf.b2 = highCoeffs.b2;
-        highShelf.a1 = highCoeffs.a1;
-        highShelf.a2 = highCoeffs.a2;
+    /**
+     * Install precalculated coefficients. Plain copies; does NOT reset filter state.
+     * @param coeffs Shelf pair from calculateCoefficients()
+     */
+    void setCoefficients(const ShelfPair& coeffs)
+    {
+        lowShelf.b0 = coeffs.lowShelf.b0;
+        lowShelf.b1 = coeffs.lowShelf.b1;
+        lowShelf.b2 = coeffs.lowShelf.b2;
+        lowShelf.a1 = coeffs.lowShelf.a1;
+        lowShelf.a2 = coeffs.lowShelf.a2;
+
+        highShelf.b0 = coeffs.highShelf.b0;
+        highShelf.b1 = coeffs.highShelf.b1;
+        highShelf.b2 = coeffs.highShelf.b2;
+        highShelf.a1 = coeffs.highShelf.a1;
+        highShelf.a2 = coeffs.highShelf.a2;
     }
 
     /**
@@ -147,12 +179,6 @@ struct SpectralFocus
     }
 
 private:
-    /** Normalized biquad coefficients (a0 already divided out). */
-    struct Coefficients
-    {
-        float b0, b1, b2, a1, a2;
-    };
-
     /** Calculate low shelf biquad coefficients.
      *  Reference: Audio EQ Cookbook (Robert Bristow-Johnson).
      *  @param sampleRate Sample rate in Hz
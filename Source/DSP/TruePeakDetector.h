@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    TruePeakDetector.h
+    ITU-R BS.1770-4 (Annex 2) style true-peak estimator.
+    4× polyphase FIR interpolation of the output signal, peak of all phases.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace GrainDSP
+{
+//==============================================================================
+/**
+ * True-peak (inter-sample) detector, mono.
+ * Interpolates the signal 4× with the BS.1770-4 48-tap polyphase FIR
+ * (4 phases × 12 taps) and returns the maximum absolute interpolated value.
+ *
+ * Works block-wise on a linear history buffer (no modulo indexing), and the
+ * coefficient table is stored tap-major so that each tap updates all four
+ * phases at once — the inner loop maps directly onto one 4-lane SIMD register.
+ *
+ * Allocation happens only in prepare(); processBlock() is real-time safe.
+ */
+struct TruePeakDetector
+{
+    static constexpr int kOversampling = 4;
+    static constexpr int kTapsPerPhase = 12;
+    static constexpr int kHistory = kTapsPerPhase - 1;
+
+    /**
+     * Prepare the history buffer for a maximum block size.
+     * @param maxBlockSize Largest block passed to processBlock() in one call
+     */
+    void prepare(int maxBlockSize)
+    {
+        blockCapacity = maxBlockSize > 0 ? maxBlockSize : 1;
+        history.assign(static_cast<size_t>(kHistory + blockCapacity), 0.0f);
+    }
+
+    /**
+     * Reset the interpolator state (clears history).
+     */
+    void reset() { std::fill(history.begin(), history.end(), 0.0f); }
+
+    /**
+     * Process a block and return its true peak.
+     * @param input Input samples (base rate)
+     * @param numSamples Number of samples (blocks larger than the prepared size are split)
+     * @return Maximum absolute value of the 4× interpolated signal (linear)
+     */
+    float processBlock(const float* input, int numSamples)
+    {
+        float peak = 0.0f;
+
+        while (numSamples > 0 && !history.empty())
+        {
+            const int chunk = numSamples < blockCapacity ? numSamples : blockCapacity;
+            peak = std::max(peak, processChunk(input, chunk));
+            input += chunk;
+            numSamples -= chunk;
+        }
+
+        return peak;
+    }
+
+    /**
+     * Convert a linear true-peak value to dBTP.
+     * @param linear Linear peak value
+     * @return Level in dBTP (clamped to -120 dB for silence)
+     */
+    static float toDecibels(float linear) { return linear > 1.0e-6f ? 20.0f * std::log10(linear) : -120.0f; }
+
+private:
+    /** Polyphase coefficients, tap-major: kCoefficients[tap][phase].
+     *  Taps are stored oldest-sample-first so the window can be read forwards.
+     *  Source: ITU-R BS.1770-4 Annex 2, 48-tap interpolation filter. */
+    static constexpr float kCoefficients[kTapsPerPhase][kOversampling] = {
+        {-0.0083007812500f, -0.0189208984375f, -0.0291748046875f, 0.0017089843750f},
+        {0.0148925781250f, 0.0330810546875f, 0.0292968750000f, 0.0109863281250f},
+        {-0.0266113281250f, -0.0582275390625f, -0.0517578125000f, -0.0196533203125f},
+        {0.0476074218750f, 0.1015625000000f, 0.0891113281250f, 0.0332031250000f},
+        {-0.1022949218750f, -0.2003173828125f, -0.1665039062500f, -0.0594482421875f},
+        {0.9721679687500f, 0.7797851562500f, 0.4650878906250f, 0.1373291015625f},
+        {0.1373291015625f, 0.4650878906250f, 0.7797851562500f, 0.9721679687500f},
+        {-0.0594482421875f, -0.1665039062500f, -0.2003173828125f, -0.1022949218750f},
+        {0.0332031250000f, 0.0891113281250f, 0.1015625000000f, 0.0476074218750f},
+        {-0.0196533203125f, -0.0517578125000f, -0.0582275390625f, -0.0266113281250f},
+        {0.0109863281250f, 0.0292968750000f, 0.0330810546875f, 0.0148925781250f},
+        {0.0017089843750f, -0.0291748046875f, -0.0189208984375f, -0.0083007812500f}};
+
+    float processChunk(const float* input, int numSamples)
+    {
+        std::copy(input, input + numSamples, history.begin() + kHistory);
+
+        float peak = 0.0f;
+        const float* window = history.data();
+
+        for (int n = 0; n < numSamples; ++n, ++window)
+        {
+            float acc[kOversampling] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+            for (int tap = 0; tap < kTapsPerPhase; ++tap)
+            {
+                const float x = window[tap];
+
+                for (int phase = 0; phase < kOversampling; ++phase)
+                {
+                    acc[phase] += kCoefficients[tap][phase] * x;
+                }
+            }
+
+            for (const float value : acc)
+            {
+                peak = std::max(peak, std::abs(value));
+            }
+        }
+
+        // Keep the last kHistory samples as the start of the next window
+        std::copy(history.begin() + numSamples, history.begin() + numSamples + kHistory, history.begin());
+
+        return peak;
+    }
+
+    std::vector<float> history;
+    int blockCapacity = 0;
+};
+
+}  // namespace GrainDSP
@@ -0,0 +1,224 @@
+/*
+  ==============================================================================
+
+    HeadlessMain.cpp
+    Entry point for the GRAINHeadless console application.
+    Streams raw PCM from stdin through the GRAIN processor to stdout, e.g.
+
+        sox in.wav -t raw -e float -b 32 - | GRAINHeadless --drive=0.6 > out.raw
+
+  ==============================================================================
+*/
+
+#include "../PluginProcessor.h"
+#include "PcmStreamer.h"
+
+#include <JuceHeader.h>
+
+#include <cstdio>
+#include <iostream>
+
+#if JUCE_WINDOWS
+    #include <fcntl.h>
+    #include <io.h>
+#else
+    #include <csignal>
+#endif
+
+// Defined in PluginProcessor.cpp
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter();
+
+namespace
+{
+//==============================================================================
+/** Blocking reads from the process's stdin. */
+class StdinInputStream : public juce::InputStream
+{
+public:
+    juce::int64 getTotalLength() override { return -1; }
+    bool isExhausted() override { return std::feof(stdin) != 0; }
+    juce::int64 getPosition() override { return position; }
+    bool setPosition(juce::int64) override { return false; }
+
+    int read(void* destBuffer, int maxBytesToRead) override
+    {
+        const auto bytesRead = std::fread(destBuffer, 1, static_cast<size_t>(maxBytesToRead), stdin);
+        position += static_cast<juce::int64>(bytesRead);
+        return static_cast<int>(bytesRead);
+    }
+
+private:
+    juce::int64 position = 0;
+};
+
+/** Blocking writes to the process's stdout. */
+class StdoutOutputStream : public juce::OutputStream
+{
+public:
+    ~StdoutOutputStream() override { flush(); }
+
+    void flush() override { std::fflush(stdout); }
+    juce::int64 getPosition() override { return position; }
+    bool setPosition(juce::int64) override { return false; }
+
+    bool write(const void* dataToWrite, size_t numberOfBytes) override
+    {
+        const auto bytesWritten = std::fwrite(dataToWrite, 1, numberOfBytes, stdout);
+        position += static_cast<juce::int64>(bytesWritten);
+        return bytesWritten == numberOfBytes;
+    }
+
+private:
+    juce::int64 position = 0;
+};
+
+//==============================================================================
+void printUsage()
+{
+    std::cerr << "Usage: GRAINHeadless [options] < input.raw > output.raw\n"
+                 "\n"
+                 "Streams interleaved little-endian PCM from stdin through GRAIN to stdout.\n"
+                 "\n"
+                 "  --format=f32|s24     Sample format in and out (default f32)\n"
+                 "  --channels=1|2       Interleaved channels (default 2)\n"
+                 "  --rate=<Hz>          Sample rate (default 48000)\n"
+                 "  --block=<frames>     Frames per block (default 512)\n"
+                 "  --no-latency-trim    Keep the processor latency at the start of the output\n"
+                 "  --state=<file>       Load a saved plugin state before the parameter flags\n"
+                 "  --calibration=<file> Load a calibration profile (JSON or binary)\n"
+                 "  --<parameter>=<v>    Set a parameter by ID, as shown in the UI:\n"
+                 "                       drive, warmth, mix, output, inputGain, focus, autoGain, bypass\n";
+}
+
+/** Parse a positive integer option. @return false if present but invalid */
+bool parseIntOption(const juce::ArgumentList& args, const juce::String& option, int minValue, int maxValue,
+                    int& value)
+{
+    if (!args.containsOption(option))
+    {
+        return true;
+    }
+
+    const auto text = args.getValueForOption(option);
+    value = text.getIntValue();
+
+    if (!text.containsOnly("0123456789") || value < minValue || value > maxValue)
+    {
+        std::cerr << "Invalid " << option << ": " << text << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+/** Apply --<parameterID>=<value> flags; values are parsed like text typed into the parameter. */
+bool applyParameterArguments(juce::AudioProcessor& processor, const juce::ArgumentList& args)
+{
+    for (auto* parameter : processor.getParameters())
+    {
+        auto* withId = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter);
+
+        if (withId == nullptr || !args.containsOption("--" + withId->paramID))
+        {
+            continue;
+        }
+
+        const auto text = args.getValueForOption("--" + withId->paramID);
+
+        if (text.isEmpty())
+        {
+            std::cerr << "Missing value for --" << withId->paramID << "\n";
+            return false;
+        }
+
+        withId->setValueNotifyingHost(withId->getValueForText(text));
+    }
+
+    return true;
+}
+}  // namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI const init;
+    const juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    PcmStreamer::Options options;
+
+    if (args.containsOption("--format")
+        && !PcmStreamer::parseSampleFormat(args.getValueForOption("--format"), options.format))
+    {
+        std::cerr << "Unknown --format: " << args.getValueForOption("--format") << "\n";
+        return 2;
+    }
+
+    int sampleRate = 48000;
+
+    if (!parseIntOption(args, "--channels", 1, 2, options.numChannels)
+        || !parseIntOption(args, "--rate", 8000, 768000, sampleRate)
+        || !parseIntOption(args, "--block", 16, 65536, options.blockSize))
+    {
+        return 2;
+    }
+
+    options.sampleRate = sampleRate;
+    options.compensateLatency = !args.containsOption("--no-latency-trim");
+
+    std::unique_ptr<juce::AudioProcessor> processor(createPluginFilter());
+
+    if (args.containsOption("--state"))
+    {
+        juce::MemoryBlock state;
+        const auto stateFile = args.getFileForOption("--state");
+
+        if (!stateFile.loadFileAsData(state))
+        {
+            std::cerr << "Cannot read --state file: " << stateFile.getFullPathName() << "\n";
+            return 2;
+        }
+
+        processor->setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+    }
+
+    if (args.containsOption("--calibration"))
+    {
+        auto* grain = dynamic_cast<GRAINAudioProcessor*>(processor.get());
+        juce::String error;
+
+        if (grain == nullptr || !grain->loadCalibrationProfile(args.getFileForOption("--calibration"), error))
+        {
+            std::cerr << "Cannot load --calibration: " << error << "\n";
+            return 2;
+        }
+    }
+
+    if (!applyParameterArguments(*processor, args))
+    {
+        return 2;
+    }
+
+#if JUCE_WINDOWS
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#else
+    // A closed downstream pipe must fail the write, not kill the process
+    std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+    StdinInputStream input;
+    StdoutOutputStream output;
+    PcmStreamer streamer(*processor, options);
+    const bool succeeded = streamer.run(input, output);
+
+    std::cerr << "GRAINHeadless: " << streamer.getFramesRead() << " frames in, " << streamer.getFramesWritten()
+              << " frames out" << (succeeded ? "" : " (output closed early)") << "\n";
+
+    return succeeded ? 0 : 1;
+}
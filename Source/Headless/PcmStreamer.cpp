@@ -0,0 +1,374 @@
+/*
+  ==============================================================================
+
+    PcmStreamer.cpp
+    GRAIN — Raw PCM streaming implementation.
+
+  ==============================================================================
+*/
+
+#include "PcmStreamer.h"
+
+namespace
+{
+using PlanarFloat = juce::AudioData::Pointer<juce::AudioData::Float32, juce::AudioData::NativeEndian,
+                                             juce::AudioData::NonInterleaved, juce::AudioData::NonConst>;
+using ConstPlanarFloat = juce::AudioData::Pointer<juce::AudioData::Float32, juce::AudioData::NativeEndian,
+                                                  juce::AudioData::NonInterleaved, juce::AudioData::Const>;
+
+/** Interleaved little-endian samples of one channel into a planar float channel. */
+template <typename SampleType>
+void deinterleaveChannel(const char* frames, int numChannels, int channel, float* dest, int numFrames)
+{
+    using Source = juce::AudioData::Pointer<SampleType, juce::AudioData::LittleEndian, juce::AudioData::Interleaved,
+                                            juce::AudioData::Const>;
+    PlanarFloat(dest).convertSamples(Source(frames + (channel * SampleType::bytesPerSample), numChannels),
+                                     numFrames);
+}
+
+/** A planar float channel into interleaved little-endian samples (int24 clips at full scale). */
+template <typename SampleType>
+void interleaveChannel(const float* source, char* frames, int numChannels, int channel, int numFrames)
+{
+    using Dest = juce::AudioData::Pointer<SampleType, juce::AudioData::LittleEndian, juce::AudioData::Interleaved,
+                                          juce::AudioData::NonConst>;
+    Dest(frames + (channel * SampleType::bytesPerSample), numChannels)
+        .convertSamples(ConstPlanarFloat(source), numFrames);
+}
+}  // namespace
+
+//==============================================================================
+bool PcmStreamer::parseSampleFormat(const juce::String& name, SampleFormat& format)
+{
+    if (name == "f32")
+    {
+        format = SampleFormat::float32;
+        return true;
+    }
+
+    if (name == "s24")
+    {
+        format = SampleFormat::int24;
+        return true;
+    }
+
+    return false;
+}
+
+int PcmStreamer::getFrameBytes(const Options& options)
+{
+    const int bytesPerSample = options.format == SampleFormat::int24 ? 3 : 4;
+    return bytesPerSample * options.numChannels;
+}
+
+PcmStreamer::PcmStreamer(juce::AudioProcessor& processorToUse, const Options& optionsToUse)
+    : processor(processorToUse)
+    , options(optionsToUse)
+    , frameBytes(getFrameBytes(optionsToUse))
+{
+    const auto blockBytes = static_cast<size_t>(options.blockSize * frameBytes);
+
+    for (auto* queue : {&inputQueue, &outputQueue})
+    {
+        for (auto& block : queue->blocks)
+        {
+            block.data.allocate(blockBytes, true);
+        }
+    }
+}
+
+//==============================================================================
+bool PcmStreamer::run(juce::InputStream& input, juce::OutputStream& output)
+{
+    cancelled.store(false, std::memory_order_relaxed);
+    framesRead.store(0, std::memory_order_relaxed);
+    framesWritten.store(0, std::memory_order_relaxed);
+    inputQueue.fifo.reset();
+    outputQueue.fifo.reset();
+
+    const int processorChannels = std::max(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+    buffer.setSize(std::max(options.numChannels, processorChannels), options.blockSize);
+
+    // Export quality, like the offline renderer: a pipe has no realtime deadline
+    processor.setNonRealtime(true);
+    processor.prepareToPlay(options.sampleRate, options.blockSize);
+
+    const int latency = options.compensateLatency ? processor.getLatencySamples() : 0;
+    latencyFramesToSkip = latency;
+
+    IoThread reader("GRAIN PCM Reader", [this, &input] { readLoop(input); });
+    IoThread writer("GRAIN PCM Writer", [this, &output] { writeLoop(output); });
+    reader.startThread();
+    writer.startThread();
+
+    bool endOfInput = false;
+
+    while (!endOfInput)
+    {
+        auto* block = inputQueue.waitForData(cancelled);
+
+        if (block == nullptr)
+        {
+            break;
+        }
+
+        const int numFrames = block->numFrames;
+        endOfInput = block->endOfStream;
+        decode(*block);
+        inputQueue.pop();
+
+        if (numFrames > 0 && !processAndQueue(numFrames))
+        {
+            break;
+        }
+    }
+
+    // Push the processor's latency out with silence so the tail is complete
+    for (int remaining = endOfInput ? latency : 0; remaining > 0;)
+    {
+        const int numFrames = std::min(options.blockSize, remaining);
+        buffer.clear();
+
+        if (!processAndQueue(numFrames))
+        {
+            break;
+        }
+
+        remaining -= numFrames;
+    }
+
+    if (endOfInput)
+    {
+        if (auto* last = outputQueue.waitForSpace(cancelled))
+        {
+            last->numFrames = 0;
+            last->endOfStream = true;
+            outputQueue.push();
+        }
+    }
+
+    // The writer finishes on the end-of-stream block or the cancel; a reader blocked
+    // inside a pipe read (only possible after a cancel) is stopped by force
+    writer.waitForThreadToExit(-1);
+    reader.stopThread(1000);
+    processor.releaseResources();
+
+    return endOfInput && !cancelled.load(std::memory_order_relaxed);
+}
+
+void PcmStreamer::stop()
+{
+    cancel();
+}
+
+void PcmStreamer::cancel()
+{
+    cancelled.store(true, std::memory_order_relaxed);
+
+    for (auto* queue : {&inputQueue, &outputQueue})
+    {
+        queue->dataReady.signal();
+        queue->spaceFree.signal();
+    }
+}
+
+//==============================================================================
+void PcmStreamer::readLoop(juce::InputStream& input)
+{
+    const int blockBytes = options.blockSize * frameBytes;
+
+    for (;;)
+    {
+        auto* block = inputQueue.waitForSpace(cancelled);
+
+        if (block == nullptr)
+        {
+            return;
+        }
+
+        // Pipes deliver short reads; only a zero read is the end of the input
+        int filled = 0;
+
+        while (filled < blockBytes)
+        {
+            const int bytesRead = input.read(block->data + filled, blockBytes - filled);
+
+            if (bytesRead <= 0)
+            {
+                break;
+            }
+
+            filled += bytesRead;
+        }
+
+        block->numFrames = filled / frameBytes;
+        block->endOfStream = filled < blockBytes;
+        const bool endOfStream = block->endOfStream;
+
+        framesRead.fetch_add(block->numFrames, std::memory_order_relaxed);
+        inputQueue.push();
+
+        if (endOfStream)
+        {
+            return;
+        }
+    }
+}
+
+void PcmStreamer::writeLoop(juce::OutputStream& output)
+{
+    for (;;)
+    {
+        auto* block = outputQueue.waitForData(cancelled);
+
+        if (block == nullptr)
+        {
+            return;
+        }
+
+        const int numFrames = block->numFrames;
+        const bool endOfStream = block->endOfStream;
+
+        if (numFrames > 0 && !output.write(block->data, static_cast<size_t>(numFrames * frameBytes)))
+        {
+            // Downstream closed the pipe: nothing more can be delivered
+            cancel();
+            return;
+        }
+
+        // Flush per block, or the stream's own buffering would add latency
+        output.flush();
+        framesWritten.fetch_add(numFrames, std::memory_order_relaxed);
+        outputQueue.pop();
+
+        if (endOfStream)
+        {
+            return;
+        }
+    }
+}
+
+//==============================================================================
+bool PcmStreamer::processAndQueue(int numFrames)
+{
+    juce::AudioBuffer<float> view(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), numFrames);
+    processor.processBlock(view, midi);
+
+    const int skip = std::min(latencyFramesToSkip, numFrames);
+    latencyFramesToSkip -= skip;
+
+    if (skip == numFrames)
+    {
+        return true;
+    }
+
+    auto* out = outputQueue.waitForSpace(cancelled);
+
+    if (out == nullptr)
+    {
+        return false;
+    }
+
+    encode(*out, skip, numFrames - skip);
+    out->numFrames = numFrames - skip;
+    out->endOfStream = false;
+    outputQueue.push();
+    return true;
+}
+
+void PcmStreamer::decode(const Block& block)
+{
+    const char* frames = block.data.getData();
+
+    for (int ch = 0; ch < options.numChannels; ++ch)
+    {
+        float* dest = buffer.getWritePointer(ch);
+
+        if (options.format == SampleFormat::int24)
+        {
+            deinterleaveChannel<juce::AudioData::Int24>(frames, options.numChannels, ch, dest, block.numFrames);
+        }
+        else
+        {
+            deinterleaveChannel<juce::AudioData::Float32>(frames, options.numChannels, ch, dest, block.numFrames);
+        }
+    }
+
+    // Mono stream into a stereo processor: feed the same signal to both sides
+    for (int ch = options.numChannels; ch < buffer.getNumChannels(); ++ch)
+    {
+        buffer.copyFrom(ch, 0, buffer, 0, 0, block.numFrames);
+    }
+}
+
+void PcmStreamer::encode(Block& block, int startFrame, int numFrames) const
+{
+    char* frames = block.data.getData();
+
+    for (int ch = 0; ch < options.numChannels; ++ch)
+    {
+        const float* source = buffer.getReadPointer(ch, startFrame);
+
+        if (options.format == SampleFormat::int24)
+        {
+            interleaveChannel<juce::AudioData::Int24>(source, frames, options.numChannels, ch, numFrames);
+        }
+        else
+        {
+            interleaveChannel<juce::AudioData::Float32>(source, frames, options.numChannels, ch, numFrames);
+        }
+    }
+}
+
+//==============================================================================
+PcmStreamer::Block* PcmStreamer::BlockQueue::waitForSpace(const std::atomic<bool>& cancelled)
+{
+    while (fifo.getFreeSpace() == 0 && !cancelled.load(std::memory_order_relaxed))
+    {
+        spaceFree.wait(-1);
+    }
+
+    if (cancelled.load(std::memory_order_relaxed))
+    {
+        return nullptr;
+    }
+
+    int start1 = 0;
+    int size1 = 0;
+    int start2 = 0;
+    int size2 = 0;
+    fifo.prepareToWrite(1, start1, size1, start2, size2);
+    return &blocks[static_cast<size_t>(size1 > 0 ? start1 : start2)];
+}
+
+void PcmStreamer::BlockQueue::push()
+{
+    fifo.finishedWrite(1);
+    dataReady.signal();
+}
+
+PcmStreamer::Block* PcmStreamer::BlockQueue::waitForData(const std::atomic<bool>& cancelled)
+{
+    while (fifo.getNumReady() == 0 && !cancelled.load(std::memory_order_relaxed))
+    {
+        dataReady.wait(-1);
+    }
+
+    if (cancelled.load(std::memory_order_relaxed))
+    {
+        return nullptr;
+    }
+
+    int start1 = 0;
+    int size1 = 0;
+    int start2 = 0;
+    int size2 = 0;
+    fifo.prepareToRead(1, start1, size1, start2, size2);
+    return &blocks[static_cast<size_t>(size1 > 0 ? start1 : start2)];
+}
+
+void PcmStreamer::BlockQueue::pop()
+{
+    fifo.finishedRead(1);
+    spaceFree.signal();
+}
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+    PcmStreamer.h
+    GRAIN — Raw interleaved PCM streaming through a processor, for chaining
+    the headless executable into shell pipelines.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+
+//==============================================================================
+/**
+ * Streams interleaved PCM from an InputStream through a processor to an
+ * OutputStream in fixed blocks.
+ *
+ * Three threads share the work so the DSP never touches the pipes:
+ *   - a reader thread fills input blocks from the input stream,
+ *   - the thread calling run() converts, processes and converts back,
+ *   - a writer thread drains output blocks to the output stream.
+ * Each direction is double-buffered (kNumBuffers blocks handed over through
+ * an AbstractFifo and a pair of WaitableEvents), so a read or write of one
+ * block overlaps processing of the next. The DSP thread only waits when the
+ * input has not arrived yet or both output buffers are still queued.
+ *
+ * Latency is bounded: a frame leaves at most kNumBuffers blocks after the
+ * reader has it on each side, plus the processor's own latency. With
+ * compensateLatency the processor latency is trimmed from the start and
+ * flushed with silence at the end, so the output has exactly as many frames
+ * as the input and lines up with it — what a pipeline of tools expects.
+ *
+ * Formats: little-endian 32-bit float or packed 24-bit signed integer.
+ * Float output is not clipped; int24 output clips at full scale. A partial
+ * frame at the end of the input is dropped.
+ */
+class PcmStreamer
+{
+public:
+    //==============================================================================
+    enum class SampleFormat
+    {
+        float32,  // IEEE float, little-endian
+        int24     // Packed signed 24-bit, little-endian
+    };
+
+    static constexpr int kNumBuffers = 2;
+    static constexpr int kDefaultBlockSize = 512;
+
+    struct Options
+    {
+        SampleFormat format = SampleFormat::float32;  ///< Sample encoding in and out
+        int numChannels = 2;                          ///< Interleaved channels in and out (1 or 2)
+        double sampleRate = 48000.0;                  ///< Rate the processor is prepared at
+        int blockSize = kDefaultBlockSize;            ///< Frames per block read, processed and written
+        bool compensateLatency = true;                ///< Trim the processor latency so output aligns with input
+    };
+
+    /** Parse a format name ("f32" or "s24"). @return false if unknown */
+    static bool parseSampleFormat(const juce::String& name, SampleFormat& format);
+
+    /** @return Bytes per interleaved frame. */
+    static int getFrameBytes(const Options& options);
+
+    PcmStreamer(juce::AudioProcessor& processorToUse, const Options& optionsToUse);
+
+    //==============================================================================
+    /**
+     * Stream until the input ends, the output fails or stop() is called.
+     * Prepares the processor, blocks the calling thread (the DSP thread) and
+     * releases the processor before returning.
+     * @return true if all input was processed and written
+     */
+    bool run(juce::InputStream& input, juce::OutputStream& output);
+
+    /** Ask run() to return after the current block; it then returns false. Thread-safe. */
+    void stop();
+
+    /** @return Input frames consumed so far. Thread-safe. */
+    juce::int64 getFramesRead() const { return framesRead.load(std::memory_order_relaxed); }
+
+    /** @return Output frames written so far. Thread-safe. */
+    juce::int64 getFramesWritten() const { return framesWritten.load(std::memory_order_relaxed); }
+
+private:
+    //==============================================================================
+    /** One block of interleaved bytes in flight between two threads. */
+    struct Block
+    {
+        juce::HeapBlock<char> data;
+        int numFrames = 0;
+        bool endOfStream = false;
+    };
+
+    /** Single-producer, single-consumer handoff of up to kNumBuffers blocks. */
+    struct BlockQueue
+    {
+        // An AbstractFifo holds one item less than its size, so one slot is always idle
+        std::array<Block, kNumBuffers + 1> blocks;
+        juce::AbstractFifo fifo{kNumBuffers + 1};
+        juce::WaitableEvent dataReady;
+        juce::WaitableEvent spaceFree;
+
+        /** @return The block to fill, or nullptr once cancelled. */
+        Block* waitForSpace(const std::atomic<bool>& cancelled);
+        void push();
+
+        /** @return The next block to consume, or nullptr once cancelled. */
+        Block* waitForData(const std::atomic<bool>& cancelled);
+        void pop();
+    };
+
+    /** juce::Thread running a function (the reader and writer loops). */
+    class IoThread : public juce::Thread
+    {
+    public:
+        IoThread(const juce::String& name, std::function<void()> bodyToRun)
+            : juce::Thread(name)
+            , body(std::move(bodyToRun))
+        {
+        }
+
+        void run() override { body(); }
+
+    private:
+        std::function<void()> body;
+    };
+
+    /** Stop every loop and wake any thread waiting on a queue. */
+    void cancel();
+
+    void readLoop(juce::InputStream& input);
+    void writeLoop(juce::OutputStream& output);
+
+    /** Process numFrames of the planar buffer and queue the output, minus any latency still to trim. */
+    bool processAndQueue(int numFrames);
+
+    /** Interleaved bytes into the planar buffer (mono is copied to every processor channel). */
+    void decode(const Block& block);
+
+    /** Planar buffer frames [startFrame, startFrame + numFrames) into interleaved bytes. */
+    void encode(Block& block, int startFrame, int numFrames) const;
+
+    //==============================================================================
+    juce::AudioProcessor& processor;
+    const Options options;
+    const int frameBytes;
+
+    BlockQueue inputQueue;
+    BlockQueue outputQueue;
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+    int latencyFramesToSkip = 0;
+
+    std::atomic<bool> cancelled{false};  // Set by stop() or when the output fails
+    std::atomic<juce::int64> framesRead{0};
+    std::atomic<juce::int64> framesWritten{0};
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PcmStreamer)
+};
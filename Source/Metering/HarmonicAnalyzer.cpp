@@ -0,0 +1,253 @@
+/*
+  ==============================================================================
+
+    HarmonicAnalyzer.cpp
+    GRAIN — Background harmonic analysis implementation.
+
+  ==============================================================================
+*/
+
+#include "HarmonicAnalyzer.h"
+
+namespace
+{
+constexpr float kMinFundamentalHz = 20.0f;
+constexpr float kSilencePower = 1.0e-4f;  // Hann-windowed power of a ~-100 dBFS sine
+constexpr float kEvenOddLimitDb = 60.0f;
+constexpr float kBandFloorPower = 1.0e-12f;
+}  // namespace
+
+//==============================================================================
+HarmonicAnalyzer::HarmonicAnalyzer()
+    : juce::Thread("GRAIN Harmonic Analyzer")
+    , window(static_cast<size_t>(kFftSize))
+    , fftData(static_cast<size_t>(kFftSize) * 2)
+    , dryWindow(static_cast<size_t>(kFftSize))
+    , outputWindow(static_cast<size_t>(kFftSize))
+    , dryPower(static_cast<size_t>(kFftSize / 2 + 1))
+    , outputPower(static_cast<size_t>(kFftSize / 2 + 1))
+{
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), window.size(),
+                                                            juce::dsp::WindowingFunction<float>::hann, false);
+}
+
+HarmonicAnalyzer::~HarmonicAnalyzer()
+{
+    stopThread(1000);
+}
+
+//==============================================================================
+void HarmonicAnalyzer::prepare(double sampleRate)
+{
+    currentSampleRate.store(sampleRate > 0.0 ? sampleRate : 44100.0);
+}
+
+void HarmonicAnalyzer::setEnabled(bool shouldBeEnabled)
+{
+    if (shouldBeEnabled == isThreadRunning())
+    {
+        return;
+    }
+
+    if (shouldBeEnabled)
+    {
+        startThread(juce::Thread::Priority::low);
+    }
+    else
+    {
+        stopThread(1000);
+    }
+}
+
+//==============================================================================
+void HarmonicAnalyzer::pushSamples(const float* dry, const float* output, int numSamples) noexcept
+{
+    // Whole blocks only, so every window the analysis thread reads is contiguous
+    if (numSamples <= 0 || fifo.getFreeSpace() < numSamples)
+    {
+        return;
+    }
+
+    const auto scope = fifo.write(numSamples);
+
+    if (scope.blockSize1 > 0)
+    {
+        fifoBuffer.copyFrom(0, scope.startIndex1, dry, scope.blockSize1);
+        fifoBuffer.copyFrom(1, scope.startIndex1, output, scope.blockSize1);
+    }
+
+    if (scope.blockSize2 > 0)
+    {
+        fifoBuffer.copyFrom(0, scope.startIndex2, dry + scope.blockSize1, scope.blockSize2);
+        fifoBuffer.copyFrom(1, scope.startIndex2, output + scope.blockSize1, scope.blockSize2);
+    }
+}
+
+HarmonicAnalyzer::Result HarmonicAnalyzer::getLatestResult() const
+{
+    const juce::SpinLock::ScopedLockType lock(resultLock);
+    return latestResult;
+}
+
+//==============================================================================
+void HarmonicAnalyzer::run()
+{
+    // Anything left from a previous session is stale
+    discardPending();
+
+    while (!threadShouldExit())
+    {
+        if (fifo.getNumReady() >= kFftSize)
+        {
+            {
+                const auto scope = fifo.read(kFftSize);
+
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    auto* dest = (ch == 0 ? dryWindow : outputWindow).data();
+                    std::copy_n(fifoBuffer.getReadPointer(ch, scope.startIndex1), scope.blockSize1, dest);
+                    std::copy_n(fifoBuffer.getReadPointer(ch, scope.startIndex2), scope.blockSize2,
+                                dest + scope.blockSize1);
+                }
+            }
+
+            // Keep only one window per period; the audio thread refills from here
+            discardPending();
+            analyseWindow(dryWindow.data(), outputWindow.data());
+        }
+
+        wait(kAnalysisIntervalMs);
+    }
+}
+
+void HarmonicAnalyzer::discardPending()
+{
+    const auto ready = fifo.getNumReady();
+
+    if (ready > 0)
+    {
+        fifo.read(ready);
+    }
+}
+
+//==============================================================================
+void HarmonicAnalyzer::computePowerSpectrum(const float* input, std::vector<float>& power)
+{
+    std::fill(fftData.begin(), fftData.end(), 0.0f);
+    juce::FloatVectorOperations::multiply(fftData.data(), input, window.data(), kFftSize);
+    fft.performRealOnlyForwardTransform(fftData.data(), true);
+
+    for (size_t bin = 0; bin < power.size(); ++bin)
+    {
+        const float re = fftData[bin * 2];
+        const float im = fftData[bin * 2 + 1];
+        power[bin] = re * re + im * im;
+    }
+}
+
+float HarmonicAnalyzer::sumAroundBin(const std::vector<float>& power, int bin) const
+{
+    const int first = std::max(1, bin - kPeakSearchBins);
+    const int last = std::min(static_cast<int>(power.size()) - 1, bin + kPeakSearchBins);
+
+    float sum = 0.0f;
+    for (int b = first; b <= last; ++b)
+    {
+        sum += power[static_cast<size_t>(b)];
+    }
+
+    return sum;
+}
+
+void HarmonicAnalyzer::analyseWindow(const float* dry, const float* output)
+{
+    computePowerSpectrum(dry, dryPower);
+    computePowerSpectrum(output, outputPower);
+
+    const double sampleRate = currentSampleRate.load();
+    const auto binHz = static_cast<float>(sampleRate / kFftSize);
+    const int numBins = static_cast<int>(outputPower.size());
+    const int firstBin = std::max(1, static_cast<int>(std::ceil(kMinFundamentalHz / binHz)));
+
+    Result result;
+
+    // --- Fundamental: strongest output partial, refined by parabolic interpolation ---
+    int peakBin = firstBin;
+    for (int b = firstBin; b < numBins - 1; ++b)
+    {
+        if (outputPower[static_cast<size_t>(b)] > outputPower[static_cast<size_t>(peakBin)])
+        {
+            peakBin = b;
+        }
+    }
+
+    const float fundamentalPower = sumAroundBin(outputPower, peakBin);
+
+    if (fundamentalPower > kSilencePower && peakBin > 0 && peakBin < numBins - 1)
+    {
+        const float a = std::sqrt(outputPower[static_cast<size_t>(peakBin - 1)]);
+        const float b = std::sqrt(outputPower[static_cast<size_t>(peakBin)]);
+        const float c = std::sqrt(outputPower[static_cast<size_t>(peakBin + 1)]);
+        const float denom = a - 2.0f * b + c;
+        const float offset = std::abs(denom) > 1.0e-12f ? 0.5f * (a - c) / denom : 0.0f;
+        const float fundamentalBin = static_cast<float>(peakBin) + offset;
+
+        // --- Harmonics 2..kMaxHarmonic below Nyquist ---
+        float evenPower = 0.0f;
+        float oddPower = 0.0f;
+
+        for (int k = 2; k <= kMaxHarmonic; ++k)
+        {
+            const auto bin = static_cast<int>(std::round(fundamentalBin * static_cast<float>(k)));
+
+            if (bin + kPeakSearchBins >= numBins)
+            {
+                break;
+            }
+
+            if (k % 2 == 0)
+            {
+                evenPower += sumAroundBin(outputPower, bin);
+            }
+            else
+            {
+                oddPower += sumAroundBin(outputPower, bin);
+            }
+        }
+
+        result.valid = true;
+        result.fundamentalHz = fundamentalBin * binHz;
+        result.thdPercent = 100.0f * std::sqrt((evenPower + oddPower) / fundamentalPower);
+
+        const float ratioDb = 10.0f * std::log10((evenPower + kBandFloorPower) / (oddPower + kBandFloorPower));
+        result.evenOddRatioDb = juce::jlimit(-kEvenOddLimitDb, kEvenOddLimitDb, ratioDb);
+    }
+
+    // --- Difference spectrum: log-spaced bands from 20 Hz to Nyquist ---
+    const auto nyquist = static_cast<float>(sampleRate * 0.5);
+    const float bandRatio = std::pow(nyquist / kMinFundamentalHz, 1.0f / static_cast<float>(kNumBands));
+    float bandLow = kMinFundamentalHz;
+
+    for (size_t band = 0; band < result.differenceDb.size(); ++band)
+    {
+        const float bandHigh = bandLow * bandRatio;
+        const auto firstBandBin = static_cast<int>(bandLow / binHz);
+        const int lastBandBin = std::min(numBins - 1, std::max(firstBandBin, static_cast<int>(bandHigh / binHz)));
+
+        float dryBand = kBandFloorPower;
+        float outputBand = kBandFloorPower;
+        for (int b = firstBandBin; b <= lastBandBin; ++b)
+        {
+            dryBand += dryPower[static_cast<size_t>(b)];
+            outputBand += outputPower[static_cast<size_t>(b)];
+        }
+
+        result.differenceDb[band] = 10.0f * std::log10(outputBand / dryBand);
+        bandLow = bandHigh;
+    }
+
+    // --- Publish ---
+    const juce::SpinLock::ScopedLockType lock(resultLock);
+    result.sequence = latestResult.sequence + 1;
+    latestResult = result;
+}
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    HarmonicAnalyzer.h
+    GRAIN — Background harmonic analysis of what the saturation adds.
+    Compares the dry signal (after input gain) with the final output:
+    THD, even/odd harmonic balance and a banded difference spectrum.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+
+#include <JuceHeader.h>
+#include <array>
+
+//==============================================================================
+/**
+ * Harmonic analysis engine for GRAIN (runs on its own thread).
+ *
+ * The audio thread pushes left-channel dry/output snapshots into an
+ * AbstractFifo — one copy per signal per block, and nothing at all once the
+ * FIFO holds a full window. The analysis thread takes one window per
+ * analysis period and discards the rest, so the audio is effectively
+ * decimated to the analysis rate. Each window goes through a Hann-windowed
+ * FFT with a reused plan and preallocated buffers.
+ *
+ * Results are published under a SpinLock shared only by the analysis and
+ * message threads; the audio thread never touches it.
+ *
+ * Thread safety:
+ *   - prepare() / setEnabled(): message thread (prepare from prepareToPlay).
+ *   - pushSamples(): audio thread, lock-free.
+ *   - getLatestResult(): any thread except the audio thread.
+ *   - analyseWindow(): analysis thread (public for tests).
+ */
+class HarmonicAnalyzer : private juce::Thread
+{
+public:
+    //==============================================================================
+    static constexpr int kFftOrder = 12;
+    static constexpr int kFftSize = 1 << kFftOrder;  // 4096 → ~11.7 Hz bins at 48 kHz
+    static constexpr int kMaxHarmonic = 10;
+    static constexpr int kNumBands = 32;
+    static constexpr int kAnalysisIntervalMs = 100;  // Results are published at most ~10 Hz
+
+    /** One published analysis frame. */
+    struct Result
+    {
+        bool valid = false;           ///< false while the signal is too quiet to analyse
+        float fundamentalHz = 0.0f;   ///< Strongest partial of the output
+        float thdPercent = 0.0f;      ///< Output THD (harmonics 2..kMaxHarmonic)
+        float evenOddRatioDb = 0.0f;  ///< Even vs odd (3rd and up) harmonic energy
+        juce::uint32 sequence = 0;    ///< Incremented on every publish
+
+        /** Output minus dry per log-spaced band, 20 Hz → Nyquist (includes output gain). */
+        std::array<float, kNumBands> differenceDb{};
+    };
+
+    //==============================================================================
+    HarmonicAnalyzer();
+    ~HarmonicAnalyzer() override;
+
+    /** Set the sample rate used to map FFT bins to frequencies. */
+    void prepare(double sampleRate);
+
+    /** Start or stop the analysis thread (no thread runs while nobody is looking). */
+    void setEnabled(bool shouldBeEnabled);
+
+    /** @return true if the analysis thread is running. */
+    bool isEnabled() const { return isThreadRunning(); }
+
+    //==============================================================================
+    /** Push one block of dry and output samples. Audio thread only, lock-free.
+     *  Blocks that do not fit are dropped. */
+    void pushSamples(const float* dry, const float* output, int numSamples) noexcept;
+
+    /** @return Copy of the most recent result. */
+    Result getLatestResult() const;
+
+    //==============================================================================
+    /** Analyse one window of kFftSize dry/output samples and publish the result. */
+    void analyseWindow(const float* dry, const float* output);
+
+private:
+    //==============================================================================
+    void run() override;
+
+    /** Window + FFT into a magnitude-squared spectrum (kFftSize / 2 + 1 bins). */
+    void computePowerSpectrum(const float* input, std::vector<float>& power);
+
+    /** Sum power in ±kPeakSearchBins around a bin. */
+    float sumAroundBin(const std::vector<float>& power, int bin) const;
+
+    /** Drop everything currently in the FIFO. */
+    void discardPending();
+
+    //==============================================================================
+    static constexpr int kFifoSize = kFftSize * 2;
+    static constexpr int kPeakSearchBins = 2;  // Hann main lobe ±2 bins
+
+    std::atomic<double> currentSampleRate{44100.0};
+
+    // Audio thread → analysis thread
+    juce::AbstractFifo fifo{kFifoSize};
+    juce::AudioBuffer<float> fifoBuffer{2, kFifoSize};  // ch 0 = dry, ch 1 = output
+
+    // Analysis thread state (allocated once)
+    juce::dsp::FFT fft{kFftOrder};
+    std::vector<float> window;
+    std::vector<float> fftData;
+    std::vector<float> dryWindow;
+    std::vector<float> outputWindow;
+    std::vector<float> dryPower;
+    std::vector<float> outputPower;
+
+    // Published result
+    mutable juce::SpinLock resultLock;
+    Result latestResult;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HarmonicAnalyzer)
+};
@@ -0,0 +1,235 @@
+/*
+  ==============================================================================
+
+    MeterHub.cpp
+    GRAIN — Subscription-based metering implementation.
+
+  ==============================================================================
+*/
+
+#include "MeterHub.h"
+
+//==============================================================================
+// Subscription
+
+MeterHub::Subscription::~Subscription()
+{
+    reset();
+}
+
+MeterHub::Subscription::Subscription(Subscription&& other) noexcept : hub(other.hub), id(other.id)
+{
+    other.hub = nullptr;
+    other.id = 0;
+}
+
+MeterHub::Subscription& MeterHub::Subscription::operator=(Subscription&& other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+        hub = other.hub;
+        id = other.id;
+        other.hub = nullptr;
+        other.id = 0;
+    }
+
+    return *this;
+}
+
+void MeterHub::Subscription::reset()
+{
+    if (hub != nullptr)
+    {
+        hub->unsubscribe(id);
+        hub = nullptr;
+        id = 0;
+    }
+}
+
+//==============================================================================
+MeterHub::MeterHub()
+{
+    for (auto& point : publishedPeaks)
+    {
+        for (auto& peak : point)
+        {
+            peak.store(0.0f);
+        }
+    }
+
+    for (auto& hold : truePeakHold)
+    {
+        hold.store(0.0f);
+    }
+
+    for (auto& point : publishedLoudness)
+    {
+        for (auto& value : point)
+        {
+            value.store(kSilenceLufs);
+        }
+    }
+}
+
+MeterHub::~MeterHub()
+{
+    // Editors and analyzers must drop their subscriptions before the processor dies
+    jassert(entries.empty());
+}
+
+//==============================================================================
+MeterHub::Subscription MeterHub::subscribe(juce::uint32 meters, double rateHz)
+{
+    const int id = nextId++;
+    entries.push_back({id, meters, rateHz > 0.0 ? rateHz : kDefaultRateHz});
+    updateAggregate();
+
+    return Subscription(*this, id);
+}
+
+void MeterHub::unsubscribe(int id)
+{
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [id](const Entry& e) { return e.id == id; }),
+                  entries.end());
+    updateAggregate();
+}
+
+void MeterHub::updateAggregate()
+{
+    juce::uint32 mask = kNone;
+    maxRateHz = 0.0;
+
+    for (const auto& entry : entries)
+    {
+        mask |= entry.meters;
+        maxRateHz = std::max(maxRateHz, entry.rateHz);
+    }
+
+    const double rate = maxRateHz > 0.0 ? maxRateHz : kDefaultRateHz;
+    const auto interval = static_cast<int>(currentSampleRate.load() / rate);
+    publishIntervalSamples.store(std::max(1, interval));
+
+    // Publish the mask last so the audio thread never sees a new meter with a stale interval
+    const auto previousMask = activeMask.exchange(mask);
+
+    if (mask != previousMask && onActiveMetersChanged != nullptr)
+    {
+        onActiveMetersChanged(mask);
+    }
+}
+
+//==============================================================================
+float MeterHub::getPeak(Point point, int channel) const
+{
+    if (channel < 0 || channel >= kMaxChannels)
+    {
+        return 0.0f;
+    }
+
+    return publishedPeaks[static_cast<size_t>(point)][static_cast<size_t>(channel)].load(std::memory_order_relaxed);
+}
+
+float MeterHub::getTruePeakHold(int channel) const
+{
+    if (channel < 0 || channel >= kMaxChannels)
+    {
+        return 0.0f;
+    }
+
+    return truePeakHold[static_cast<size_t>(channel)].load(std::memory_order_relaxed);
+}
+
+void MeterHub::resetTruePeakHold()
+{
+    truePeakHoldResetPending.store(true);
+}
+
+MeterHub::Loudness MeterHub::getLoudness(Point point) const
+{
+    const auto index = static_cast<size_t>(point);
+
+    if (index >= publishedLoudness.size())
+    {
+        return {};
+    }
+
+    const auto& values = publishedLoudness[index];
+    return {values[0].load(std::memory_order_relaxed), values[1].load(std::memory_order_relaxed),
+            values[2].load(std::memory_order_relaxed)};
+}
+
+//==============================================================================
+void MeterHub::prepare(double sampleRate)
+{
+    currentSampleRate.store(sampleRate > 0.0 ? sampleRate : 44100.0);
+
+    const double rate = maxRateHz > 0.0 ? maxRateHz : kDefaultRateHz;
+    publishIntervalSamples.store(std::max(1, static_cast<int>(currentSampleRate.load() / rate)));
+
+    for (auto& point : pendingPeaks)
+    {
+        point.fill(0.0f);
+    }
+
+    samplesSincePublish = 0;
+}
+
+void MeterHub::accumulatePeak(Point point, int channel, float peak) noexcept
+{
+    if (channel < 0 || channel >= kMaxChannels)
+    {
+        return;
+    }
+
+    auto& pending = pendingPeaks[static_cast<size_t>(point)][static_cast<size_t>(channel)];
+    pending = std::max(pending, peak);
+}
+
+void MeterHub::publishLoudness(Point point, const Loudness& loudness) noexcept
+{
+    const auto index = static_cast<size_t>(point);
+
+    if (index >= publishedLoudness.size())
+    {
+        return;
+    }
+
+    auto& values = publishedLoudness[index];
+    values[0].store(loudness.momentary, std::memory_order_relaxed);
+    values[1].store(loudness.shortTerm, std::memory_order_relaxed);
+    values[2].store(loudness.integrated, std::memory_order_relaxed);
+}
+
+bool MeterHub::endBlock(int numSamples) noexcept
+{
+    samplesSincePublish += numSamples;
+
+    if (samplesSincePublish < publishIntervalSamples.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    for (size_t p = 0; p < pendingPeaks.size(); ++p)
+    {
+        for (size_t ch = 0; ch < pendingPeaks[p].size(); ++ch)
+        {
+            publishedPeaks[p][ch].store(pendingPeaks[p][ch], std::memory_order_relaxed);
+            pendingPeaks[p][ch] = 0.0f;
+        }
+    }
+
+    // Max-hold for true peak (reset requests are applied here so only this thread writes the hold)
+    const bool resetHold = truePeakHoldResetPending.exchange(false);
+    const auto& truePeaks = publishedPeaks[static_cast<size_t>(Point::kOutputTruePeak)];
+
+    for (size_t ch = 0; ch < truePeakHold.size(); ++ch)
+    {
+        const float previous = resetHold ? 0.0f : truePeakHold[ch].load(std::memory_order_relaxed);
+        truePeakHold[ch].store(std::max(previous, truePeaks[ch].load(std::memory_order_relaxed)),
+                               std::memory_order_relaxed);
+    }
+
+    samplesSincePublish = 0;
+    return true;
+}
@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+
+    MeterHub.h
+    GRAIN — Subscription-based metering between the audio thread and its UIs.
+    Consumers (editor, standalone, analyzers) register interest in specific
+    meters and an update rate; the audio thread only computes what is
+    subscribed and publishes at the rate the fastest consumer asked for.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <functional>
+#include <vector>
+
+//==============================================================================
+/**
+ * Meter subscription registry and aggregation point for GRAIN.
+ *
+ * Consumers call subscribe() with a bitmask of Meter flags and the rate at
+ * which they want fresh values. All live subscriptions are folded into one
+ * atomic mask and one publish interval. Per block, the audio thread:
+ *   1. reads getActiveMask() once and skips every meter not in the mask
+ *   2. feeds values via accumulatePeak() (max-aggregated across blocks)
+ *   3. calls endBlock() — values reach the published atomics only once enough
+ *      samples have elapsed for the fastest subscriber (e.g. every ~33 ms
+ *      for a 30 Hz consumer, regardless of the host block size)
+ *
+ * With no subscribers the mask is 0 and the audio thread does no meter work.
+ *
+ * Thread safety:
+ *   - subscribe() / Subscription::reset() / destruction: message thread only.
+ *   - prepare(): from prepareToPlay (never concurrently with the audio callback).
+ *   - getActiveMask() / accumulatePeak() / endBlock(): audio thread, lock-free.
+ *   - getPeak() / getTruePeakHold() / getLoudness() and the reset requests: any thread.
+ */
+class MeterHub
+{
+public:
+    //==============================================================================
+    /** Individual meters that can be subscribed to (bit flags). */
+    enum Meter : juce::uint32
+    {
+        kNone = 0,
+        kInputPeak = 1u << 0,   ///< Sample-peak level of the input (before input gain)
+        kOutputPeak = 1u << 1,  ///< Sample-peak level of the final output
+        kTruePeak = 1u << 2,    ///< BS.1770 true-peak (4× interpolated) level of the final output
+        kAnalysis = 1u << 3,    ///< Harmonic analysis of dry vs output (HarmonicAnalyzer)
+        kLoudness = 1u << 4,    ///< BS.1770 loudness (LUFS) of input and output
+    };
+
+    /** Signal point a peak value is measured at. */
+    enum class Point
+    {
+        kInput = 0,
+        kOutput = 1,
+        kOutputTruePeak = 2
+    };
+
+    static constexpr int kMaxChannels = 2;
+    static constexpr int kNumPoints = 3;
+    static constexpr double kDefaultRateHz = 30.0;
+    static constexpr float kSilenceLufs = -120.0f;
+
+    /** One loudness reading (LUFS). */
+    struct Loudness
+    {
+        float momentary = kSilenceLufs;
+        float shortTerm = kSilenceLufs;
+        float integrated = kSilenceLufs;
+    };
+
+    //==============================================================================
+    /**
+     * RAII handle for one subscription. Unsubscribes when destroyed or reset.
+     * Move-only; a default-constructed Subscription is inactive.
+     */
+    class Subscription
+    {
+    public:
+        Subscription() = default;
+        ~Subscription();
+
+        Subscription(Subscription&& other) noexcept;
+        Subscription& operator=(Subscription&& other) noexcept;
+
+        Subscription(const Subscription&) = delete;
+        Subscription& operator=(const Subscription&) = delete;
+
+        /** Drop the subscription (no-op if inactive). */
+        void reset();
+
+        /** @return true if this handle holds a live subscription. */
+        bool isActive() const { return hub != nullptr; }
+
+    private:
+        friend class MeterHub;
+        Subscription(MeterHub& owner, int subscriptionId) : hub(&owner), id(subscriptionId) {}
+
+        MeterHub* hub = nullptr;
+        int id = 0;
+    };
+
+    //==============================================================================
+    MeterHub();
+    ~MeterHub();
+
+    //==============================================================================
+    // Consumer side (message thread)
+
+    /** Register interest in a set of meters.
+     *  @param meters  Bitmask of Meter flags.
+     *  @param rateHz  Update rate this consumer needs (e.g. 30 for a meter bar).
+     *  @return Handle that keeps the subscription alive. */
+    [[nodiscard]] Subscription subscribe(juce::uint32 meters, double rateHz = kDefaultRateHz);
+
+    /** @return Mask of all meters with at least one subscriber. */
+    juce::uint32 getSubscribedMeters() const { return activeMask.load(std::memory_order_relaxed); }
+
+    /** Called on the message thread whenever the subscribed mask changes
+     *  (e.g. to start/stop a background analysis thread). */
+    std::function<void(juce::uint32 activeMeters)> onActiveMetersChanged;
+
+    /** @return Most recently published peak (linear, >= 0). Thread-safe. */
+    float getPeak(Point point, int channel) const;
+
+    /** @return Highest true peak published since the last hold reset (linear). Thread-safe. */
+    float getTruePeakHold(int channel) const;
+
+    /** Request a max-hold reset; applied by the audio thread on its next publish. Thread-safe. */
+    void resetTruePeakHold();
+
+    /** @return Most recently published loudness at kInput or kOutput. Thread-safe. */
+    Loudness getLoudness(Point point) const;
+
+    /** Request that integrated loudness restarts; the audio thread picks it up. Thread-safe. */
+    void resetIntegratedLoudness() { integratedLoudnessResetPending.store(true); }
+
+    //==============================================================================
+    // Audio side
+
+    /** Set the sample rate used to convert subscriber rates into sample intervals. */
+    void prepare(double sampleRate);
+
+    /** @return Mask of meters the audio thread should compute this block. */
+    juce::uint32 getActiveMask() const noexcept { return activeMask.load(std::memory_order_relaxed); }
+
+    /** Fold a block peak into the pending (unpublished) value. Audio thread only. */
+    void accumulatePeak(Point point, int channel, float peak) noexcept;
+
+    /** Publish a loudness reading (called whenever a 100 ms loudness block completes). Audio thread only. */
+    void publishLoudness(Point point, const Loudness& loudness) noexcept;
+
+    /** @return true once per resetIntegratedLoudness() request. Audio thread only. */
+    bool takeIntegratedLoudnessResetRequest() noexcept { return integratedLoudnessResetPending.exchange(false); }
+
+    /** Advance the aggregation window by numSamples and publish if it is due.
+     *  @return true if values were published during this call. Audio thread only. */
+    bool endBlock(int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    void unsubscribe(int id);
+
+    /** Recompute the active mask and publish interval from all subscriptions. */
+    void updateAggregate();
+
+    //==============================================================================
+    struct Entry
+    {
+        int id = 0;
+        juce::uint32 meters = kNone;
+        double rateHz = kDefaultRateHz;
+    };
+
+    // Message-thread state
+    std::vector<Entry> entries;
+    int nextId = 1;
+    double maxRateHz = 0.0;
+
+    // Shared state
+    std::atomic<double> currentSampleRate{44100.0};
+    std::atomic<juce::uint32> activeMask{kNone};
+    std::atomic<int> publishIntervalSamples{1};
+
+    // Audio-thread state (pending aggregation window)
+    std::array<std::array<float, kMaxChannels>, kNumPoints> pendingPeaks{};
+    int samplesSincePublish = 0;
+
+    // Published values (read by consumers)
+    std::array<std::array<std::atomic<float>, kMaxChannels>, kNumPoints> publishedPeaks{};
+
+    // True-peak max-hold (written by the audio thread on publish)
+    std::array<std::atomic<float>, kMaxChannels> truePeakHold{};
+    std::atomic<bool> truePeakHoldResetPending{false};
+
+    // Loudness (kInput / kOutput only): momentary, short-term, integrated
+    std::array<std::array<std::atomic<float>, 3>, 2> publishedLoudness{};
+    std::atomic<bool> integratedLoudnessResetPending{false};
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MeterHub)
+};
@@ -64,7 +64,12 @@ GRAINAudioProcessorEditor::GRAINAudioProcessorEditor(GRAINAudioProcessor& p)
                   .withOptionsFrom(mixSliderRelay)
                   .withOptionsFrom(outputSliderRelay)
                   .withOptionsFrom(bypassToggleRelay)
+                  .withOptionsFrom(autoGainToggleRelay)
                   .withOptionsFrom(focusComboRelay)
+                  .withEventListener("resetTruePeakHold",
+                                     [this](const juce::var&) { processor.getMeterHub().resetTruePeakHold(); })
+                  .withEventListener("resetLoudness",
+                                     [this](const juce::var&) { processor.getMeterHub().resetIntegratedLoudness(); })
                   .withResourceProvider([this](const auto& url) { return getResource(url); }))
     , driveAttachment(*p.getAPVTS().getParameter("drive"), driveSliderRelay)
     , warmthAttachment(*p.getAPVTS().getParameter("warmth"), warmthSliderRelay)
@@ -72,6 +77,7 @@ GRAINAudioProcessorEditor::GRAINAudioProcessorEditor(GRAINAudioProcessor& p)
     , mixAttachment(*p.getAPVTS().getParameter("mix"), mixSliderRelay)
     , outputAttachment(*p.getAPVTS().getParameter("output"), outputSliderRelay)
     , bypassAttachment(*p.getAPVTS().getParameter("bypass"), bypassToggleRelay)
+    , autoGainAttachment(*p.getAPVTS().getParameter("autoGain"), autoGainToggleRelay)
     , focusAttachment(*p.getAPVTS().getParameter("focus"), focusComboRelay)
 {
     // Keep LookAndFeel for standalone native components
@@ -92,6 +98,21 @@ GRAINAudioProcessorEditor::GRAINAudioProcessorEditor(GRAINAudioProcessor& p)
         waveformDisplay = std::make_unique<WaveformDisplay>(*filePlayer);
         addAndMakeVisible(waveformDisplay.get());
 
+        // Wet overlay precomputed on a private processor with a snapshot of the current parameters
+        wetPreview = std::make_unique<WetPreviewRenderer>(
+            [this]() -> std::unique_ptr<juce::AudioProcessor>
+            {
+                juce::MemoryBlock state;
+                processor.getStateInformation(state);
+
+                auto preview = std::make_unique<GRAINAudioProcessor>();
+                preview->setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+                preview->setCalibration(processor.getCalibration());
+                return preview;
+            });
+        waveformDisplay->setWetPreview(wetPreview.get());
+        processor.getAPVTS().state.addListener(this);
+
         transportBar = std::make_unique<TransportBar>(*filePlayer);
         transportBar->addListener(this);
         addAndMakeVisible(transportBar.get());
@@ -110,8 +131,14 @@ GRAINAudioProcessorEditor::GRAINAudioProcessorEditor(GRAINAudioProcessor& p)
                                  : kWebViewHeight;
     setSize(kEditorWidth, editorHeight);
 
-    // Start meter timer (60 Hz ~ 16ms)
-    startTimerHz(60);
+    // Subscribe to the meters this editor displays (released in the destructor)
+    meterSubscription = processor.getMeterHub().subscribe(
+        MeterHub::kInputPeak | MeterHub::kOutputPeak | MeterHub::kTruePeak | MeterHub::kLoudness,
+        kMeterSubscriptionHz);
+    analysisSubscription = processor.getMeterHub().subscribe(MeterHub::kAnalysis, kMeterSubscriptionHz);
+
+    // Start refreshing meters (vsync-aligned while they move, see refreshTick())
+    refreshRegistration.wake();
 }
 
 GRAINAudioProcessorEditor::~GRAINAudioProcessorEditor()
@@ -121,7 +148,8 @@ GRAINAudioProcessorEditor::~GRAINAudioProcessorEditor()
         setLookAndFeel(nullptr);
     }
 
-    stopTimer();
+    meterSubscription.reset();
+    analysisSubscription.reset();
 
     if (standaloneMode)
     {
@@ -130,6 +158,13 @@ GRAINAudioProcessorEditor::~GRAINAudioProcessorEditor()
         processor.setWaveformDisplay(nullptr);
         processor.setFilePlayerSource(nullptr);
 
+        processor.getAPVTS().state.removeListener(this);
+        if (waveformDisplay != nullptr)
+        {
+            waveformDisplay->setWetPreview(nullptr);
+        }
+        wetPreview.reset();
+
         if (filePlayer != nullptr)
         {
             filePlayer->removeListener(this);
@@ -228,7 +263,8 @@ void GRAINAudioProcessorEditor::openFileRequested()
         return;
     }
 
-    fileChooser = std::make_unique<juce::FileChooser>("Open Audio File", juce::File(), "*.wav;*.aiff;*.aif");
+    fileChooser = std::make_unique<juce::FileChooser>("Open Audio File", juce::File(),
+                                                      AudioFileUtils::getSupportedWildcard());
 
     auto chooserFlags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles;
 
@@ -252,6 +288,16 @@ void GRAINAudioProcessorEditor::stopRequested()
     }
 }
 
+void GRAINAudioProcessorEditor::valueTreePropertyChanged(juce::ValueTree& /*tree*/,
+                                                         const juce::Identifier& /*property*/)
+{
+    // Any parameter affects the processed output; the renderer debounces bursts (e.g. knob drags)
+    if (wetPreview != nullptr)
+    {
+        wetPreview->parametersChanged();
+    }
+}
+
 void GRAINAudioProcessorEditor::exportRequested()
 {
     if (filePlayer == nullptr || !filePlayer->isFileLoaded() || recorder == nullptr)
@@ -264,8 +310,8 @@ void GRAINAudioProcessorEditor::exportRequested()
     auto defaultName = loadedFile.getFileNameWithoutExtension() + "_processed.wav";
     auto defaultDir = loadedFile.getParentDirectory();
 
-    fileChooser =
-        std::make_unique<juce::FileChooser>("Export Processed Audio", defaultDir.getChildFile(defaultName), "*.wav");
+    fileChooser = std::make_unique<juce::FileChooser>("Export Processed Audio", defaultDir.getChildFile(defaultName),
+                                                      "*.wav;*.flac");
 
     auto chooserFlags = juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles |
                         juce::FileBrowserComponent::warnAboutOverwriting;
@@ -280,18 +326,39 @@ void GRAINAudioProcessorEditor::exportRequested()
                                      return;  // User cancelled
                                  }
 
-                                 // Ensure .wav extension
+                                 // Ensure .wav or .flac extension
                                  auto outputFile = result;
-                                 if (outputFile.getFileExtension().toLowerCase() != ".wav")
+                                 if (!outputFile.hasFileExtension(".wav;.flac"))
                                  {
                                      outputFile = outputFile.withFileExtension(".wav");
                                  }
 
+                                 // WAV exports are float so overs survive; FLAC is 24-bit
+                                 recorder->setFormat(
+                                     AudioRecorder::getFormatForFile(outputFile, AudioRecorder::Format::wavFloat));
+
                                  // Start recording
                                  auto const sampleRate = filePlayer->getFileSampleRate();
-                                 auto const numChannels = filePlayer->getFileNumChannels();
+                                 auto const numChannels = std::min(filePlayer->getFileNumChannels(), 2);
+
+                                 // Stems: dry, wet-only and null-test difference files (plus its JSON
+                                 // report) beside the output, all from the same pass
+                                 AudioRecorder::TapFiles tapFiles;
+                                 tapFiles[static_cast<size_t>(AudioRecorder::Tap::output)] = outputFile;
+                                 // For the report only: the processor pushes its dry tap already delayed by it
+                                 recorder->setNullTestLatency(processor.getLatencySamples());
 
-                                 if (!recorder->startRecording(outputFile, sampleRate, numChannels))
+                                 if (transportBar != nullptr && transportBar->isStemExportEnabled())
+                                 {
+                                     for (const auto tap : {AudioRecorder::Tap::dry, AudioRecorder::Tap::wet,
+                                                            AudioRecorder::Tap::difference})
+                                     {
+                                         tapFiles[static_cast<size_t>(tap)] =
+                                             AudioRecorder::getTapFile(outputFile, tap);
+                                     }
+                                 }
+
+                                 if (!recorder->startRecording(tapFiles, sampleRate, numChannels))
                                  {
                                      return;  // Failed to create output file
                                  }
@@ -332,9 +399,17 @@ void GRAINAudioProcessorEditor::transportReachedEnd()
     if (exporting && recorder != nullptr)
     {
         // Export complete — stop recording and finalize file
-        recorder->stopRecording();
+        const bool complete = recorder->stopRecording();
         exporting = false;
 
+        if (!complete)
+        {
+            // A file with gaps must not pass for a good export
+            const auto message =
+                recorder->getLastError() + "\n\nThe exported file is missing audio and should not be used.";
+            juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Export incomplete", message);
+        }
+
         if (transportBar != nullptr)
         {
             transportBar->updateButtonStates();
@@ -342,6 +417,29 @@ void GRAINAudioProcessorEditor::transportReachedEnd()
     }
 }
 
+void GRAINAudioProcessorEditor::fileLoadFinished(bool success)
+{
+    if (transportBar != nullptr)
+    {
+        transportBar->updateButtonStates();
+    }
+
+    if (!success)
+    {
+        return;
+    }
+
+    if (waveformDisplay != nullptr)
+    {
+        waveformDisplay->clearWetBuffer();
+    }
+
+    if (wetPreview != nullptr)
+    {
+        wetPreview->setFile(filePlayer->getLoadedFile());
+    }
+}
+
 //==============================================================================
 // Drag & drop (GT-19)
 
@@ -405,44 +503,92 @@ void GRAINAudioProcessorEditor::loadFileIntoPlayer(const juce::File& file)
         return;
     }
 
-    filePlayer->loadFile(file);
+    // Prepared first so the loader primes the new file's buffers at the device rate;
+    // the rest of the UI follows in fileLoadFinished()
     filePlayer->prepareToPlay(processor.getSampleRate(), processor.getBlockSize());
+    filePlayer->loadFileAsync(file);
 
     if (transportBar != nullptr)
     {
         transportBar->updateButtonStates();
     }
-
-    if (waveformDisplay != nullptr)
-    {
-        waveformDisplay->clearWetBuffer();
-    }
 }
 
 //==============================================================================
-void GRAINAudioProcessorEditor::timerCallback()
+RefreshScheduler::Mode GRAINAudioProcessorEditor::refreshTick()
 {
     // Don't send events until the web page has fully loaded
     if (!webView.pageReady)
-        return;
+        return RefreshScheduler::Mode::kWatch;
+
+    // Decay is defined per 60 Hz frame; scale it to the actual refresh interval (vblank rates vary)
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    const auto elapsedFrames = static_cast<float>(juce::jlimit(0.0, 60.0, (nowMs - lastRefreshMs) * 0.06));
+    const float decay = std::pow(kMeterDecay, elapsedFrames);
+    lastRefreshMs = nowMs;
+
+    // Read the latest published meter levels from the audio thread
+    auto const& meters = processor.getMeterHub();
+    float const inL = meters.getPeak(MeterHub::Point::kInput, 0);
+    float const inR = meters.getPeak(MeterHub::Point::kInput, 1);
+    float const outL = meters.getPeak(MeterHub::Point::kOutput, 0);
+    float const outR = meters.getPeak(MeterHub::Point::kOutput, 1);
+    float const truePeakHold = std::max(meters.getTruePeakHold(0), meters.getTruePeakHold(1));
+
+    // Apply meter decay smoothing (snapped to zero so a silent frame stops changing)
+    displayInputL = decayMeter(inL, displayInputL, decay);
+    displayInputR = decayMeter(inR, displayInputR, decay);
+    displayOutputL = decayMeter(outL, displayOutputL, decay);
+    displayOutputR = decayMeter(outR, displayOutputR, decay);
+
+    // One packed frame per tick: meters, loudness, envelope and (when new) analysis
+    telemetry.beginFrame();
+    telemetry.addSection(TelemetryPacker::kMeters, {displayInputL, displayInputR, displayOutputL, displayOutputR,
+                                                    GrainDSP::TruePeakDetector::toDecibels(truePeakHold)});
+
+    // Loudness (published every 100 ms by the audio thread)
+    const auto inLoudness = meters.getLoudness(MeterHub::Point::kInput);
+    const auto outLoudness = meters.getLoudness(MeterHub::Point::kOutput);
+    telemetry.addSection(TelemetryPacker::kLoudness, {inLoudness.shortTerm, outLoudness.shortTerm,
+                                                      outLoudness.integrated, processor.getAutoGainTrimDb()});
+
+    telemetry.addSection(TelemetryPacker::kEnvelope, {quantiseEnvelope(processor.getEnvelope())});
+
+    // The analyzer publishes at most ~10 Hz; only forward new results
+    const auto result = processor.getHarmonicAnalyzer().getLatestResult();
+    if (result.sequence != lastAnalysisSequence)
+    {
+        lastAnalysisSequence = result.sequence;
+
+        std::array<float, 4 + HarmonicAnalyzer::kNumBands> analysis{};
+        analysis[0] = result.valid ? 1.0f : 0.0f;
+        analysis[1] = result.fundamentalHz;
+        analysis[2] = result.thdPercent;
+        analysis[3] = result.evenOddRatioDb;
+        std::copy(result.differenceDb.begin(), result.differenceDb.end(), analysis.begin() + 4);
+        telemetry.addSection(TelemetryPacker::kAnalysis, analysis.data(), static_cast<int>(analysis.size()));
+    }
+
+    // Nothing moved: skip the bridge entirely and, after a while, fall back to the slow watch.
+    // Meters are written by the audio thread, which never wakes the UI, so they are polled there.
+    if (!telemetry.hasChangedSinceLastCommit())
+    {
+        ++unchangedFrames;
+        return unchangedFrames >= kIdleAfterFrames ? RefreshScheduler::Mode::kWatch : RefreshScheduler::Mode::kActive;
+    }
+
+    unchangedFrames = 0;
+    webView.emitEventIfBrowserIsVisible("telemetry", telemetry.commit());
+    return RefreshScheduler::Mode::kActive;
+}
 
-    // Read atomic meter levels from the audio thread
-    float const inL = processor.inputLevelL.load();
-    float const inR = processor.inputLevelR.load();
-    float const outL = processor.outputLevelL.load();
-    float const outR = processor.outputLevelR.load();
-
-    // Apply meter decay smoothing
-    displayInputL = std::max(inL, displayInputL * kMeterDecay);
-    displayInputR = std::max(inR, displayInputR * kMeterDecay);
-    displayOutputL = std::max(outL, displayOutputL * kMeterDecay);
-    displayOutputR = std::max(outR, displayOutputR * kMeterDecay);
-
-    // Send meter update to web UI
-    juce::DynamicObject::Ptr payload = new juce::DynamicObject();
-    payload->setProperty("inL", displayInputL);
-    payload->setProperty("inR", displayInputR);
-    payload->setProperty("outL", displayOutputL);
-    payload->setProperty("outR", displayOutputR);
-    webView.emitEventIfBrowserIsVisible("meterUpdate", juce::var(payload.get()));
+float GRAINAudioProcessorEditor::decayMeter(float level, float displayed, float decay)
+{
+    const float decayed = std::max(level, displayed * decay);
+    return decayed < kMeterSnapToZero ? 0.0f : decayed;
+}
+
+float GRAINAudioProcessorEditor::quantiseEnvelope(float envelope)
+{
+    return std::round(envelope / kEnvelopeStep) * kEnvelopeStep;
 }
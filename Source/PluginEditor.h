@@ -18,7 +18,10 @@
 #include "Standalone/FilePlayerSource.h"
 #include "Standalone/TransportBar.h"
 #include "Standalone/WaveformDisplay.h"
+#include "Standalone/WetPreviewRenderer.h"
 #include "UI/GrainLookAndFeel.h"
+#include "UI/RefreshScheduler.h"
+#include "UI/TelemetryPacker.h"
 
 #include <JuceHeader.h>
 
@@ -30,17 +33,21 @@
  * using JUCE 8 relay classes for parameter synchronization:
  *   - WebSliderRelay + WebSliderParameterAttachment for sliders
  *   - WebComboBoxRelay + WebComboBoxParameterAttachment for Focus
- *   - WebToggleButtonRelay + WebToggleButtonParameterAttachment for Bypass
+ *   - WebToggleButtonRelay + WebToggleButtonParameterAttachment for Bypass / Auto Gain
  *
- * VU meter levels are sent via custom emitEventIfBrowserIsVisible().
+ * Meters, loudness, the Dynamic Bias envelope and harmonic analysis are sent as one
+ * packed "telemetry" event per tick (see TelemetryPacker), only when something changed;
+ * the UI resets the hold with a "resetTruePeakHold" event and integrated
+ * loudness with "resetLoudness".
  * Standalone components (transport, waveform, recorder) remain native JUCE.
  */
 class GRAINAudioProcessorEditor
     : public juce::AudioProcessorEditor
     , public juce::FileDragAndDropTarget
     , public FilePlayerSource::Listener
-    , private juce::Timer
+    , private RefreshScheduler::Client
     , private TransportBar::Listener
+    , private juce::ValueTree::Listener
 {
 public:
     explicit GRAINAudioProcessorEditor(GRAINAudioProcessor& /*p*/);
@@ -62,7 +69,9 @@ public:
 
 private:
     //==============================================================================
-    void timerCallback() override;
+    // RefreshScheduler::Client — meter/telemetry refresh
+    RefreshScheduler::Mode refreshTick() override;
+    juce::Component& getRefreshComponent() override { return *this; }
 
     /** Serve embedded HTML/CSS/JS resources from BinaryData. */
     std::optional<juce::WebBrowserComponent::Resource> getResource(const juce::String& url);
@@ -81,8 +90,9 @@ private:
     juce::WebSliderRelay mixSliderRelay{"mixSlider"};
     juce::WebSliderRelay outputSliderRelay{"outputSlider"};
 
-    // Toggle relay (bypass)
+    // Toggle relays (bypass, auto-gain)
     juce::WebToggleButtonRelay bypassToggleRelay{"bypassToggle"};
+    juce::WebToggleButtonRelay autoGainToggleRelay{"autoGainToggle"};
 
     // ComboBox relay (focus)
     juce::WebComboBoxRelay focusComboRelay{"focusCombo"};
@@ -105,6 +115,7 @@ private:
     juce::WebSliderParameterAttachment mixAttachment;
     juce::WebSliderParameterAttachment outputAttachment;
     juce::WebToggleButtonParameterAttachment bypassAttachment;
+    juce::WebToggleButtonParameterAttachment autoGainAttachment;
     juce::WebComboBoxParameterAttachment focusAttachment;
 
     //==============================================================================
@@ -112,7 +123,35 @@ private:
     float displayInputL = 0.0f, displayInputR = 0.0f;
     float displayOutputL = 0.0f, displayOutputR = 0.0f;
 
-    static constexpr float kMeterDecay = 0.85f;
+    static constexpr float kMeterDecay = 0.85f;         // Per 1/60 s, scaled to the actual refresh interval
+    static constexpr float kMeterSnapToZero = 1.0e-4f;  // -80 dBFS
+
+    // The envelope only drives a glow; coarse steps let its release tail settle instead of changing every frame
+    static constexpr float kEnvelopeStep = 1.0f / 256.0f;
+
+    // Meter values only need ~30 Hz refresh; display frames in between interpolate via decay
+    static constexpr double kMeterSubscriptionHz = 30.0;
+
+    // Keeps the processor computing input/output/true peaks and loudness while this editor is open
+    MeterHub::Subscription meterSubscription;
+
+    // Keeps the harmonic analysis thread running while this editor is open
+    MeterHub::Subscription analysisSubscription;
+    juce::uint32 lastAnalysisSequence = 0;
+
+    // Packed per-tick telemetry frame ("telemetry" event, decoded in grain-ui.js)
+    TelemetryPacker telemetry;
+    int unchangedFrames = 0;
+
+    // Every display frame while values move; RefreshScheduler's slow watch once frames stop changing
+    static constexpr int kIdleAfterFrames = 30;  // ~0.5 s of identical frames at 60 Hz
+    double lastRefreshMs = 0.0;
+
+    /** Peak-hold decay for one meter; tails below kMeterSnapToZero snap to 0. */
+    static float decayMeter(float level, float displayed, float decay);
+
+    /** Envelope rounded to kEnvelopeStep, so a fading tail reaches exactly 0. */
+    static float quantiseEnvelope(float envelope);
 
     //==============================================================================
     // Standalone mode (GT-17)
@@ -122,6 +161,7 @@ private:
     std::unique_ptr<FilePlayerSource> filePlayer;
     std::unique_ptr<TransportBar> transportBar;
     std::unique_ptr<WaveformDisplay> waveformDisplay;
+    std::unique_ptr<WetPreviewRenderer> wetPreview;  // Background wet overlay for the loaded file
     std::unique_ptr<AudioRecorder> recorder;
 
     // TransportBar::Listener callbacks
@@ -129,9 +169,13 @@ private:
     void stopRequested() override;
     void exportRequested() override;
 
+    // APVTS state changes (message thread) re-render the wet preview
+    void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
+
     // FilePlayerSource::Listener callbacks (for export workflow)
     void transportStateChanged(bool isNowPlaying) override;
     void transportReachedEnd() override;
+    void fileLoadFinished(bool success) override;
 
     // Export state
     bool exporting = false;
@@ -144,9 +188,13 @@ private:
     bool dragHovering = false;
     bool dragAccepted = false;
 
-    /** Load a file into the player and update all standalone components. */
+    /** Start loading a file into the player; standalone components update when it is swapped in. */
     void loadFileIntoPlayer(const juce::File& file);
 
+    //==============================================================================
+    // Shared refresh (last member: unregisters before anything refreshTick() touches is destroyed)
+    RefreshScheduler::Registration refreshRegistration{*this, RefreshScheduler::Mode::kIdle};
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GRAINAudioProcessorEditor)
 };
@@ -14,6 +14,29 @@
 #include "Standalone/AudioRecorder.h"
 #include "Standalone/FilePlayerSource.h"
 #include "Standalone/WaveformDisplay.h"
+#include "State/CalibrationProfileFile.h"
+#include "State/ParameterStateCodec.h"
+
+namespace
+{
+/** Append the newest samples of one channel to a history ring (only the last ring-length samples matter). */
+void appendToHistory(juce::AudioBuffer<float>& ring, int writePos, int channel, const float* source, int numSamples)
+{
+    const int size = ring.getNumSamples();
+    const int count = std::min(numSamples, size);
+    const int first = std::min(count, size - writePos);
+    source += numSamples - count;
+
+    juce::FloatVectorOperations::copy(ring.getWritePointer(channel, writePos), source, first);
+    juce::FloatVectorOperations::copy(ring.getWritePointer(channel), source + first, count - first);
+}
+
+/** @return The write position after appending numSamples. */
+int advanceHistory(const juce::AudioBuffer<float>& ring, int writePos, int numSamples)
+{
+    return (writePos + std::min(numSamples, ring.getNumSamples())) % ring.getNumSamples();
+}
+}  // namespace
 
 //==============================================================================
 juce::AudioProcessorValueTreeState::ParameterLayout GRAINAudioProcessor::createParameterLayout()
@@ -40,6 +63,9 @@ juce::AudioProcessorValueTreeState::ParameterLayout GRAINAudioProcessor::createP
     params.push_back(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("focus", 1), "Focus",
                                                                   juce::StringArray{"Low", "Mid", "High"}, 1));
 
+    params.push_back(
+        std::make_unique<juce::AudioParameterBool>(juce::ParameterID("autoGain", 1), "Auto Gain", false));
+
     return {params.begin(), params.end()};
 }
 
@@ -62,11 +88,18 @@ GRAINAudioProcessor::GRAINAudioProcessor()
     , inputGainParam(apvts.getRawParameterValue("inputGain"))
     , bypassParam(dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter("bypass")))
     , focusParam(dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("focus")))
+    , autoGainParam(dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter("autoGain")))
 #endif
 {
+    // The analysis thread only exists while someone subscribes to it
+    meterHub.onActiveMetersChanged = [this](juce::uint32 activeMeters)
+    { harmonicAnalyzer.setEnabled((activeMeters & MeterHub::kAnalysis) != 0); };
 }
 
-GRAINAudioProcessor::~GRAINAudioProcessor() = default;
+GRAINAudioProcessor::~GRAINAudioProcessor()
+{
+    meterHub.onActiveMetersChanged = nullptr;
+}
 
 //==============================================================================
 const juce::String GRAINAudioProcessor::getName() const
@@ -164,29 +197,64 @@ void GRAINAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     const float targetMix = bypass ? 0.0f : static_cast<float>(*mixParam);
     mixSmoothed.setCurrentAndTargetValue(targetMix);
 
+    autoGainTrimDb = 0.0f;
+    autoGainTrimDbPublished.store(0.0f);
     gainSmoothed.setCurrentAndTargetValue(juce::Decibels::decibelsToGain(static_cast<float>(*outputParam)));
 
-    // --- RMS detector at oversampled rate (Task 003) ---
-    rmsDetector.prepare(static_cast<float>(oversampledRate), calibration.rms);
-    rmsDetector.reset();
-    currentEnvelope = 0.0f;
+    // --- Calibration prepared at oversampled rate (Task 007b); later profiles are hot-swapped ---
+    {
+        const juce::ScopedLock calibrationScope(calibrationLock);
+        calibrationRate = static_cast<float>(oversampledRate);
+        publishCalibration();
+    }
 
-    // --- Per-channel pipelines at oversampled rate (Task 006b/006c/007b) ---
+    activeCalibration = calibrationExchange.acquire();
+
+    // --- RMS detector and per-channel pipelines at oversampled rate (Task 003/006b/006c) ---
     const auto focusMode = static_cast<GrainDSP::FocusMode>(focusParam->getIndex());
     lastFocusMode = focusMode;
-    pipelineLeft.prepare(static_cast<float>(oversampledRate), focusMode, calibration);
+    adoptCalibration(*activeCalibration, focusMode);
+    rmsDetector.reset();
+    currentEnvelope = 0.0f;
     pipelineLeft.reset();
-    pipelineRight.prepare(static_cast<float>(oversampledRate), focusMode, calibration);
     pipelineRight.reset();
 
-    // --- Pre-allocate dry buffer (avoid real-time allocation) ---
+    // --- Pre-allocate dry buffer (avoid real-time allocation), delayed by the reported latency ---
     dryBuffer.setSize(getTotalNumInputChannels(), samplesPerBlock);
+    dryDelay.prepare(getTotalNumInputChannels(), getLatencySamples(), samplesPerBlock);
+
+    // --- Oversampler history for state snapshots ---
+    const int historyChannels = std::min(getTotalNumInputChannels(), GrainDSP::ProcessorState::kMaxChannels);
+    inputHistory.setSize(historyChannels, GrainDSP::ProcessorState::kHistorySamples);
+    wetHistory.setSize(historyChannels, GrainDSP::ProcessorState::kHistorySamples
+                                            * static_cast<int>(oversampling->getOversamplingFactor()));
+    inputHistory.clear();
+    wetHistory.clear();
+    inputHistoryPos = 0;
+    wetHistoryPos = 0;
+
+    // --- Meter aggregation window (subscriber rate → samples) ---
+    meterHub.prepare(sampleRate);
+    harmonicAnalyzer.prepare(sampleRate);
+
+    // --- Loudness meters at original rate ---
+    inputLoudness.prepare(sampleRate);
+    outputLoudness.prepare(sampleRate);
+
+    // --- True-peak interpolators at original rate (measure the final output) ---
+    for (auto& detector : truePeakDetectors)
+    {
+        detector.prepare(samplesPerBlock);
+        detector.reset();
+    }
 }
 
 void GRAINAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    const juce::ScopedLock calibrationScope(calibrationLock);
+    calibrationExchange.collectGarbage();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -239,11 +307,32 @@ void GRAINAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
         player->getNextAudioBlock(channelInfo);
     }
 
+    // Meters: one atomic mask read per block, only subscribed meters are computed
+    const auto meterMask = meterHub.getActiveMask();
+    const int numMeterChannels = std::min(buffer.getNumChannels(), MeterHub::kMaxChannels);
+
     // Measure input levels for GUI meters (Task 008) — before input gain
-    inputLevelL.store(buffer.getMagnitude(0, 0, buffer.getNumSamples()));
-    if (buffer.getNumChannels() > 1)
+    if ((meterMask & MeterHub::kInputPeak) != 0)
     {
-        inputLevelR.store(buffer.getMagnitude(1, 0, buffer.getNumSamples()));
+        for (int ch = 0; ch < numMeterChannels; ++ch)
+        {
+            meterHub.accumulatePeak(MeterHub::Point::kInput, ch, buffer.getMagnitude(ch, 0, buffer.getNumSamples()));
+        }
+    }
+
+    // Loudness: needed for display subscribers and for auto-gain
+    const bool measureLoudness = (meterMask & MeterHub::kLoudness) != 0 || autoGainParam->get();
+    const float* const loudnessRight = buffer.getNumChannels() > 1 ? buffer.getReadPointer(1) : nullptr;
+
+    if (measureLoudness)
+    {
+        if (meterHub.takeIntegratedLoudnessResetRequest())
+        {
+            inputLoudness.resetIntegrated();
+            outputLoudness.resetIntegrated();
+        }
+
+        inputLoudness.process(buffer.getReadPointer(0), loudnessRight, buffer.getNumSamples());
     }
 
     updateParameterTargets();
@@ -264,20 +353,97 @@ void GRAINAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
         dryBuffer.copyFrom(ch, 0, buffer, ch, 0, buffer.getNumSamples());
     }
 
+    // Recorder taps (GT-20): decided once per block, so every tap file receives the same blocks
+    auto* recorder = audioRecorder.load();
+    const bool recordBlock = recorder != nullptr && recorder->isRecording();
+
     // Upsample → wet DSP → downsample
     juce::dsp::AudioBlock<float> block(buffer);
     auto oversampledBlock = oversampling->processSamplesUp(block);
     processWetOversampled(oversampledBlock);
+
+    // Snapshot history: what went into the oversampler and what came back to it (see restoreState())
+    for (int ch = 0; ch < inputHistory.getNumChannels(); ++ch)
+    {
+        appendToHistory(inputHistory, inputHistoryPos, ch, dryBuffer.getReadPointer(ch), buffer.getNumSamples());
+        appendToHistory(wetHistory, wetHistoryPos, ch, oversampledBlock.getChannelPointer(static_cast<size_t>(ch)),
+                        static_cast<int>(oversampledBlock.getNumSamples()));
+    }
+
+    inputHistoryPos = advanceHistory(inputHistory, inputHistoryPos, buffer.getNumSamples());
+    wetHistoryPos = advanceHistory(wetHistory, wetHistoryPos, static_cast<int>(oversampledBlock.getNumSamples()));
+
     oversampling->processSamplesDown(block);
 
+    // Wet-only tap: the mix below overwrites the buffer
+    if (recordBlock)
+    {
+        recorder->pushSamples(AudioRecorder::Tap::wet, buffer, buffer.getNumSamples());
+    }
+
+    // Dynamic Bias envelope for the UI — one relaxed store, only while someone is watching
+    if (meterMask != MeterHub::kNone)
+    {
+        envelopePublished.store(currentEnvelope, std::memory_order_relaxed);
+    }
+
+    // The wet is late by the oversampler latency: delay the dry to match, so partial mixes don't comb filter
+    // and a bypassed output is the input delayed by exactly the reported latency
+    for (int ch = 0; ch < dryBuffer.getNumChannels(); ++ch)
+    {
+        dryDelay.process(ch, dryBuffer.getWritePointer(ch), buffer.getNumSamples());
+    }
+
+    // Dry tap after the delay: sample-aligned with the wet and output taps, which carry the same latency
+    if (recordBlock)
+    {
+        recorder->pushSamples(AudioRecorder::Tap::dry, dryBuffer, buffer.getNumSamples());
+    }
+
     // Linear stages at original rate
     applyMixAndGain(buffer);
 
     // Measure output levels for GUI meters (Task 008)
-    outputLevelL.store(buffer.getMagnitude(0, 0, buffer.getNumSamples()));
-    if (buffer.getNumChannels() > 1)
+    if ((meterMask & MeterHub::kOutputPeak) != 0)
+    {
+        for (int ch = 0; ch < numMeterChannels; ++ch)
+        {
+            meterHub.accumulatePeak(MeterHub::Point::kOutput, ch, buffer.getMagnitude(ch, 0, buffer.getNumSamples()));
+        }
+    }
+
+    // True peak of the final output: one block pass per channel while the buffer is still cache-hot
+    if ((meterMask & MeterHub::kTruePeak) != 0)
+    {
+        for (int ch = 0; ch < numMeterChannels; ++ch)
+        {
+            const float truePeak = truePeakDetectors[static_cast<size_t>(ch)].processBlock(buffer.getReadPointer(ch),
+                                                                                          buffer.getNumSamples());
+            meterHub.accumulatePeak(MeterHub::Point::kOutputTruePeak, ch, truePeak);
+        }
+    }
+
+    // Both loudness meters see the same block sizes, so their 100 ms blocks complete together
+    if (measureLoudness && outputLoudness.process(buffer.getReadPointer(0), loudnessRight, buffer.getNumSamples()))
+    {
+        meterHub.publishLoudness(MeterHub::Point::kInput,
+                                 {inputLoudness.getMomentaryLufs(), inputLoudness.getShortTermLufs(),
+                                  inputLoudness.getIntegratedLufs()});
+        meterHub.publishLoudness(MeterHub::Point::kOutput,
+                                 {outputLoudness.getMomentaryLufs(), outputLoudness.getShortTermLufs(),
+                                  outputLoudness.getIntegratedLufs()});
+        updateAutoGainTrim();
+    }
+
+    // Harmonic analysis: left-channel dry/output snapshot, one copy per signal (analysis runs elsewhere)
+    if ((meterMask & MeterHub::kAnalysis) != 0 && buffer.getNumChannels() > 0)
     {
-        outputLevelR.store(buffer.getMagnitude(1, 0, buffer.getNumSamples()));
+        harmonicAnalyzer.pushSamples(dryBuffer.getReadPointer(0), buffer.getReadPointer(0), buffer.getNumSamples());
+    }
+
+    if (meterMask != MeterHub::kNone)
+    {
+        meterHub.endBlock(buffer.getNumSamples());
     }
 
     // Push processed output to waveform display (GT-18)
@@ -293,8 +459,7 @@ void GRAINAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     }
 
     // Push processed output to recorder (GT-20)
-    auto* recorder = audioRecorder.load();
-    if (recorder != nullptr && recorder->isRecording())
+    if (recordBlock)
     {
         recorder->pushSamples(buffer, buffer.getNumSamples());
     }
@@ -307,14 +472,13 @@ void GRAINAudioProcessor::updateParameterTargets()
     const bool bypass = bypassParam->get();
     const float targetMix = bypass ? 0.0f : static_cast<float>(*mixParam);
 
-    // Check if focus mode changed — use oversampled rate for coefficients
+    // New calibration or focus mode: copy precalculated coefficients (no math on this thread)
+    const auto* newestCalibration = calibrationExchange.acquire();
     const auto currentFocus = static_cast<GrainDSP::FocusMode>(focusParam->getIndex());
-    if (currentFocus != lastFocusMode)
+    if (newestCalibration != activeCalibration || currentFocus != lastFocusMode)
     {
-        const auto oversampledRate =
-            static_cast<float>(getSampleRate() * static_cast<double>(oversampling->getOversamplingFactor()));
-        pipelineLeft.setFocusMode(oversampledRate, currentFocus);
-        pipelineRight.setFocusMode(oversampledRate, currentFocus);
+        activeCalibration = newestCalibration;
+        adoptCalibration(*activeCalibration, currentFocus);
         lastFocusMode = currentFocus;
     }
 
@@ -324,7 +488,15 @@ void GRAINAudioProcessor::updateParameterTargets()
 
     // Mix/gain/inputGain targets (smoothed at original rate)
     mixSmoothed.setTargetValue(targetMix);
-    gainSmoothed.setTargetValue(juce::Decibels::decibelsToGain(static_cast<float>(*outputParam)));
+
+    // Auto-gain trim rides on top of the user's output gain; turning it off drops the trim
+    if (!autoGainParam->get())
+    {
+        autoGainTrimDb = 0.0f;
+        autoGainTrimDbPublished.store(0.0f, std::memory_order_relaxed);
+    }
+
+    gainSmoothed.setTargetValue(juce::Decibels::decibelsToGain(static_cast<float>(*outputParam) + autoGainTrimDb));
     inputGainSmoothed.setTargetValue(juce::Decibels::decibelsToGain(static_cast<float>(*inputGainParam)));
 }
 
@@ -394,6 +566,32 @@ void GRAINAudioProcessor::applyMixAndGain(juce::AudioBuffer<float>& buffer)
     }
 }
 
+//==============================================================================
+void GRAINAudioProcessor::updateAutoGainTrim()
+{
+    if (!autoGainParam->get())
+    {
+        return;
+    }
+
+    // Compare 3 s short-term loudness; hold the trim while either side is silent (gated)
+    const float inputLufs = inputLoudness.getShortTermLufs();
+    const float outputLufs = outputLoudness.getShortTermLufs();
+    const auto gate = static_cast<float>(GrainDSP::LoudnessMeter::kAbsoluteGateLufs);
+
+    if (inputLufs < gate || outputLufs < gate)
+    {
+        return;
+    }
+
+    // Target: output = input loudness + the user's output gain. Input loudness is measured before Input Gain,
+    // so the trim cancels every level change between the two meters (Input Gain, drive, warmth, focus and mix);
+    // only Output Gain passes through
+    const float error = inputLufs + static_cast<float>(*outputParam) - outputLufs;
+    autoGainTrimDb = juce::jlimit(-kAutoGainMaxTrimDb, kAutoGainMaxTrimDb, autoGainTrimDb + kAutoGainRate * error);
+    autoGainTrimDbPublished.store(autoGainTrimDb, std::memory_order_relaxed);
+}
+
 //==============================================================================
 bool GRAINAudioProcessor::hasEditor() const
 {
@@ -408,15 +606,20 @@ juce::AudioProcessorEditor* GRAINAudioProcessor::createEditor()
 //==============================================================================
 void GRAINAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    // Save parameter state
-    auto state = apvts.copyState();
-    const std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    // Save parameter state (compact binary; see ParameterStateCodec)
+    ParameterStateCodec::write(getParameters(), destData);
 }
 
 void GRAINAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
     // Restore parameter state
+    if (ParameterStateCodec::isBinaryState(data, sizeInBytes))
+    {
+        ParameterStateCodec::read(getParameters(), data, sizeInBytes);
+        return;
+    }
+
+    // Sessions saved before the binary format hold the APVTS state as XML
     std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
     if (xmlState != nullptr && xmlState->hasTagName(apvts.state.getType()))
     {
@@ -424,6 +627,52 @@ void GRAINAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
     }
 }
 
+//==============================================================================
+void GRAINAudioProcessor::setCalibration(const GrainDSP::CalibrationConfig& config)
+{
+    const juce::ScopedLock calibrationScope(calibrationLock);
+    calibration = config;
+    publishCalibration();
+}
+
+GrainDSP::CalibrationConfig GRAINAudioProcessor::getCalibration() const
+{
+    const juce::ScopedLock calibrationScope(calibrationLock);
+    return calibration;
+}
+
+bool GRAINAudioProcessor::loadCalibrationProfile(const juce::File& file, juce::String& error)
+{
+    GrainDSP::CalibrationConfig config;
+
+    if (!CalibrationProfileFile::load(file, config, error))
+    {
+        return false;
+    }
+
+    setCalibration(config);
+    return true;
+}
+
+void GRAINAudioProcessor::publishCalibration()
+{
+    // Not prepared yet: prepareToPlay() publishes once the rate is known
+    if (calibrationRate > 0.0f)
+    {
+        calibrationExchange.publish(std::make_unique<const GrainDSP::PreparedCalibration>(
+            GrainDSP::PreparedCalibration::create(calibration, calibrationRate)));
+    }
+}
+
+void GRAINAudioProcessor::adoptCalibration(const GrainDSP::PreparedCalibration& prepared,
+                                           GrainDSP::FocusMode focusMode)
+{
+    rmsDetector.attackCoeff = prepared.rmsAttackCoeff;
+    rmsDetector.releaseCoeff = prepared.rmsReleaseCoeff;
+    pipelineLeft.setCalibration(prepared, focusMode);
+    pipelineRight.setCalibration(prepared, focusMode);
+}
+
 //==============================================================================
 void GRAINAudioProcessor::setFilePlayerSource(FilePlayerSource* source)
 {
@@ -436,6 +685,126 @@ void GRAINAudioProcessor::resetPipelines()
     pipelineRight.reset();
     rmsDetector.reset();
     currentEnvelope = 0.0f;
+    envelopePublished.store(0.0f, std::memory_order_relaxed);
+    meterHub.resetTruePeakHold();
+    meterHub.resetIntegratedLoudness();
+}
+
+//==============================================================================
+void GRAINAudioProcessor::captureState(GrainDSP::ProcessorState& state)
+{
+    const juce::ScopedLock callbackLock(getCallbackLock());
+
+    state = GrainDSP::ProcessorState{};
+    state.sampleRate = getSampleRate();
+    state.oversamplingFactor = oversampling != nullptr ? static_cast<int>(oversampling->getOversamplingFactor()) : 0;
+    state.numChannels = inputHistory.getNumChannels();
+
+    state.pipelines[0] = pipelineLeft.getState();
+    state.pipelines[1] = pipelineRight.getState();
+    state.rmsEnvelope = rmsDetector.envelope;
+    state.currentEnvelope = currentEnvelope;
+
+    state.drive = driveSmoothed;
+    state.warmth = warmthSmoothed;
+    state.mix = mixSmoothed;
+    state.gain = gainSmoothed;
+    state.inputGain = inputGainSmoothed;
+    state.autoGainTrimDb = autoGainTrimDb;
+
+    // Unroll the rings, oldest first
+    const int inputSize = inputHistory.getNumSamples();
+    const int wetSize = wetHistory.getNumSamples();
+
+    for (int ch = 0; ch < state.numChannels; ++ch)
+    {
+        auto& input = state.inputHistory[static_cast<size_t>(ch)];
+        auto& wet = state.wetHistory[static_cast<size_t>(ch)];
+
+        for (int i = 0; i < inputSize; ++i)
+        {
+            input[static_cast<size_t>(i)] = inputHistory.getSample(ch, (inputHistoryPos + i) % inputSize);
+        }
+
+        for (int i = 0; i < wetSize; ++i)
+        {
+            wet[static_cast<size_t>(i)] = wetHistory.getSample(ch, (wetHistoryPos + i) % wetSize);
+        }
+    }
+}
+
+bool GRAINAudioProcessor::restoreState(const GrainDSP::ProcessorState& state)
+{
+    const juce::ScopedLock callbackLock(getCallbackLock());
+
+    if (!state.isValid() || oversampling == nullptr || !juce::exactlyEqual(state.sampleRate, getSampleRate())
+        || state.oversamplingFactor != static_cast<int>(oversampling->getOversamplingFactor())
+        || state.numChannels != inputHistory.getNumChannels())
+    {
+        return false;
+    }
+
+    pipelineLeft.setState(state.pipelines[0]);
+    pipelineRight.setState(state.pipelines[1]);
+    rmsDetector.envelope = state.rmsEnvelope;
+    currentEnvelope = state.currentEnvelope;
+
+    driveSmoothed = state.drive;
+    warmthSmoothed = state.warmth;
+    mixSmoothed = state.mix;
+    gainSmoothed = state.gain;
+    inputGainSmoothed = state.inputGain;
+    autoGainTrimDb = state.autoGainTrimDb;
+    autoGainTrimDbPublished.store(autoGainTrimDb, std::memory_order_relaxed);
+
+    const int factor = state.oversamplingFactor;
+
+    for (int ch = 0; ch < state.numChannels; ++ch)
+    {
+        inputHistory.copyFrom(ch, 0, state.inputHistory[static_cast<size_t>(ch)].data(), inputHistory.getNumSamples());
+        wetHistory.copyFrom(ch, 0, state.wetHistory[static_cast<size_t>(ch)].data(), wetHistory.getNumSamples());
+    }
+
+    inputHistoryPos = 0;
+    wetHistoryPos = 0;
+
+    // Replay the history through a reset oversampler, in blocks it was prepared for: the up filters see the
+    // captured input, the down filters the captured wet signal, and both converge to the captured memory
+    oversampling->reset();
+
+    const int maxBlock = dryBuffer.getNumSamples();
+
+    for (int offset = 0; offset < inputHistory.getNumSamples(); offset += maxBlock)
+    {
+        const int numSamples = std::min(maxBlock, inputHistory.getNumSamples() - offset);
+
+        for (int ch = 0; ch < dryBuffer.getNumChannels(); ++ch)
+        {
+            dryBuffer.copyFrom(ch, 0, inputHistory, std::min(ch, state.numChannels - 1), offset, numSamples);
+        }
+
+        auto block = juce::dsp::AudioBlock<float>(dryBuffer).getSubBlock(0, static_cast<size_t>(numSamples));
+        auto oversampledBlock = oversampling->processSamplesUp(block);
+
+        for (int ch = 0; ch < static_cast<int>(oversampledBlock.getNumChannels()); ++ch)
+        {
+            juce::FloatVectorOperations::copy(oversampledBlock.getChannelPointer(static_cast<size_t>(ch)),
+                                              wetHistory.getReadPointer(std::min(ch, state.numChannels - 1),
+                                                                        offset * factor),
+                                              numSamples * factor);
+        }
+
+        oversampling->processSamplesDown(block);
+    }
+
+    // The dry delay line holds the newest input samples
+    for (int ch = 0; ch < dryBuffer.getNumChannels(); ++ch)
+    {
+        dryDelay.setHistory(ch, inputHistory.getReadPointer(std::min(ch, state.numChannels - 1)),
+                            inputHistory.getNumSamples());
+    }
+
+    return true;
 }
 
 void GRAINAudioProcessor::setWaveformDisplay(WaveformDisplay* display)
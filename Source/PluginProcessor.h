@@ -7,16 +7,24 @@
 
     Signal flow:
     Input → Input Gain → [Upsample] → Dynamic Bias → Waveshaper → Warmth → Focus
-          → [Downsample] → Mix (dry/wet) → DC Blocker → Output Gain
+          → [Downsample] → DC Blocker → Mix (latency-aligned dry/wet) → Output Gain (+ auto-gain trim)
 
   ==============================================================================
 */
 
 #pragma once
 
+#include "DSP/CalibrationExchange.h"
 #include "DSP/GrainDSPPipeline.h"
+#include "DSP/LatencyDelay.h"
+#include "DSP/LinearSmoother.h"
+#include "DSP/LoudnessMeter.h"
+#include "DSP/ProcessorState.h"
 #include "DSP/RMSDetector.h"
 #include "DSP/SpectralFocus.h"
+#include "DSP/TruePeakDetector.h"
+#include "Metering/HarmonicAnalyzer.h"
+#include "Metering/MeterHub.h"
 
 #include <juce_dsp/juce_dsp.h>
 
@@ -80,11 +88,17 @@ public:
     // APVTS accessor (apvts is private — use this from Editor and external code)
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
 
-    // Atomic level values for thread-safe GUI meter reads (Task 008)
-    std::atomic<float> inputLevelL{0.0f};
-    std::atomic<float> inputLevelR{0.0f};
-    std::atomic<float> outputLevelL{0.0f};
-    std::atomic<float> outputLevelR{0.0f};
+    // Meter subscriptions + published levels (editor, standalone, analyzers subscribe here)
+    MeterHub& getMeterHub() { return meterHub; }
+
+    // Harmonic analysis results (runs only while MeterHub::kAnalysis is subscribed)
+    const HarmonicAnalyzer& getHarmonicAnalyzer() const { return harmonicAnalyzer; }
+
+    /** @return Current auto-gain trim in dB (0 when auto-gain is off). Thread-safe. */
+    float getAutoGainTrimDb() const { return autoGainTrimDbPublished.load(std::memory_order_relaxed); }
+
+    /** @return Dynamic Bias envelope at the end of the last metered block. Thread-safe. */
+    float getEnvelope() const { return envelopePublished.load(std::memory_order_relaxed); }
 
     //==============================================================================
     // Standalone file player injection (GT-16)
@@ -95,7 +109,7 @@ public:
     void setFilePlayerSource(FilePlayerSource* source);
 
     /** Reset all DSP pipeline state (e.g., after seek to avoid filter artifacts).
-     *  Safe to call from the message thread. */
+     *  Also clears the true-peak max-hold. Safe to call from the message thread. */
     void resetPipelines();
 
     //==============================================================================
@@ -114,6 +128,33 @@ public:
      *  Pass nullptr to disconnect. Called from the message thread. */
     void setAudioRecorder(AudioRecorder* recorder);
 
+    //==============================================================================
+    // DSP state snapshots
+
+    /** Capture the complete processing state: filter memory, envelopes, smoothers mid-ramp
+     *  and the oversampler history. Waits for the current audio block; call between blocks. */
+    void captureState(GrainDSP::ProcessorState& state);
+
+    /** Resume from a captured state. The oversampler is rebuilt by replaying the captured
+     *  history through it (its filter memory is not accessible).
+     *  @return false (nothing changed) if the state is invalid or was captured at another
+     *          sample rate, oversampling factor or channel count. */
+    bool restoreState(const GrainDSP::ProcessorState& state);
+
+    //==============================================================================
+    // Calibration profiles
+
+    /** Swap in a calibration while playing. Coefficients are derived here, on the calling thread;
+     *  the audio thread adopts them at its next block without locking. Call off the audio thread. */
+    void setCalibration(const GrainDSP::CalibrationConfig& config);
+
+    /** @return The calibration last set (the compiled-in defaults until one is loaded) */
+    GrainDSP::CalibrationConfig getCalibration() const;
+
+    /** Load a JSON or binary profile (see CalibrationProfileFile) and swap it in.
+     *  @return false, with error set and the current calibration kept, if the file is unreadable or invalid */
+    bool loadCalibrationProfile(const juce::File& file, juce::String& error);
+
 private:
     //==============================================================================
     // Parameter state (private — access via getAPVTS())
@@ -132,10 +173,20 @@ private:
      *  @param oversampledBlock Audio block at oversampled rate (modified in-place) */
     void processWetOversampled(juce::dsp::AudioBlock<float>& oversampledBlock);
 
-    /** Apply dry/wet mix, DC blocking, and output gain at original sample rate.
+    /** Apply DC blocking (wet), dry/wet mix and output gain at original sample rate.
+     *  dryBuffer must already be delayed by the oversampler latency.
      *  @param buffer Audio buffer at original rate (modified in-place) */
     void applyMixAndGain(juce::AudioBuffer<float>& buffer);
 
+    /** Nudge the auto-gain trim towards input loudness. Called once per 100 ms loudness block. */
+    void updateAutoGainTrim();
+
+    /** Prepare the current calibration at calibrationRate and publish it. Caller holds calibrationLock. */
+    void publishCalibration();
+
+    /** Copy a prepared calibration's coefficients into the DSP modules (audio thread; keeps filter state). */
+    void adoptCalibration(const GrainDSP::PreparedCalibration& prepared, GrainDSP::FocusMode focusMode);
+
     // Parameter pointers for fast access
     std::atomic<float>* driveParam = nullptr;
     std::atomic<float>* mixParam = nullptr;
@@ -144,20 +195,27 @@ private:
     std::atomic<float>* inputGainParam = nullptr;
     juce::AudioParameterBool* bypassParam = nullptr;
     juce::AudioParameterChoice* focusParam = nullptr;
+    juce::AudioParameterBool* autoGainParam = nullptr;
 
-    // Smoothed values for click-free parameter changes
-    juce::SmoothedValue<float> driveSmoothed;
-    juce::SmoothedValue<float> mixSmoothed;
-    juce::SmoothedValue<float> gainSmoothed;
-    juce::SmoothedValue<float> warmthSmoothed;
-    juce::SmoothedValue<float> inputGainSmoothed;
+    // Smoothed values for click-free parameter changes (plain data, so snapshots resume mid-ramp)
+    GrainDSP::LinearSmoother driveSmoothed;
+    GrainDSP::LinearSmoother mixSmoothed;
+    GrainDSP::LinearSmoother gainSmoothed;
+    GrainDSP::LinearSmoother warmthSmoothed;
+    GrainDSP::LinearSmoother inputGainSmoothed;
 
     // RMS detector for Dynamic Bias (Task 003) — mono-summed, shared across channels
     GrainDSP::RMSDetector rmsDetector;
     float currentEnvelope = 0.0f;
+    std::atomic<float> envelopePublished{0.0f};  // Updated per block while any meter is subscribed
 
-    // Centralized calibration config (Task 007b)
+    // Centralized calibration config (Task 007b). Writers (setCalibration, prepareToPlay) hold
+    // calibrationLock; the audio thread only sees prepared copies through calibrationExchange
+    juce::CriticalSection calibrationLock;
     GrainDSP::CalibrationConfig calibration = GrainDSP::kDefaultCalibration;
+    float calibrationRate = 0.0f;  // Oversampled rate calibrations are prepared for (0 until prepareToPlay)
+    GrainDSP::CalibrationExchange calibrationExchange;
+    const GrainDSP::PreparedCalibration* activeCalibration = nullptr;  // Audio thread: what the modules use
 
     // Per-channel DSP pipelines (Task 006b)
     GrainDSP::DSPPipeline pipelineLeft;
@@ -170,6 +228,33 @@ private:
     std::unique_ptr<juce::dsp::Oversampling<float>> oversampling;
     int currentOversamplingOrder = 1;    // 2^1 = 2× real-time, 2^2 = 4× offline
     juce::AudioBuffer<float> dryBuffer;  // Pre-allocated dry signal copy
+    GrainDSP::LatencyDelay dryDelay;     // Aligns dryBuffer with the wet before the mix
+
+    // Oversampler input (base rate) and wet output (oversampled) history for restoreState(): rings
+    // whose write position is also the oldest sample
+    juce::AudioBuffer<float> inputHistory;
+    juce::AudioBuffer<float> wetHistory;
+    int inputHistoryPos = 0;
+    int wetHistoryPos = 0;
+
+    // Subscription-based metering — no meter work without subscribers
+    MeterHub meterHub;
+
+    // Output true-peak detectors (only run while MeterHub::kTruePeak is subscribed)
+    std::array<GrainDSP::TruePeakDetector, MeterHub::kMaxChannels> truePeakDetectors;
+
+    // Dry vs output harmonic analysis (background thread, started via MeterHub::kAnalysis)
+    HarmonicAnalyzer harmonicAnalyzer;
+
+    // BS.1770 loudness at input (before input gain) and output — run for kLoudness or auto-gain
+    GrainDSP::LoudnessMeter inputLoudness;
+    GrainDSP::LoudnessMeter outputLoudness;
+
+    // Auto-gain: slow trim added to the output gain so output loudness follows input loudness
+    static constexpr float kAutoGainRate = 0.02f;  // Fraction of the error corrected per 100 ms block
+    static constexpr float kAutoGainMaxTrimDb = 12.0f;
+    float autoGainTrimDb = 0.0f;
+    std::atomic<float> autoGainTrimDbPublished{0.0f};
 
     // Standalone file player injection (GT-16)
     std::atomic<FilePlayerSource*> filePlayerSource{nullptr};
@@ -9,17 +9,73 @@
 
 #pragma once
 
+#include "StereoDownmixReader.h"
+
 #include <JuceHeader.h>
 
 //==============================================================================
 namespace AudioFileUtils
 {
 
-/** Check if a file path has a supported audio file extension (.wav, .aiff, .aif). */
+/** Extensions of the formats the standalone player opens (lower case, with the dot). */
+inline const juce::StringArray& getSupportedExtensions()
+{
+    static const juce::StringArray extensions{".wav", ".aiff", ".aif", ".flac", ".ogg", ".mp3"};
+    return extensions;
+}
+
+/** File chooser pattern for the supported formats: "*.wav;*.aiff;...". */
+inline juce::String getSupportedWildcard()
+{
+    juce::StringArray patterns;
+
+    for (const auto& extension : getSupportedExtensions())
+    {
+        patterns.add("*" + extension);
+    }
+
+    return patterns.joinIntoString(";");
+}
+
+/** Check if a file path has a supported audio file extension (see getSupportedExtensions()). */
 inline bool isSupportedAudioFile(const juce::String& filePath)
 {
-    auto extension = juce::File(filePath).getFileExtension().toLowerCase();
-    return extension == ".wav" || extension == ".aiff" || extension == ".aif";
+    return getSupportedExtensions().contains(juce::File(filePath).getFileExtension().toLowerCase());
+}
+
+/** Open a reader for an audio file, memory-mapping it where the format allows (uncompressed WAV/AIFF):
+ *  reads are then copies out of the mapped file and seeks cost nothing. Falls back to a buffered
+ *  stream reader when the format cannot be mapped or the mapping fails (e.g. no address space).
+ *  @return nullptr if no registered format can read the file. */
+inline std::unique_ptr<juce::AudioFormatReader> createReader(juce::AudioFormatManager& formatManager,
+                                                             const juce::File& file)
+{
+    if (auto* format = formatManager.findFormatForFileExtension(file.getFileExtension()))
+    {
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+
+        if (mapped != nullptr && mapped->mapEntireFile())
+        {
+            return mapped;
+        }
+    }
+
+    return std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(file));
+}
+
+/** createReader() for the mono/stereo signal path: files with more than two channels are
+ *  folded down by a StereoDownmixReader. */
+inline std::unique_ptr<juce::AudioFormatReader> createStereoReader(juce::AudioFormatManager& formatManager,
+                                                                   const juce::File& file)
+{
+    auto reader = createReader(formatManager, file);
+
+    if (reader != nullptr && reader->numChannels > 2)
+    {
+        return std::make_unique<StereoDownmixReader>(std::move(reader));
+    }
+
+    return reader;
 }
 
 }  // namespace AudioFileUtils
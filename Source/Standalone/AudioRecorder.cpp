@@ -10,74 +10,254 @@
 #include "AudioRecorder.h"
 
 //==============================================================================
-AudioRecorder::AudioRecorder()
-{
-    writerThread.startThread(juce::Thread::Priority::normal);
-}
+AudioRecorder::AudioRecorder() : juce::Thread("GRAIN Recorder") {}
 
 AudioRecorder::~AudioRecorder()
 {
     stopRecording();
-    writerThread.stopThread(2000);
 }
 
 //==============================================================================
-bool AudioRecorder::startRecording(const juce::File& outputFile, double sampleRate, int numChannels)
+bool AudioRecorder::startRecording(const juce::File& outputFile,
+                                   double sampleRate,
+                                   int numChannels,
+                                   double headroomSeconds)
+{
+    TapFiles tapFiles;
+    tapFiles[static_cast<size_t>(Tap::output)] = outputFile;
+    return startRecording(tapFiles, sampleRate, numChannels, headroomSeconds);
+}
+
+bool AudioRecorder::startRecording(const TapFiles& tapFiles,
+                                   double sampleRate,
+                                   int numChannels,
+                                   double headroomSeconds)
 {
     // Stop any existing recording first
     stopRecording();
 
-    numRecordChannels = numChannels;
-    fifoBuffer.setSize(numChannels, kFifoSize);
-    fifoBuffer.clear();
-    fifo.reset();
+    TapStreams streams;
+    bool anyTap = false;
 
-    // Create WAV writer
-    std::unique_ptr<juce::OutputStream> outputStream = outputFile.createOutputStream();
+    for (size_t i = 0; i < tapFiles.size(); ++i)
+    {
+        if (tapFiles[i] == juce::File())
+        {
+            continue;
+        }
 
-    if (outputStream == nullptr)
+        streams[i] = tapFiles[i].createOutputStream(kStreamBufferBytes);
+        anyTap = true;
+
+        if (streams[i] == nullptr)
+        {
+            return false;
+        }
+    }
+
+    if (!anyTap || !startTaps(std::move(streams), sampleRate, numChannels, headroomSeconds))
     {
         return false;
     }
 
-    juce::WavAudioFormat wavFormat;
-    auto options =
-        juce::AudioFormatWriterOptions().withSampleRate(sampleRate).withNumChannels(numChannels).withBitsPerSample(24);
+    for (size_t i = 0; i < tapFiles.size(); ++i)
+    {
+        taps[i].file = tapFiles[i];
+    }
+
+    return true;
+}
 
-    writer = wavFormat.createWriterFor(outputStream, options);
+bool AudioRecorder::startRecording(std::unique_ptr<juce::OutputStream> outputStream,
+                                   double sampleRate,
+                                   int numChannels,
+                                   double headroomSeconds)
+{
+    stopRecording();
 
-    if (writer == nullptr)
+    if (outputStream == nullptr)
     {
         return false;
     }
 
-    currentFile = outputFile;
-    recording.store(true);
+    TapStreams streams;
+    streams[static_cast<size_t>(Tap::output)] = std::move(outputStream);
+    return startTaps(std::move(streams), sampleRate, numChannels, headroomSeconds);
+}
+
+bool AudioRecorder::startTaps(TapStreams streams, double sampleRate, int numChannels, double headroomSeconds)
+{
+    // Ring sized for the requested stall tolerance at this rate: a power of two, so a multiple of the chunk size
+    const auto headroomSamples = static_cast<int>(std::min(sampleRate * headroomSeconds, double{1 << 30}));
+    const int fifoSize = juce::nextPowerOfTwo(std::max(headroomSamples, kMinFifoSize));
+
+    numRecordChannels = numChannels;
+
+    numOverflows.store(0);
+    numDroppedSamples.store(0);
+    writeFailed.store(false);
+    lastError.clear();
+
+    // The difference is derived from the output and dry rings, so it needs both fed
+    const bool withDifference = streams[static_cast<size_t>(Tap::difference)] != nullptr;
+
+    for (size_t i = 0; i < taps.size(); ++i)
+    {
+        auto& tap = taps[i];
+        const auto tapId = static_cast<Tap>(i);
+        const bool feedsDifference = withDifference && (tapId == Tap::output || tapId == Tap::dry);
+
+        tap.fed = tapId != Tap::difference && (streams[i] != nullptr || feedsDifference);
+
+        if (tap.fed)
+        {
+            tap.fifo.setTotalSize(fifoSize);
+            tap.buffer.setSize(numChannels, fifoSize);
+            tap.buffer.clear();
+            tap.fifo.reset();
+        }
+
+        if (streams[i] == nullptr)
+        {
+            continue;
+        }
+
+        tap.writer = createWriter(streams[i], sampleRate, numChannels);
+
+        if (tap.writer == nullptr)
+        {
+            // All taps or none: a QC set with a missing file is no use
+            for (auto& other : taps)
+            {
+                other.writer.reset();
+                other.fed = false;
+            }
+
+            return false;
+        }
+    }
+
+    if (withDifference)
+    {
+        outputScratch.setSize(numChannels, kWriteChunkSamples);
+        dryScratch.setSize(numChannels, kWriteChunkSamples);
+        nullTestAnalyzer.prepare(sampleRate, numChannels, nullTestLatency);
+    }
 
-    // Register with the background thread for periodic drain
-    writerThread.addTimeSliceClient(this);
+    wakePending.store(false);
+    recording.store(true);
+    startThread(juce::Thread::Priority::high);
 
     return true;
 }
 
-void AudioRecorder::stopRecording()
+std::unique_ptr<juce::AudioFormatWriter> AudioRecorder::createWriter(std::unique_ptr<juce::OutputStream>& stream,
+                                                                     double sampleRate,
+                                                                     int numChannels) const
+{
+    auto options = juce::AudioFormatWriterOptions().withSampleRate(sampleRate).withNumChannels(numChannels);
+
+    if (format == Format::flac)
+    {
+        // FLAC is integer only: 24 bits, default compression level
+        juce::FlacAudioFormat flacFormat;
+        return flacFormat.createWriterFor(stream, options.withBitsPerSample(24));
+    }
+
+    // BWF "bext" chunk: origin and the time reference of the first sample
+    const juce::String codingHistory = "A=PCM,F=" + juce::String(juce::roundToInt(sampleRate));
+    options = options.withMetadataValues(juce::WavAudioFormat::createBWAVMetadata(
+        "GRAIN export", "GRAIN", {}, juce::Time::getCurrentTime(), 0, codingHistory));
+
+    if (format == Format::wavFloat)
+    {
+        options = options.withBitsPerSample(32).withSampleFormat(
+            juce::AudioFormatWriterOptions::SampleFormat::floatingPoint);
+    }
+    else
+    {
+        options = options.withBitsPerSample(24);
+    }
+
+    // The WAV writer reserves room for a ds64 chunk and becomes RF64 past 4 GB
+    juce::WavAudioFormat wavFormat;
+    return wavFormat.createWriterFor(stream, options);
+}
+
+bool AudioRecorder::stopRecording()
 {
     if (!recording.load())
     {
-        return;
+        return true;
     }
 
     recording.store(false);
 
-    // Unregister from background thread
-    writerThread.removeTimeSliceClient(this);
+    // Wakes the writer and waits for its current chunks
+    stopThread(2000);
+
+    // Flush any remaining samples in the FIFOs
+    drainTaps(true);
+
+    auto& difference = getTap(Tap::difference);
+
+    if (difference.writer != nullptr)
+    {
+        nullTestReport = nullTestAnalyzer.getReport();
 
-    // Flush any remaining samples in the FIFO
-    writeFromFifo();
+        if (!nullTestReport.writeTo(getNullTestReportFile(difference.file)))
+        {
+            writeFailed.store(true);
+        }
+    }
 
-    // Close the writer (finalizes WAV header)
-    writer.reset();
-    currentFile = juce::File();
+    for (auto& tap : taps)
+    {
+        // Close the writer (finalizes WAV header)
+        tap.writer.reset();
+        tap.file = juce::File();
+        tap.fed = false;
+    }
+
+    if (numDroppedSamples.load() > 0)
+    {
+        lastError = "Recording lost " + juce::String(numDroppedSamples.load()) + " samples in "
+                    + juce::String(numOverflows.load()) + " overflow(s): the disk could not keep up";
+        return false;
+    }
+
+    if (writeFailed.load())
+    {
+        lastError = "Writing the recording to disk failed";
+        return false;
+    }
+
+    return true;
+}
+
+void AudioRecorder::setFormat(Format newFormat)
+{
+    format = newFormat;
+}
+
+AudioRecorder::Format AudioRecorder::getFormat() const
+{
+    return format;
+}
+
+AudioRecorder::Format AudioRecorder::getFormatForFile(const juce::File& file, Format fallback)
+{
+    return file.hasFileExtension(".flac") ? Format::flac : fallback;
+}
+
+void AudioRecorder::setNullTestLatency(int latencySamples)
+{
+    nullTestLatency = std::max(latencySamples, 0);
+}
+
+NullTestAnalyzer::Report AudioRecorder::getNullTestReport() const
+{
+    return nullTestReport;
 }
 
 bool AudioRecorder::isRecording() const
@@ -85,17 +265,36 @@ bool AudioRecorder::isRecording() const
     return recording.load();
 }
 
+bool AudioRecorder::isTapRecording(Tap tap) const
+{
+    return recording.load() && getTap(tap).writer != nullptr;
+}
+
 //==============================================================================
 void AudioRecorder::pushSamples(const juce::AudioBuffer<float>& buffer, int numSamples)
 {
-    if (!recording.load() || writer == nullptr)
+    pushSamples(Tap::output, buffer, numSamples);
+}
+
+void AudioRecorder::pushSamples(Tap tapToPush, const juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    auto& tap = getTap(tapToPush);
+
+    if (!recording.load() || !tap.fed)
     {
         return;
     }
 
-    const int available = fifo.getFreeSpace();
+    const int available = tap.fifo.getFreeSpace();
     const int toWrite = std::min(numSamples, available);
 
+    // What does not fit is lost: count it so the recording can be reported as incomplete
+    if (toWrite < numSamples)
+    {
+        numOverflows.fetch_add(1, std::memory_order_relaxed);
+        numDroppedSamples.fetch_add(numSamples - toWrite, std::memory_order_relaxed);
+    }
+
     if (toWrite <= 0)
     {
         return;
@@ -105,7 +304,7 @@ void AudioRecorder::pushSamples(const juce::AudioBuffer<float>& buffer, int numS
     int size1 = 0;
     int start2 = 0;
     int size2 = 0;
-    fifo.prepareToWrite(toWrite, start1, size1, start2, size2);
+    tap.fifo.prepareToWrite(toWrite, start1, size1, start2, size2);
 
     const int channels = std::min(buffer.getNumChannels(), numRecordChannels);
 
@@ -114,7 +313,7 @@ void AudioRecorder::pushSamples(const juce::AudioBuffer<float>& buffer, int numS
     {
         for (int ch = 0; ch < channels; ++ch)
         {
-            fifoBuffer.copyFrom(ch, start1, buffer, ch, 0, size1);
+            tap.buffer.copyFrom(ch, start1, buffer, ch, 0, size1);
         }
     }
 
@@ -123,35 +322,190 @@ void AudioRecorder::pushSamples(const juce::AudioBuffer<float>& buffer, int numS
     {
         for (int ch = 0; ch < channels; ++ch)
         {
-            fifoBuffer.copyFrom(ch, start2, buffer, ch, size1, size2);
+            tap.buffer.copyFrom(ch, start2, buffer, ch, size1, size2);
         }
     }
 
-    fifo.finishedWrite(size1 + size2);
+    tap.fifo.finishedWrite(size1 + size2);
+
+    // One notify per chunk at most: the writer clears the flag when it wakes
+    if (tap.fifo.getNumReady() >= kWriteChunkSamples && !wakePending.exchange(true))
+    {
+        notify();
+    }
+}
+
+juce::File AudioRecorder::getRecordingFile(Tap tap) const
+{
+    return getTap(tap).file;
+}
+
+juce::File AudioRecorder::getTapFile(const juce::File& outputFile, Tap tap)
+{
+    switch (tap)
+    {
+        case Tap::dry:
+            return outputFile.getSiblingFile(outputFile.getFileNameWithoutExtension() + "_dry"
+                                             + outputFile.getFileExtension());
+        case Tap::wet:
+            return outputFile.getSiblingFile(outputFile.getFileNameWithoutExtension() + "_wet"
+                                             + outputFile.getFileExtension());
+        case Tap::difference:
+            return outputFile.getSiblingFile(outputFile.getFileNameWithoutExtension() + "_null"
+                                             + outputFile.getFileExtension());
+        case Tap::output:
+            break;
+    }
+
+    return outputFile;
 }
 
-juce::File AudioRecorder::getRecordingFile() const
+juce::File AudioRecorder::getNullTestReportFile(const juce::File& differenceFile)
 {
-    return currentFile;
+    return differenceFile.withFileExtension(".json");
 }
 
 //==============================================================================
-int AudioRecorder::useTimeSlice()
+int AudioRecorder::getNumOverflows() const
 {
-    writeFromFifo();
+    return numOverflows.load(std::memory_order_relaxed);
+}
 
-    // Return 0 = call again ASAP if there's data, otherwise wait a bit
-    return fifo.getNumReady() > 0 ? 0 : 10;
+juce::int64 AudioRecorder::getNumDroppedSamples() const
+{
+    return numDroppedSamples.load(std::memory_order_relaxed);
 }
 
-void AudioRecorder::writeFromFifo()
+int AudioRecorder::getFifoCapacity() const
 {
-    if (writer == nullptr)
+    return getTap(Tap::output).fifo.getTotalSize() - 1;
+}
+
+juce::String AudioRecorder::getLastError() const
+{
+    return lastError;
+}
+
+//==============================================================================
+void AudioRecorder::run()
+{
+    while (!threadShouldExit())
+    {
+        // No polling: an idle recorder sleeps until the next full chunk (or stopRecording())
+        wait(-1);
+        wakePending.store(false);
+
+        // Whichever tap woke us, the others are at most a block behind: drain them all
+        drainTaps(false);
+    }
+}
+
+void AudioRecorder::drainTaps(bool drainAll)
+{
+    const bool withDifference = getTap(Tap::difference).writer != nullptr;
+
+    if (withDifference)
+    {
+        writeDifference(drainAll);
+    }
+
+    for (size_t i = 0; i < taps.size(); ++i)
+    {
+        const auto tapId = static_cast<Tap>(i);
+
+        // Output and dry belong to the difference, except for leftovers of an overflow at the very end
+        if (!drainAll && withDifference && (tapId == Tap::output || tapId == Tap::dry))
+        {
+            continue;
+        }
+
+        writeFromFifo(taps[i], drainAll);
+    }
+}
+
+void AudioRecorder::writeDifference(bool drainAll)
+{
+    auto& output = getTap(Tap::output);
+    auto& dry = getTap(Tap::dry);
+    auto& difference = getTap(Tap::difference);
+
+    int numReady = std::min(output.fifo.getNumReady(), dry.fifo.getNumReady());
+
+    if (!drainAll)
+    {
+        numReady -= numReady % kWriteChunkSamples;
+    }
+
+    while (numReady > 0)
+    {
+        const int numSamples = std::min(numReady, kWriteChunkSamples);
+        readFromFifo(output, outputScratch, numSamples);
+        readFromFifo(dry, dryScratch, numSamples);
+
+        for (auto* tap : {&output, &dry})
+        {
+            const auto& scratch = tap == &output ? outputScratch : dryScratch;
+
+            if (tap->writer != nullptr && !tap->writer->writeFromAudioSampleBuffer(scratch, 0, numSamples))
+            {
+                writeFailed.store(true);
+            }
+        }
+
+        // The dry tap is already latency-aligned by the processor: output minus dry goes in place
+        for (int ch = 0; ch < numRecordChannels; ++ch)
+        {
+            juce::FloatVectorOperations::subtract(outputScratch.getWritePointer(ch), dryScratch.getReadPointer(ch),
+                                                  numSamples);
+        }
+
+        if (!difference.writer->writeFromAudioSampleBuffer(outputScratch, 0, numSamples))
+        {
+            writeFailed.store(true);
+        }
+
+        nullTestAnalyzer.process(outputScratch, numSamples);
+        numReady -= numSamples;
+    }
+}
+
+void AudioRecorder::readFromFifo(TapState& tap, juce::AudioBuffer<float>& dest, int numSamples)
+{
+    int start1 = 0;
+    int size1 = 0;
+    int start2 = 0;
+    int size2 = 0;
+    tap.fifo.prepareToRead(numSamples, start1, size1, start2, size2);
+
+    for (int ch = 0; ch < numRecordChannels; ++ch)
+    {
+        if (size1 > 0)
+        {
+            dest.copyFrom(ch, 0, tap.buffer, ch, start1, size1);
+        }
+
+        if (size2 > 0)
+        {
+            dest.copyFrom(ch, size1, tap.buffer, ch, start2, size2);
+        }
+    }
+
+    tap.fifo.finishedRead(size1 + size2);
+}
+
+void AudioRecorder::writeFromFifo(TapState& tap, bool drainAll)
+{
+    if (tap.writer == nullptr || !tap.fed)
     {
         return;
     }
 
-    const int numReady = fifo.getNumReady();
+    int numReady = tap.fifo.getNumReady();
+
+    if (!drainAll)
+    {
+        numReady -= numReady % kWriteChunkSamples;
+    }
 
     if (numReady <= 0)
     {
@@ -162,22 +516,30 @@ void AudioRecorder::writeFromFifo()
     int size1 = 0;
     int start2 = 0;
     int size2 = 0;
-    fifo.prepareToRead(numReady, start1, size1, start2, size2);
+    tap.fifo.prepareToRead(numReady, start1, size1, start2, size2);
 
     // Write first segment
     if (size1 > 0)
     {
         // Create a sub-buffer view for this segment
-        const juce::AudioBuffer<float> segment(fifoBuffer.getArrayOfWritePointers(), numRecordChannels, start1, size1);
-        writer->writeFromAudioSampleBuffer(segment, 0, size1);
+        const juce::AudioBuffer<float> segment(tap.buffer.getArrayOfWritePointers(), numRecordChannels, start1, size1);
+
+        if (!tap.writer->writeFromAudioSampleBuffer(segment, 0, size1))
+        {
+            writeFailed.store(true);
+        }
     }
 
     // Write second segment (wrap-around)
     if (size2 > 0)
     {
-        const juce::AudioBuffer<float> segment(fifoBuffer.getArrayOfWritePointers(), numRecordChannels, start2, size2);
-        writer->writeFromAudioSampleBuffer(segment, 0, size2);
+        const juce::AudioBuffer<float> segment(tap.buffer.getArrayOfWritePointers(), numRecordChannels, start2, size2);
+
+        if (!tap.writer->writeFromAudioSampleBuffer(segment, 0, size2))
+        {
+            writeFailed.store(true);
+        }
     }
 
-    fifo.finishedRead(size1 + size2);
+    tap.fifo.finishedRead(size1 + size2);
 }
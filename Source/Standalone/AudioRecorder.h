@@ -3,23 +3,59 @@
 
     AudioRecorder.h
     GRAIN — Real-time audio recorder for standalone export (GT-20).
-    Writes processed output samples to a WAV file using a background thread
-    for lock-free disk I/O from the audio thread.
+    Writes processed output samples to a WAV or FLAC file using a dedicated
+    writer thread, so the audio thread never touches the disk.
 
   ==============================================================================
 */
 
 #pragma once
 
+#include "NullTestAnalyzer.h"
+
 #include <JuceHeader.h>
 
+#include <array>
+
 //==============================================================================
 /**
- * Records audio to a WAV file in real-time from the audio thread.
+ * Records audio to WAV or FLAC files in real-time from the audio thread.
+ *
+ * Uses an AbstractFifo + a dedicated writer thread:
+ *   - Audio thread pushes samples into a ring buffer (lock-free) and wakes
+ *     the writer once per kWriteChunkSamples that become ready
+ *   - The writer sleeps until woken, then writes whole chunks. The ring is a
+ *     multiple of the chunk size, so chunks are aligned and never wrap, and
+ *     the file stream is buffered, so each chunk costs a few large writes.
+ *     The remainder is written by stopRecording().
+ *
+ * Formats (setFormat()): 24-bit or 32-bit float WAV, both carrying a BWF
+ * "bext" chunk, or 24-bit FLAC. WAV switches to RF64 by itself once the data
+ * passes the 4 GB RIFF limit (the header is rewritten on close, so the
+ * stream must be seekable — files always are). All encoding, including FLAC
+ * compression, runs on the writer thread; the audio thread only copies
+ * floats into the ring, whose headroom absorbs the slower FLAC chunks.
+ *
+ * Taps: besides the final output, the dry and wet-only signals of the same
+ * pass can be recorded for QC. Each tap has its own ring and file; the one
+ * writer thread drains them all. The processor pushes every active tap for
+ * every block, so the files are sample-aligned and of equal length. A push
+ * costs one contiguous copy per channel (two when the ring wraps).
  *
- * Uses an AbstractFifo + background TimeSliceThread for lock-free writing:
- *   - Audio thread pushes samples into a ring buffer (lock-free)
- *   - Background thread drains the ring buffer and writes to disk
+ * Null test: the difference tap is output minus dry. The processor pushes
+ * the dry tap after delaying it by its latency, the same delay it applies
+ * before its mix, so a bypassed or fully dry pass nulls and what remains is
+ * the wet share. It has no ring of its own —
+ * the writer thread drains the output and dry rings in lockstep, subtracts
+ * and writes the difference — so it costs the audio thread nothing beyond
+ * the dry push. Its peak, RMS and octave-band levels are written as JSON
+ * beside it (getNullTestReportFile()) when the recording stops.
+ *
+ * The ring holds a configurable number of seconds at the recording rate, so
+ * the disk may stall that long without loss. Audio that still does not fit is
+ * counted (getNumOverflows() / getNumDroppedSamples(), summed over all taps)
+ * and stopRecording() reports the recording as failed: a file with gaps is
+ * never passed off as complete.
  *
  * Thread safety:
  *   - startRecording() / stopRecording() must be called from the message thread.
@@ -27,65 +63,195 @@
  *   - isRecording() is thread-safe (atomic).
  *
  * Usage:
- *   1. Call startRecording(outputFile, sampleRate, numChannels)
+ *   1. Call startRecording(outputFile, sampleRate, numChannels), or the
+ *      TapFiles overload to record more than the output
  *   2. Push audio blocks via pushSamples() from processBlock
- *   3. Call stopRecording() when done — flushes and closes the file
+ *   3. Call stopRecording() when done — flushes and closes the files
  */
-class AudioRecorder : private juce::TimeSliceClient
+class AudioRecorder : private juce::Thread
 {
 public:
     //==============================================================================
+    /** Default ring buffer length: how long the writer may stall before audio is lost. */
+    static constexpr double kDefaultHeadroomSeconds = 10.0;
+
+    /** Signals that can be recorded, each to its own file. */
+    enum class Tap
+    {
+        output,      // Final processed output (mix and output gain applied)
+        dry,         // Input after input gain: the dry side of the mix
+        wet,         // Wet-only signal after downsampling, before mix and output gain
+        difference,  // Output minus latency-aligned dry, derived on the writer thread
+    };
+
+    static constexpr int kNumTaps = 4;
+
+    /** File format of the next recording. */
+    enum class Format
+    {
+        wav24,     // 24-bit integer WAV / RF64 with BWF metadata
+        wavFloat,  // 32-bit float WAV / RF64 with BWF metadata: keeps overs above 0 dBFS
+        flac,      // 24-bit FLAC, lossless and about half the size
+    };
+
+    /** Destination per tap, indexed by Tap; an empty File leaves that tap off. */
+    using TapFiles = std::array<juce::File, kNumTaps>;
+
     AudioRecorder();
     ~AudioRecorder() override;
 
     //==============================================================================
     /** Start recording to the specified WAV file.
-     *  @param outputFile   Destination file (will be created/overwritten).
-     *  @param sampleRate   Recording sample rate.
-     *  @param numChannels  Number of channels (1 or 2).
+     *  @param outputFile      Destination file (will be created/overwritten).
+     *  @param sampleRate      Recording sample rate.
+     *  @param numChannels     Number of channels (1 or 2).
+     *  @param headroomSeconds Ring buffer length in seconds at sampleRate.
      *  @return true if recording started successfully. */
-    bool startRecording(const juce::File& outputFile, double sampleRate, int numChannels);
+    bool startRecording(const juce::File& outputFile,
+                        double sampleRate,
+                        int numChannels,
+                        double headroomSeconds = kDefaultHeadroomSeconds);
+
+    /** Start recording every tap with a file to that file. See the File overload.
+     *  @return true if every requested file was created; otherwise nothing records. */
+    bool startRecording(const TapFiles& tapFiles,
+                        double sampleRate,
+                        int numChannels,
+                        double headroomSeconds = kDefaultHeadroomSeconds);
+
+    /** Start recording WAV data to a stream (takes ownership). See the File overload. */
+    bool startRecording(std::unique_ptr<juce::OutputStream> outputStream,
+                        double sampleRate,
+                        int numChannels,
+                        double headroomSeconds = kDefaultHeadroomSeconds);
+
+    /** Stop recording, flush remaining samples, and close the files.
+     *  Safe to call even if not currently recording.
+     *  @return false if audio was lost (ring overflow or failed write); see getLastError(). */
+    bool stopRecording();
+
+    /** Choose the format for the next startRecording() (the current recording is unaffected). */
+    void setFormat(Format newFormat);
 
-    /** Stop recording, flush remaining samples, and close the file.
-     *  Safe to call even if not currently recording. */
-    void stopRecording();
+    /** @return Format used by the next startRecording(). */
+    Format getFormat() const;
+
+    /** @return The format an export file's extension asks for: FLAC for ".flac", otherwise fallback. */
+    static Format getFormatForFile(const juce::File& file, Format fallback);
+
+    /** Latency the processor compensated on the dry tap, recorded in the next null-test report. */
+    void setNullTestLatency(int latencySamples);
+
+    /** @return Statistics of the last recording's difference tap (empty before one finished). */
+    NullTestAnalyzer::Report getNullTestReport() const;
 
     /** @return true if currently recording. Thread-safe. */
     bool isRecording() const;
 
+    /** @return true if the tap has a destination in the current recording. */
+    bool isTapRecording(Tap tap) const;
+
     //==============================================================================
-    /** Push processed audio samples for recording.
+    /** Push processed audio samples for recording (the output tap).
      *  Called from the audio thread. Lock-free via ring buffer.
      *  @param buffer  The audio buffer to record.
      *  @param numSamples Number of samples to write from the buffer. */
     void pushSamples(const juce::AudioBuffer<float>& buffer, int numSamples);
 
+    /** Push one block of a tap; ignored when the tap is not fed (never needed for the difference).
+     *  See the output overload. */
+    void pushSamples(Tap tap, const juce::AudioBuffer<float>& buffer, int numSamples);
+
     /** @return the file currently being recorded to (empty if not recording). */
-    juce::File getRecordingFile() const;
+    juce::File getRecordingFile(Tap tap = Tap::output) const;
+
+    /** @return Where a tap of an export to outputFile goes: "<name>_dry.<ext>" / "<name>_wet.<ext>"
+     *          beside it; the output tap is outputFile itself. */
+    static juce::File getTapFile(const juce::File& outputFile, Tap tap);
+
+    /** @return The JSON report written beside a difference file. */
+    static juce::File getNullTestReportFile(const juce::File& differenceFile);
 
-private:
     //==============================================================================
-    // TimeSliceClient — runs on background thread
-    int useTimeSlice() override;
+    /** @return Blocks that did not fit a ring since startRecording(). Thread-safe. */
+    int getNumOverflows() const;
+
+    /** @return Samples (per channel) discarded since startRecording(). Thread-safe. */
+    juce::int64 getNumDroppedSamples() const;
 
-    /** Write samples from the FIFO to the WAV file. */
-    void writeFromFifo();
+    /** @return Ring capacity in samples for the current recording (the same for every tap). */
+    int getFifoCapacity() const;
 
+    /** @return Why the last stopRecording() returned false (empty if it succeeded). */
+    juce::String getLastError() const;
+
+private:
     //==============================================================================
-    juce::TimeSliceThread writerThread{"GRAIN Recorder"};
+    static constexpr int kWriteChunkSamples = 16384;  // High-water mark and write granularity
+    static constexpr int kStreamBufferBytes = 1 << 20;
+    static constexpr int kMinFifoSize = 4 * kWriteChunkSamples;
+
+    /** Ring buffer for lock-free audio thread → disk thread, plus the writer it drains into. */
+    struct TapState
+    {
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+        juce::File file;
+        juce::AbstractFifo fifo{kMinFifoSize};
+        juce::AudioBuffer<float> buffer;
+        bool fed = false;  // The audio thread pushes into the ring (a file, or the difference needs it)
+    };
+
+    using TapStreams = std::array<std::unique_ptr<juce::OutputStream>, kNumTaps>;
+
+    /** Writer for one tap in the current format (takes the stream on success). */
+    std::unique_ptr<juce::AudioFormatWriter> createWriter(std::unique_ptr<juce::OutputStream>& stream,
+                                                          double sampleRate,
+                                                          int numChannels) const;
 
-    // Writer
-    std::unique_ptr<juce::AudioFormatWriter> writer;
-    juce::File currentFile;
+    /** Create a writer per stream and size every ring; on failure nothing records. */
+    bool startTaps(TapStreams streams, double sampleRate, int numChannels, double headroomSeconds);
 
-    // Ring buffer for lock-free audio thread → disk thread
-    static constexpr int kFifoSize = 65536;  // ~1.5s at 44100 stereo
-    juce::AbstractFifo fifo{kFifoSize};
-    juce::AudioBuffer<float> fifoBuffer;
+    TapState& getTap(Tap tap) { return taps[static_cast<size_t>(tap)]; }
+    const TapState& getTap(Tap tap) const { return taps[static_cast<size_t>(tap)]; }
+
+    // Writer thread: sleeps until pushSamples() reports a full chunk
+    void run() override;
+
+    /** Write every tap's ready samples.
+     *  @param drainAll false: whole chunks only; true: everything (final flush). */
+    void drainTaps(bool drainAll);
+
+    /** Write samples from a tap's FIFO to its file. See drainTaps(). */
+    void writeFromFifo(TapState& tap, bool drainAll);
+
+    /** Drain output and dry together, writing both and their difference. See drainTaps(). */
+    void writeDifference(bool drainAll);
+
+    /** Move numSamples from a tap's FIFO into the start of dest. */
+    void readFromFifo(TapState& tap, juce::AudioBuffer<float>& dest, int numSamples);
+
+    //==============================================================================
+    // Per-tap rings and writers; a tap without a writer is off
+    std::array<TapState, kNumTaps> taps;
     int numRecordChannels = 0;
+    Format format = Format::wav24;
+
+    // Difference tap (writer thread while recording): output/dry scratch, statistics
+    int nullTestLatency = 0;
+    juce::AudioBuffer<float> outputScratch;
+    juce::AudioBuffer<float> dryScratch;
+    NullTestAnalyzer nullTestAnalyzer;
+    NullTestAnalyzer::Report nullTestReport;
 
     // State
     std::atomic<bool> recording{false};
+    std::atomic<bool> wakePending{false};  // Set by the audio thread when it notifies, cleared by the writer
+
+    // Loss accounting: overflows from the audio thread, failed writes from the writer
+    std::atomic<int> numOverflows{0};
+    std::atomic<juce::int64> numDroppedSamples{0};
+    std::atomic<bool> writeFailed{false};
+    juce::String lastError;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioRecorder)
@@ -9,19 +9,35 @@
 
 #include "FilePlayerSource.h"
 
+#include "AudioFileUtils.h"
+
 //==============================================================================
-FilePlayerSource::FilePlayerSource()
+FilePlayerSource::FilePlayerSource(juce::File peakCacheDirectory) : peakCache(std::move(peakCacheDirectory))
 {
     formatManager.registerBasicFormats();
     backgroundThread.startThread(juce::Thread::Priority::normal);
     transportSource.addChangeListener(this);
+    thumbnailProgress.addChangeListener(this);
 }
 
 FilePlayerSource::~FilePlayerSource()
 {
+    // A finishing thumbnail slice queues a cache store on the loader pool: stop it first
+    stopThumbnail();
+
+    // Loader jobs capture this: cancel and drain them before anything goes
+    ++loadGeneration;
+    loaderPool.removeAllJobs(true, 10000);
+    cancelPendingUpdate();
+    finishedLoad.reset();
+
+    thumbnailProgress.removeChangeListener(this);
     transportSource.removeChangeListener(this);
     transportSource.setSource(nullptr);
+    bufferingSource.reset();
     readerSource.reset();
+    memorySource.reset();
+    preloadedAudio.reset();
     currentReader.reset();
     backgroundThread.stopThread(2000);
 }
@@ -29,54 +45,321 @@ FilePlayerSource::~FilePlayerSource()
 //==============================================================================
 bool FilePlayerSource::loadFile(const juce::File& file)
 {
+    cancelLoad();
     unloadFile();
 
+    return installFile(prepareFile(file, preparedSampleRate, preparedBlockSize, [](float) { return true; }));
+}
+
+void FilePlayerSource::loadFileAsync(const juce::File& file)
+{
+    const int generation = ++loadGeneration;
+    loadProgress.store(0.0f);
+    loadPending = true;
+
+    const double sampleRate = preparedSampleRate;
+    const int blockSize = preparedBlockSize;
+
+    loaderPool.addJob(
+        [this, file, generation, sampleRate, blockSize]
+        {
+            // A newer request or cancelLoad() moves the generation on: stop at the next stage
+            const auto reportProgress = [this, generation](float progress)
+            {
+                if (loadGeneration.load() != generation)
+                {
+                    return false;
+                }
+
+                loadProgress.store(progress);
+                triggerAsyncUpdate();
+                return true;
+            };
+
+            auto prepared = prepareFile(file, sampleRate, blockSize, reportProgress);
+
+            if (prepared == nullptr || loadGeneration.load() != generation)
+            {
+                return;  // Abandoned: released here, off the message thread
+            }
+
+            {
+                const juce::ScopedLock scopedLock(finishedLoadLock);
+                finishedLoad = std::move(prepared);
+                finishedLoadGeneration = generation;
+            }
+
+            triggerAsyncUpdate();
+        });
+}
+
+void FilePlayerSource::cancelLoad()
+{
+    ++loadGeneration;
+
+    if (loadPending)
+    {
+        loadPending = false;
+        listeners.call(&Listener::fileLoadFinished, false);
+    }
+}
+
+bool FilePlayerSource::waitForLoad(int timeoutMs)
+{
+    const auto deadline = juce::Time::getMillisecondCounter() + static_cast<juce::uint32>(timeoutMs);
+
+    while (loaderPool.getNumJobs() > 0)
+    {
+        if (juce::Time::getMillisecondCounter() >= deadline)
+        {
+            return false;
+        }
+
+        juce::Thread::sleep(1);
+    }
+
+    handleUpdateNowIfNeeded();
+    return !loadPending;
+}
+
+bool FilePlayerSource::isLoading() const
+{
+    return loadPending;
+}
+
+float FilePlayerSource::getLoadProgress() const
+{
+    return loadProgress.load();
+}
+
+void FilePlayerSource::handleAsyncUpdate()
+{
+    std::unique_ptr<PreparedFile> prepared;
+
+    {
+        const juce::ScopedLock scopedLock(finishedLoadLock);
+
+        if (finishedLoad != nullptr && finishedLoadGeneration == loadGeneration.load())
+        {
+            prepared = std::move(finishedLoad);
+        }
+
+        finishedLoad.reset();
+    }
+
+    if (!loadPending)
+    {
+        return;
+    }
+
+    if (prepared != nullptr)
+    {
+        loadPending = false;
+        const bool success = installFile(std::move(prepared));
+        listeners.call(&Listener::fileLoadFinished, success);
+        return;
+    }
+
+    listeners.call(&Listener::fileLoadProgress, loadProgress.load());
+}
+
+void FilePlayerSource::setPreloadBudget(juce::int64 maxBytes)
+{
+    preloadBudget.store(std::max<juce::int64>(maxBytes, 0));
+}
+
+juce::int64 FilePlayerSource::getPreloadBudget() const
+{
+    return preloadBudget.load();
+}
+
+bool FilePlayerSource::isPreloaded() const
+{
+    return memorySource != nullptr;
+}
+
+//==============================================================================
+std::unique_ptr<FilePlayerSource::PreparedFile> FilePlayerSource::prepareFile(
+    const juce::File& file, double deviceSampleRate, int blockSize, const LoadProgressCallback& reportProgress)
+{
+    auto prepared = std::make_unique<PreparedFile>();
+    prepared->file = file;
+
     if (!file.existsAsFile())
     {
-        lastError = "File not found: " + file.getFullPathName();
-        return false;
+        prepared->error = "File not found: " + file.getFullPathName();
+        return prepared;
     }
 
-    auto* reader = formatManager.createReaderFor(file);
+    prepared->reader = AudioFileUtils::createReader(formatManager, file);
 
-    if (reader == nullptr)
+    if (prepared->reader == nullptr)
     {
-        lastError = "Unsupported or invalid audio file: " + file.getFileName();
-        return false;
+        prepared->error = "Unsupported or invalid audio file: " + file.getFileName();
+        return prepared;
     }
 
-    if (reader->numChannels < 1 || reader->numChannels > 2)
+    if (prepared->reader->numChannels < 1)
     {
-        lastError = "Unsupported channel count: " + juce::String(reader->numChannels) + " (expected mono or stereo)";
-        delete reader;
-        return false;
+        prepared->error = "Unsupported channel count: " + juce::String(prepared->reader->numChannels);
+        return prepared;
+    }
+
+    if (prepared->reader->lengthInSamples <= 0)
+    {
+        prepared->error = "File contains no audio data: " + file.getFileName();
+        return prepared;
+    }
+
+    // More than two channels: played, summarised and displayed as a stereo downmix
+    prepared->numChannels = static_cast<int>(prepared->reader->numChannels);
+
+    if (prepared->numChannels > 2)
+    {
+        prepared->reader = std::make_unique<StereoDownmixReader>(std::move(prepared->reader));
+    }
+
+    auto* reader = prepared->reader.get();
+
+    if (!reportProgress(0.2f))
+    {
+        return nullptr;
     }
 
-    if (reader->lengthInSamples <= 0)
+    // Thumbnail: straight from the disk cache for a file seen before, otherwise built asynchronously
+    // from a second reader once installed. A third reader serves sample-level display reads.
+    prepared->thumbnail.reset(reader->lengthInSamples);
+    prepared->thumbnailCached = peakCache.load(file, prepared->thumbnail);
+
+    if (!prepared->thumbnailCached)
+    {
+        prepared->thumbnailReader = AudioFileUtils::createStereoReader(formatManager, file);
+    }
+
+    prepared->displayReader = AudioFileUtils::createStereoReader(formatManager, file);
+
+    if (!reportProgress(0.5f))
     {
-        lastError = "File contains no audio data: " + file.getFileName();
-        delete reader;
+        return nullptr;
+    }
+
+    // Small enough: decode everything now and play from memory
+    const juce::int64 decodedBytes =
+        reader->lengthInSamples * static_cast<juce::int64>(reader->numChannels * sizeof(float));
+
+    if (reader->lengthInSamples <= std::numeric_limits<int>::max() && decodedBytes <= preloadBudget.load())
+    {
+        if (!preloadFile(*prepared, reportProgress))
+        {
+            return nullptr;
+        }
+
+        prepared->memorySource = std::make_unique<juce::MemoryAudioSource>(*prepared->preloadedAudio, false);
+        return prepared;
+    }
+
+    prepared->readerSource = std::make_unique<juce::AudioFormatReaderSource>(reader, false);
+    prepared->bufferingSource = std::make_unique<juce::BufferingAudioSource>(
+        prepared->readerSource.get(), backgroundThread, false, kReadAheadSamples, 2);
+
+    // Fill the read-ahead buffer now, with the arguments the transport's resampler will pass on,
+    // so its prepareToPlay() at swap time finds the buffer ready instead of refilling it
+    if (deviceSampleRate > 0.0 && blockSize > 0)
+    {
+        const double ratio = reader->sampleRate / deviceSampleRate;
+        prepared->bufferingSource->prepareToPlay(juce::roundToInt(blockSize * ratio), deviceSampleRate * ratio);
+    }
+
+    if (!reportProgress(1.0f))
+    {
+        return nullptr;
+    }
+
+    return prepared;
+}
+
+bool FilePlayerSource::preloadFile(PreparedFile& prepared, const LoadProgressCallback& reportProgress)
+{
+    auto& reader = *prepared.reader;
+    const auto numSamples = static_cast<int>(reader.lengthInSamples);
+    const auto numChannels = static_cast<int>(reader.numChannels);
+    prepared.preloadedAudio = std::make_unique<juce::AudioBuffer<float>>(numChannels, numSamples);
+
+    for (int start = 0; start < numSamples; start += kPreloadChunkSamples)
+    {
+        const int count = std::min(kPreloadChunkSamples, numSamples - start);
+        reader.read(prepared.preloadedAudio.get(), start, count, start, true, true);
+
+        // Decoding is the bulk of a preloaded load: it maps to the second half of the progress
+        if (!reportProgress(0.5f + (0.5f * static_cast<float>(start + count) / static_cast<float>(numSamples))))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool FilePlayerSource::installFile(std::unique_ptr<PreparedFile> prepared)
+{
+    if (!prepared->error.isEmpty())
+    {
+        lastError = prepared->error;
         return false;
     }
 
+    stopThumbnail();
+
+    // Swapped under the transport's callback lock: the previous file plays up to this point
+    transportSource.stop();
+    juce::PositionableAudioSource* source = prepared->memorySource.get();
+
+    if (source == nullptr)
+    {
+        source = prepared->bufferingSource.get();
+    }
+
+    source->setLooping(looping.load());
+    transportSource.setSource(source, 0, nullptr, prepared->reader->sampleRate, 2);
+
+    // The previous chain is released here, once the transport has let go of it
+    bufferingSource = std::move(prepared->bufferingSource);
+    readerSource = std::move(prepared->readerSource);
+    memorySource = std::move(prepared->memorySource);
+    preloadedAudio = std::move(prepared->preloadedAudio);
+    currentReader = std::move(prepared->reader);
+
     // Cache metadata
-    fileSampleRate = reader->sampleRate;
-    fileLengthInSamples = reader->lengthInSamples;
-    fileNumChannels = static_cast<int>(reader->numChannels);
+    fileSampleRate = currentReader->sampleRate;
+    fileLengthInSamples = currentReader->lengthInSamples;
+    fileNumChannels = prepared->numChannels;
 
-    // Build source chain: reader -> readerSource -> transportSource
-    currentReader.reset(reader);
-    readerSource = std::make_unique<juce::AudioFormatReaderSource>(currentReader.get(), false);
+    thumbnail = std::move(prepared->thumbnail);
+    displayReader = std::move(prepared->displayReader);
 
-    transportSource.setSource(readerSource.get(), 32768, &backgroundThread, fileSampleRate);
+    if (prepared->thumbnailCached)
+    {
+        thumbnailSamplesReady.store(fileLengthInSamples, std::memory_order_release);
+    }
+    else
+    {
+        thumbnailSamplesReady.store(0, std::memory_order_release);
+        thumbnailDecimator.reset();
+        thumbnailReader = std::move(prepared->thumbnailReader);
+        thumbnailSourceFile = prepared->file;
 
-    // Generate thumbnail asynchronously
-    thumbnail.setSource(new juce::FileInputSource(file));
+        if (thumbnailReader != nullptr)
+        {
+            thumbnailBuffer.setSize(static_cast<int>(thumbnailReader->numChannels), kThumbnailChunkSamples);
+            backgroundThread.addTimeSliceClient(this);
+        }
+    }
 
-    loadedFile = file;
+    loadedFile = prepared->file;
     fileLoaded = true;
     lastError.clear();
 
+    listeners.call(&Listener::transportContentChanged);
     return true;
 }
 
@@ -84,15 +367,22 @@ void FilePlayerSource::unloadFile()
 {
     transportSource.stop();
     transportSource.setSource(nullptr);
+    bufferingSource.reset();
     readerSource.reset();
+    memorySource.reset();
+    preloadedAudio.reset();
     currentReader.reset();
-    thumbnail.setSource(nullptr);
+    stopThumbnail();
+    displayReader.reset();
+    thumbnail.reset(0);
 
     loadedFile = juce::File();
     fileSampleRate = 0.0;
     fileLengthInSamples = 0;
     fileNumChannels = 0;
     fileLoaded = false;
+
+    listeners.call(&Listener::transportContentChanged);
 }
 
 //==============================================================================
@@ -138,19 +428,87 @@ juce::File FilePlayerSource::getLoadedFile() const
 }
 
 //==============================================================================
-juce::AudioThumbnail& FilePlayerSource::getThumbnail()
+const GrainDSP::PeakPyramid& FilePlayerSource::getThumbnail() const
 {
     return thumbnail;
 }
 
+juce::int64 FilePlayerSource::getThumbnailSamplesReady() const
+{
+    return thumbnailSamplesReady.load(std::memory_order_acquire);
+}
+
 bool FilePlayerSource::isThumbnailReady() const
 {
-    return thumbnail.isFullyLoaded();
+    return fileLoaded && getThumbnailSamplesReady() >= fileLengthInSamples;
+}
+
+bool FilePlayerSource::readDisplaySamples(juce::int64 startSample, int numSamples, float* dest)
+{
+    if (displayReader == nullptr || numSamples <= 0)
+    {
+        return false;
+    }
+
+    // Reads past either end of the file are zero-filled by the reader
+    float* channels[] = {dest};
+    return displayReader->read(channels, 1, startSample, numSamples);
+}
+
+//==============================================================================
+void FilePlayerSource::stopThumbnail()
+{
+    // Blocks until a slice in progress has finished, so the reader can go
+    backgroundThread.removeTimeSliceClient(this);
+    thumbnailReader.reset();
+}
+
+int FilePlayerSource::useTimeSlice()
+{
+    const juce::int64 position = thumbnailSamplesReady.load(std::memory_order_relaxed);
+    const auto numSamples =
+        static_cast<int>(std::min<juce::int64>(kThumbnailChunkSamples, fileLengthInSamples - position));
+
+    if (thumbnailReader == nullptr || numSamples <= 0)
+    {
+        return -1;
+    }
+
+    thumbnailReader->read(&thumbnailBuffer, 0, numSamples, position, true, true);
+
+    // Channel 0 only, matching the wet signal captured from channel 0
+    const auto merge = [this](const GrainDSP::PeakSummary& peak) { thumbnail.merge(peak); };
+    thumbnailDecimator.process(thumbnailBuffer.getReadPointer(0), numSamples, position, merge);
+
+    const bool finished = position + numSamples >= fileLengthInSamples;
+
+    if (finished)
+    {
+        thumbnailDecimator.flush(merge);
+    }
+
+    // Buckets ending at or before this position are final from now on
+    thumbnailSamplesReady.store(position + numSamples, std::memory_order_release);
+    thumbnailProgress.sendChangeMessage();
+
+    if (finished)
+    {
+        // Complete pyramid: the next load of this file skips the scan. Writing the entry, hashing the
+        // file and evicting happen on the loader thread, since this one also feeds the read-ahead.
+        // The copy is taken here because the message thread resets the thumbnail on the next load.
+        auto pyramid = std::make_shared<const GrainDSP::PeakPyramid>(thumbnail);
+        loaderPool.addJob([this, file = thumbnailSourceFile, pyramid] { peakCache.store(file, *pyramid); });
+        return -1;
+    }
+
+    return 0;
 }
 
 //==============================================================================
 void FilePlayerSource::prepareToPlay(double deviceSampleRate, int maxBlockSize)
 {
+    preparedSampleRate = deviceSampleRate;
+    preparedBlockSize = maxBlockSize;
     transportSource.prepareToPlay(maxBlockSize, deviceSampleRate);
 }
 
@@ -193,6 +551,11 @@ void FilePlayerSource::setLooping(bool shouldLoop)
     {
         readerSource->setLooping(shouldLoop);
     }
+
+    if (memorySource != nullptr)
+    {
+        memorySource->setLooping(shouldLoop);
+    }
 }
 
 bool FilePlayerSource::isLooping() const
@@ -214,6 +577,7 @@ void FilePlayerSource::seekToPosition(double positionSeconds)
 
     const double clampedPosition = juce::jlimit(0.0, getFileDurationSeconds(), positionSeconds);
     transportSource.setPosition(clampedPosition);
+    listeners.call(&Listener::transportContentChanged);
 }
 
 double FilePlayerSource::getCurrentPosition() const
@@ -259,4 +623,8 @@ void FilePlayerSource::changeListenerCallback(juce::ChangeBroadcaster* source)
 
         listeners.call(&Listener::transportStateChanged, playing);
     }
+    else if (source == &thumbnailProgress)
+    {
+        listeners.call(&Listener::transportContentChanged);
+    }
 }
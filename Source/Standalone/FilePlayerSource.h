@@ -3,34 +3,63 @@
 
     FilePlayerSource.h
     GRAIN — Standalone audio file loader and transport (GT-15, GT-16).
-    Loads WAV/AIFF files, validates format, handles sample rate mismatch,
-    generates AudioThumbnail, and provides transport controls (play/stop/loop/seek).
+    Loads WAV/AIFF/FLAC/Ogg/MP3 files (optionally on a loader thread),
+    folds multichannel files to stereo, validates format,
+    handles sample rate mismatch, builds the dry peak pyramid (thumbnail),
+    and provides transport controls (play/stop/loop/seek).
 
   ==============================================================================
 */
 
 #pragma once
 
+#include "../DSP/PeakDecimator.h"
+#include "../DSP/PeakPyramid.h"
+#include "PeakCache.h"
+
 #include <JuceHeader.h>
 
 //==============================================================================
 /**
- * Loads audio files (WAV/AIFF) and provides transport controls for playback.
+ * Loads audio files (WAV/AIFF/FLAC/Ogg/MP3) and provides transport controls for playback.
+ * Files with more than two channels are folded to stereo by a StereoDownmixReader,
+ * since the processor runs mono or stereo.
  *
  * Owns the AudioFormatManager, AudioFormatReaderSource, AudioTransportSource,
- * AudioThumbnail, and background thread. The transport methods (play/stop/loop/seek)
+ * thumbnail peak pyramid, and background thread. The transport methods (play/stop/loop/seek)
  * control playback state, and getNextAudioBlock() fills audio buffers that
  * replace device input in the processor's processBlock.
  *
+ * Files can be loaded synchronously with loadFile() or in the background with
+ * loadFileAsync(): opening, validation, the peak-cache lookup and priming the
+ * read-ahead buffer then run on a loader thread, and the finished reader chain
+ * is swapped into the transport on the message thread. The previous file keeps
+ * playing until that swap.
+ *
+ * Files whose decoded size fits the preload budget are decoded into RAM while
+ * loading and played from a MemoryAudioSource, so looping and seeking never
+ * touch the disk; larger files stream through the read-ahead buffer. WAV and
+ * AIFF readers are memory-mapped (AudioFileUtils::createReader()), so decoding,
+ * thumbnail scans and display reads copy straight out of the page cache.
+ * Compressed formats are decoded on the loader thread (preloaded) or the
+ * read-ahead thread (streamed), never on the audio callback.
+ *
  * Thread safety:
- *   - loadFile() / unloadFile() must be called from the message thread.
+ *   - loadFile() / loadFileAsync() / cancelLoad() / unloadFile() must be called
+ *     from the message thread; load listener callbacks arrive there too.
  *   - play() / stop() / seekToPosition() are message-thread only.
  *   - isPlaying() / isLooping() / getCurrentPosition() are thread-safe.
  *   - getNextAudioBlock() is called from the audio thread.
  *   - Metadata getters are safe after loadFile() completes.
- *   - AudioThumbnail is internally thread-safe (JUCE design).
+ *   - The thumbnail pyramid is built on the background thread in stream order;
+ *     read it on the message thread with getThumbnailSamplesReady() as the
+ *     getRange() limit.
+ *   - readDisplaySamples() is message-thread only.
  */
-class FilePlayerSource : public juce::ChangeListener
+class FilePlayerSource
+    : public juce::ChangeListener
+    , private juce::TimeSliceClient
+    , private juce::AsyncUpdater
 {
 public:
     //==============================================================================
@@ -45,20 +74,70 @@ public:
 
         /** Called when playback reaches the end (with or without loop). */
         virtual void transportReachedEnd() = 0;
+
+        /** Called when what a display shows changed without a play/stop transition:
+         *  file loaded or unloaded, seek, or new thumbnail data. */
+        virtual void transportContentChanged() {}
+
+        /** Called while loadFileAsync() works through a file.
+         *  @param progress Fraction done, 0..1. */
+        virtual void fileLoadProgress(float /*progress*/) {}
+
+        /** Called when a loadFileAsync() request ends.
+         *  @param success true if the new file was swapped in; false if it failed (see
+         *                 getLastError()) or was cancelled. The previous file stays loaded on failure. */
+        virtual void fileLoadFinished(bool /*success*/) {}
     };
 
     //==============================================================================
-    FilePlayerSource();
+    /** @param peakCacheDirectory Where finished thumbnails are cached (tests pass a temporary directory). */
+    explicit FilePlayerSource(juce::File peakCacheDirectory = PeakCache::getDefaultDirectory());
     ~FilePlayerSource() override;
 
     //==============================================================================
     // File loading (message thread only)
 
-    /** Load an audio file (WAV or AIFF).
+    /** Load an audio file (any of AudioFileUtils::getSupportedExtensions()), blocking until it is ready.
+     *  Unloads the current file first and cancels any pending loadFileAsync().
      *  @param file The audio file to load.
      *  @return true if loaded successfully, false on error. */
     bool loadFile(const juce::File& file);
 
+    /** Load an audio file on the loader thread without blocking.
+     *  The current file keeps playing until the new one is ready, then the transport switches over
+     *  (stopped, at the start). A newer request silently supersedes this one. Listeners receive
+     *  fileLoadProgress() and one fileLoadFinished() for the newest request.
+     *  @param file The audio file to load. */
+    void loadFileAsync(const juce::File& file);
+
+    /** Abandon a pending loadFileAsync() request; the current file stays loaded.
+     *  Listeners receive fileLoadFinished(false) if a request was pending. */
+    void cancelLoad();
+
+    /** Block until a pending loadFileAsync() request has been swapped in or failed
+     *  (for tests / offline use; delivers the result on the calling message thread).
+     *  @return true if no request is pending any more. */
+    bool waitForLoad(int timeoutMs);
+
+    /** @return true while a loadFileAsync() request is pending. */
+    bool isLoading() const;
+
+    /** @return Progress of the pending loadFileAsync() request, 0..1. Thread-safe. */
+    float getLoadProgress() const;
+
+    //==============================================================================
+    // Preloading
+
+    static constexpr juce::int64 kDefaultPreloadBudgetBytes = 256 * 1024 * 1024;
+
+    /** Files whose decoded float samples fit this many bytes are held in RAM; larger ones stream.
+     *  Applies to subsequent loads. 0 disables preloading. Thread-safe. */
+    void setPreloadBudget(juce::int64 maxBytes);
+    juce::int64 getPreloadBudget() const;
+
+    /** @return true if the loaded file plays from memory rather than streaming from disk. */
+    bool isPreloaded() const;
+
     /** Unload the current file and reset to empty state. */
     void unloadFile();
 
@@ -80,9 +159,23 @@ public:
     //==============================================================================
     // Thumbnail access (for waveform display)
 
-    juce::AudioThumbnail& getThumbnail();
+    /** @return Channel 0 min/max pyramid of the loaded file, filled in the background. */
+    const GrainDSP::PeakPyramid& getThumbnail() const;
+
+    /** @return Samples summarised so far; buckets ending at or before this are final. Thread-safe. */
+    juce::int64 getThumbnailSamplesReady() const;
+
+    /** @return true once the whole file is summarised. */
     bool isThumbnailReady() const;
 
+    /** Read channel 0 samples for sample-level display (zoomed in below the pyramid base).
+     *  Uses a dedicated reader, so it never disturbs playback. Message thread only.
+     *  @param startSample First sample to read.
+     *  @param numSamples  Number of samples.
+     *  @param dest        Receives numSamples samples (zero past the end of the file).
+     *  @return false if no file is loaded. */
+    bool readDisplaySamples(juce::int64 startSample, int numSamples, float* dest);
+
     //==============================================================================
     // Transport controls (message thread only, except isPlaying/isLooping/getCurrentPosition)
 
@@ -132,21 +225,108 @@ public:
 
 private:
     //==============================================================================
-    // ChangeListener callback from AudioTransportSource
+    // ChangeListener callback from AudioTransportSource and thumbnail progress
     void changeListenerCallback(juce::ChangeBroadcaster* source) override;
 
+    // AsyncUpdater: deliver load progress and install finished loads on the message thread
+    void handleAsyncUpdate() override;
+
+    /** Everything a loaded file needs, built off the message thread. */
+    struct PreparedFile
+    {
+        juce::File file;
+        juce::String error;  // Non-empty if the file was rejected
+        int numChannels = 0;  // Of the file; the readers deliver at most two
+
+        std::unique_ptr<juce::AudioFormatReader> reader;
+        std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
+        std::unique_ptr<juce::BufferingAudioSource> bufferingSource;
+        std::unique_ptr<juce::AudioBuffer<float>> preloadedAudio;
+        std::unique_ptr<juce::MemoryAudioSource> memorySource;
+        std::unique_ptr<juce::AudioFormatReader> thumbnailReader;
+        std::unique_ptr<juce::AudioFormatReader> displayReader;
+
+        GrainDSP::PeakPyramid thumbnail;
+        bool thumbnailCached = false;
+    };
+
+    /** Called between load stages with the fraction done; return false to abandon the load. */
+    using LoadProgressCallback = std::function<bool(float)>;
+
+    /** Open, validate and prepare a file. Safe on any thread: touches no playback state.
+     *  @param deviceSampleRate, blockSize Last prepareToPlay() arguments (0 skips priming).
+     *  @return nullptr if abandoned by the callback, otherwise the file (check error). */
+    std::unique_ptr<PreparedFile> prepareFile(const juce::File& file,
+                                              double deviceSampleRate,
+                                              int blockSize,
+                                              const LoadProgressCallback& reportProgress);
+
+    /** Decode the whole file into prepared->preloadedAudio in chunks.
+     *  @return false if abandoned by the callback. */
+    static bool preloadFile(PreparedFile& prepared, const LoadProgressCallback& reportProgress);
+
+    /** Swap a prepared file into the transport (message thread).
+     *  @return false (state unchanged, lastError set) if the file was rejected. */
+    bool installFile(std::unique_ptr<PreparedFile> prepared);
+
+    // TimeSliceClient: summarise the next chunk of the file into the thumbnail
+    int useTimeSlice() override;
+
+    /** Stop the thumbnail builder and release its reader (message thread). */
+    void stopThumbnail();
+
     //==============================================================================
     juce::AudioFormatManager formatManager;
     juce::TimeSliceThread backgroundThread{"GRAIN File Reader"};
 
-    // Audio source chain: reader -> readerSource -> transportSource
+    // Audio source chain: reader -> readerSource -> bufferingSource -> transportSource.
+    // The read-ahead buffer is owned here rather than by the transport so it can be primed on the loader thread.
+    static constexpr int kReadAheadSamples = 32768;
+
     std::unique_ptr<juce::AudioFormatReader> currentReader;
     std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
+    std::unique_ptr<juce::BufferingAudioSource> bufferingSource;
     juce::AudioTransportSource transportSource;
 
-    // Thumbnail for waveform display
-    juce::AudioThumbnailCache thumbnailCache{5};
-    juce::AudioThumbnail thumbnail{512, formatManager, thumbnailCache};
+    // Preloaded alternative to the streaming chain: preloadedAudio -> memorySource -> transportSource
+    static constexpr int kPreloadChunkSamples = 1 << 18;
+
+    std::atomic<juce::int64> preloadBudget{kDefaultPreloadBudgetBytes};
+    std::unique_ptr<juce::AudioBuffer<float>> preloadedAudio;
+    std::unique_ptr<juce::MemoryAudioSource> memorySource;  // Refers to preloadedAudio's channel data
+
+    // Last prepareToPlay() arguments, so the loader can prime buffers at the device rate
+    double preparedSampleRate = 0.0;
+    int preparedBlockSize = 0;
+
+    // Disk cache of finished thumbnails. Declared before loaderPool, so the pool and its store jobs go first.
+    PeakCache peakCache;
+
+    // Asynchronous loading: each request bumps the generation, which cancels older ones
+    juce::ThreadPool loaderPool{juce::ThreadPoolOptions{}.withThreadName("GRAIN File Loader").withNumberOfThreads(1)};
+    std::atomic<int> loadGeneration{0};
+    std::atomic<float> loadProgress{0.0f};
+    bool loadPending = false;  // Message thread
+
+    juce::CriticalSection finishedLoadLock;
+    std::unique_ptr<PreparedFile> finishedLoad;  // Guarded by finishedLoadLock
+    int finishedLoadGeneration = 0;              // Guarded by finishedLoadLock
+
+    // Thumbnail for waveform display: loaded from the disk cache, or built by useTimeSlice()
+    // from its own reader and then stored in the cache by a loaderPool job
+    static constexpr int kThumbnailChunkSamples = 65536;
+
+    juce::File thumbnailSourceFile;  // Background thread only while building
+
+    GrainDSP::PeakPyramid thumbnail;
+    GrainDSP::PeakDecimator thumbnailDecimator;                // Background thread only
+    std::unique_ptr<juce::AudioFormatReader> thumbnailReader;  // Background thread only while building
+    juce::AudioBuffer<float> thumbnailBuffer;
+    std::atomic<juce::int64> thumbnailSamplesReady{0};
+    juce::ChangeBroadcaster thumbnailProgress;
+
+    // Separate reader for sample-level display reads (message thread)
+    std::unique_ptr<juce::AudioFormatReader> displayReader;
 
     // Cached file metadata
     juce::File loadedFile;
@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+    NullTestAnalyzer.cpp
+    GRAIN — Null-test difference statistics implementation.
+
+  ==============================================================================
+*/
+
+#include "NullTestAnalyzer.h"
+
+namespace
+{
+constexpr std::array<float, NullTestAnalyzer::kNumBands> kBandCentresHz = {31.5f,  63.0f,   125.0f,  250.0f,  500.0f,
+                                                                          1000.0f, 2000.0f, 4000.0f, 8000.0f, 16000.0f};
+constexpr double kOctaveQ = 1.4142135623730951;
+constexpr double kMaxBandFraction = 0.45;
+
+juce::var levelToVar(float linear, float db)
+{
+    auto* object = new juce::DynamicObject();
+    object->setProperty("linear", linear);
+    object->setProperty("dBFS", db);
+    return juce::var(object);
+}
+}  // namespace
+
+//==============================================================================
+float NullTestAnalyzer::Report::getPeakDb() const
+{
+    return toDb(static_cast<double>(peak) * peak);
+}
+
+float NullTestAnalyzer::Report::getRmsDb() const
+{
+    return toDb(static_cast<double>(rms) * rms);
+}
+
+juce::String NullTestAnalyzer::Report::toJson() const
+{
+    auto* root = new juce::DynamicObject();
+    root->setProperty("sampleRate", sampleRate);
+    root->setProperty("latencySamples", latencySamples);
+    root->setProperty("numSamples", numSamples);
+    root->setProperty("peak", levelToVar(peak, getPeakDb()));
+    root->setProperty("rms", levelToVar(rms, getRmsDb()));
+
+    juce::Array<juce::var> bands;
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("centreHz", bandCentreHz[static_cast<size_t>(band)]);
+        entry->setProperty("rmsDBFS", bandRmsDb[static_cast<size_t>(band)]);
+        bands.add(juce::var(entry));
+    }
+
+    root->setProperty("octaveBands", bands);
+    return juce::JSON::toString(juce::var(root));
+}
+
+bool NullTestAnalyzer::Report::writeTo(const juce::File& file) const
+{
+    return file.replaceWithText(toJson());
+}
+
+//==============================================================================
+void NullTestAnalyzer::prepare(double sampleRate, int channels, int latencySamples)
+{
+    report = Report{};
+    report.sampleRate = sampleRate;
+    report.latencySamples = latencySamples;
+    numChannels = std::max(channels, 0);
+    sumSquares = 0.0;
+    bandSumSquares.fill(0.0);
+
+    for (const auto centreHz : kBandCentresHz)
+    {
+        if (centreHz >= sampleRate * kMaxBandFraction)
+        {
+            break;
+        }
+
+        report.bandCentreHz[static_cast<size_t>(report.numBands++)] = centreHz;
+    }
+
+    bandFilters.assign(static_cast<size_t>(report.numBands * numChannels), juce::IIRFilter());
+
+    for (int band = 0; band < report.numBands; ++band)
+    {
+        const auto coefficients =
+            juce::IIRCoefficients::makeBandPass(sampleRate, kBandCentresHz[static_cast<size_t>(band)], kOctaveQ);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            bandFilters[static_cast<size_t>(band * numChannels + ch)].setCoefficients(coefficients);
+        }
+    }
+}
+
+void NullTestAnalyzer::process(const juce::AudioBuffer<float>& difference, int numSamples)
+{
+    const int channels = std::min(difference.getNumChannels(), numChannels);
+
+    if (numSamples <= 0 || channels <= 0)
+    {
+        return;
+    }
+
+    if (scratch.size() < static_cast<size_t>(numSamples))
+    {
+        scratch.resize(static_cast<size_t>(numSamples));
+    }
+
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        const float* samples = difference.getReadPointer(ch);
+        report.peak = std::max(report.peak, difference.getMagnitude(ch, 0, numSamples));
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            sumSquares += static_cast<double>(samples[i]) * samples[i];
+        }
+
+        for (int band = 0; band < report.numBands; ++band)
+        {
+            std::copy(samples, samples + numSamples, scratch.begin());
+            bandFilters[static_cast<size_t>(band * numChannels + ch)].processSamples(scratch.data(), numSamples);
+
+            double bandSum = 0.0;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                bandSum += static_cast<double>(scratch[static_cast<size_t>(i)]) * scratch[static_cast<size_t>(i)];
+            }
+
+            bandSumSquares[static_cast<size_t>(band)] += bandSum;
+        }
+    }
+
+    report.numSamples += numSamples;
+}
+
+NullTestAnalyzer::Report NullTestAnalyzer::getReport() const
+{
+    Report result = report;
+    const double count = static_cast<double>(report.numSamples) * std::max(numChannels, 1);
+
+    if (count > 0.0)
+    {
+        result.rms = static_cast<float>(std::sqrt(sumSquares / count));
+
+        for (int band = 0; band < report.numBands; ++band)
+        {
+            result.bandRmsDb[static_cast<size_t>(band)] = toDb(bandSumSquares[static_cast<size_t>(band)] / count);
+        }
+    }
+    else
+    {
+        result.bandRmsDb.fill(kSilenceDb);
+    }
+
+    return result;
+}
+
+//==============================================================================
+float NullTestAnalyzer::toDb(double meanSquare)
+{
+    if (meanSquare <= 0.0)
+    {
+        return kSilenceDb;
+    }
+
+    return std::max(kSilenceDb, static_cast<float>(10.0 * std::log10(meanSquare)));
+}
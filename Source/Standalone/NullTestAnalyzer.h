@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    NullTestAnalyzer.h
+    GRAIN — Statistics of an export's null-test difference signal.
+    Summarises output minus latency-aligned dry as peak, RMS and energy
+    per octave band, written as a JSON report beside the difference file.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+#include <vector>
+
+//==============================================================================
+/**
+ * Accumulates peak, RMS and per-octave-band RMS of a difference signal.
+ *
+ * Bands are octaves centred 31.5 Hz … 16 kHz, measured with one band-pass
+ * biquad per band and channel (Q = sqrt 2, about an octave wide); bands
+ * whose centre is above 0.45 × the sample rate are left out. Levels are
+ * over all channels together.
+ *
+ * Not thread-safe: prepare(), process() and getReport() are called by one
+ * thread (the recorder's writer thread during an export).
+ */
+class NullTestAnalyzer
+{
+public:
+    //==============================================================================
+    static constexpr int kNumBands = 10;
+    static constexpr float kSilenceDb = -200.0f;  // Reported for an exact null
+
+    /** Summary of everything processed since prepare(). */
+    struct Report
+    {
+        double sampleRate = 0.0;
+        int latencySamples = 0;  ///< Dry delay used to align the difference
+        juce::int64 numSamples = 0;
+        float peak = 0.0f;  ///< Absolute sample peak over all channels
+        float rms = 0.0f;   ///< Over all channels and samples
+        int numBands = 0;   ///< Bands below 0.45 × sampleRate
+        std::array<float, kNumBands> bandCentreHz{};
+        std::array<float, kNumBands> bandRmsDb{};
+
+        float getPeakDb() const;
+        float getRmsDb() const;
+
+        /** @return The report as a JSON object (levels in dBFS and linear). */
+        juce::String toJson() const;
+
+        /** Write toJson() to a file. @return true on success. */
+        bool writeTo(const juce::File& file) const;
+    };
+
+    //==============================================================================
+    /** Reset all statistics and filters.
+     *  @param sampleRate     Rate of the difference signal.
+     *  @param numChannels    Channels that will be passed to process().
+     *  @param latencySamples Alignment recorded in the report. */
+    void prepare(double sampleRate, int numChannels, int latencySamples);
+
+    /** Accumulate one block of the difference signal. */
+    void process(const juce::AudioBuffer<float>& difference, int numSamples);
+
+    /** @return Summary so far. */
+    Report getReport() const;
+
+private:
+    //==============================================================================
+    static float toDb(double meanSquare);
+
+    Report report;
+    int numChannels = 0;
+    double sumSquares = 0.0;
+    std::array<double, kNumBands> bandSumSquares{};
+    std::vector<juce::IIRFilter> bandFilters;  // [band * numChannels + channel]
+    std::vector<float> scratch;
+};
@@ -0,0 +1,283 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+    GRAIN — Parallel segmented file render implementation.
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+
+#include "AudioFileUtils.h"
+
+#include <deque>
+
+namespace
+{
+/** @return true if the processor's auto-gain is on (see OfflineRenderer: it cannot be segmented). */
+bool hasAutoGainEnabled(const juce::AudioProcessor& processor)
+{
+    for (const auto* parameter : processor.getParameters())
+    {
+        const auto* withId = dynamic_cast<const juce::AudioProcessorParameterWithID*>(parameter);
+
+        if (withId != nullptr && withId->paramID == "autoGain")
+        {
+            return withId->getValue() >= 0.5f;
+        }
+    }
+
+    return false;
+}
+}  // namespace
+
+//==============================================================================
+/** One slice of the file, rendered by its own processor and reader. */
+struct OfflineRenderer::Segment
+{
+    juce::int64 start = 0;    // First file sample the segment owns
+    juce::int64 end = 0;      // One past the last owned sample
+    juce::int64 keepEnd = 0;  // end plus the crossfade overlap, clamped to the file
+    juce::int64 preRoll = 0;  // Samples rendered and discarded before start
+
+    std::unique_ptr<juce::AudioProcessor> processor;
+    std::unique_ptr<juce::AudioFormatReader> reader;
+
+    juce::AudioBuffer<float> output;  // File positions [start, keepEnd)
+    juce::WaitableEvent finished;
+    bool succeeded = false;
+};
+
+//==============================================================================
+OfflineRenderer::OfflineRenderer(ProcessorFactory factory)
+    : processorFactory(std::move(factory))
+{
+    formatManager.registerBasicFormats();
+}
+
+//==============================================================================
+bool OfflineRenderer::render(const juce::File& source, juce::AudioFormatWriter& writer, const Options& options)
+{
+    cancelled.store(false, std::memory_order_relaxed);
+    progress.store(0.0f, std::memory_order_relaxed);
+
+    const auto probe = AudioFileUtils::createStereoReader(formatManager, source);
+
+    if (probe == nullptr || probe->lengthInSamples <= 0 || processorFactory == nullptr)
+    {
+        return false;
+    }
+
+    // Also the first segment's processor: the factory's configuration decides whether the file may be split
+    auto firstProcessor = processorFactory();
+
+    if (firstProcessor == nullptr)
+    {
+        return false;
+    }
+
+    if (hasAutoGainEnabled(*firstProcessor))
+    {
+        return renderSequential(*firstProcessor, *probe, writer);
+    }
+
+    const double sampleRate = probe->sampleRate;
+    const juce::int64 totalSamples = probe->lengthInSamples;
+    const auto segmentSamples = std::clamp<juce::int64>(static_cast<juce::int64>(options.segmentSeconds * sampleRate),
+                                                        kBlockSize, kMaxSegmentSamples);
+    const auto preRollSamples = std::max<juce::int64>(0, static_cast<juce::int64>(options.preRollSeconds * sampleRate));
+    const auto crossfade = std::clamp<juce::int64>(options.crossfadeSamples, 0, segmentSamples);
+    const auto numSegments = (totalSamples + segmentSamples - 1) / segmentSamples;
+    const int numThreads = options.numThreads > 0 ? options.numThreads : juce::SystemStats::getNumCpus();
+
+    // Declared before the pool: the pool's destructor waits for jobs that still point into these segments
+    std::deque<std::unique_ptr<Segment>> inFlight;
+    juce::ThreadPool pool(juce::ThreadPoolOptions{}.withThreadName("GRAIN Render").withNumberOfThreads(numThreads));
+
+    juce::AudioBuffer<float> overlap(2, static_cast<int>(crossfade));
+    int overlapLength = 0;
+    juce::int64 nextSegment = 0;
+    juce::int64 written = 0;
+    bool succeeded = true;
+
+    while (succeeded && (nextSegment < numSegments || !inFlight.empty()))
+    {
+        // Keep every thread busy with one segment queued behind it
+        while (nextSegment < numSegments && static_cast<int>(inFlight.size()) < 2 * numThreads)
+        {
+            auto segment = std::make_unique<Segment>();
+            segment->start = nextSegment * segmentSamples;
+            segment->end = std::min(segment->start + segmentSamples, totalSamples);
+            segment->keepEnd = std::min(segment->end + crossfade, totalSamples);
+            segment->preRoll = std::min(preRollSamples, segment->start);
+            segment->processor = firstProcessor != nullptr ? std::move(firstProcessor) : processorFactory();
+            segment->reader = AudioFileUtils::createStereoReader(formatManager, source);
+
+            auto* job = segment.get();
+            inFlight.push_back(std::move(segment));
+            pool.addJob(
+                [this, job]
+                {
+                    renderSegment(*job);
+                    job->finished.signal();
+                });
+            ++nextSegment;
+        }
+
+        auto& segment = *inFlight.front();
+        segment.finished.wait(-1);
+
+        if (!segment.succeeded || cancelled.load(std::memory_order_relaxed))
+        {
+            succeeded = false;
+            break;
+        }
+
+        // Blend the previous segment's tail (fully converged) into this segment's start (least converged)
+        const int fade = std::min(overlapLength, segment.output.getNumSamples());
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            const float* previous = overlap.getReadPointer(ch);
+            float* current = segment.output.getWritePointer(ch);
+
+            for (int i = 0; i < fade; ++i)
+            {
+                const float weight = (static_cast<float>(i) + 0.5f) / static_cast<float>(fade);
+                current[i] = previous[i] + (weight * (current[i] - previous[i]));
+            }
+        }
+
+        const auto owned = static_cast<int>(segment.end - segment.start);
+
+        if (!writer.writeFromAudioSampleBuffer(segment.output, 0, owned))
+        {
+            succeeded = false;
+            break;
+        }
+
+        overlapLength = segment.output.getNumSamples() - owned;
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            overlap.copyFrom(ch, 0, segment.output, ch, owned, overlapLength);
+        }
+
+        written += owned;
+        progress.store(static_cast<float>(static_cast<double>(written) / static_cast<double>(totalSamples)),
+                       std::memory_order_relaxed);
+        inFlight.pop_front();
+    }
+
+    if (!succeeded)
+    {
+        // Running segments see the flag at their next block; queued ones return immediately
+        cancelled.store(true, std::memory_order_relaxed);
+        pool.removeAllJobs(true, -1);
+    }
+
+    return succeeded;
+}
+
+//==============================================================================
+bool OfflineRenderer::renderSequential(juce::AudioProcessor& processor, juce::AudioFormatReader& reader,
+                                       juce::AudioFormatWriter& writer)
+{
+    const juce::int64 totalSamples = reader.lengthInSamples;
+
+    return processRange(processor, reader, 0, 0, totalSamples,
+                        [this, &writer, totalSamples](const juce::AudioBuffer<float>& block, int blockOffset,
+                                                      juce::int64 position, int numSamples)
+                        {
+                            if (!writer.writeFromAudioSampleBuffer(block, blockOffset, numSamples))
+                            {
+                                return false;
+                            }
+
+                            const auto written = position + numSamples;
+                            progress.store(static_cast<float>(static_cast<double>(written)
+                                                              / static_cast<double>(totalSamples)),
+                                           std::memory_order_relaxed);
+                            return true;
+                        });
+}
+
+//==============================================================================
+void OfflineRenderer::renderSegment(Segment& segment) const
+{
+    if (segment.processor == nullptr || segment.reader == nullptr)
+    {
+        return;
+    }
+
+    segment.output.setSize(2, static_cast<int>(segment.keepEnd - segment.start));
+
+    segment.succeeded =
+        processRange(*segment.processor, *segment.reader, segment.start, segment.preRoll, segment.keepEnd,
+                     [&segment](const juce::AudioBuffer<float>& block, int blockOffset, juce::int64 position,
+                                int numSamples)
+                     {
+                         for (int ch = 0; ch < 2; ++ch)
+                         {
+                             segment.output.copyFrom(ch, static_cast<int>(position - segment.start), block, ch,
+                                                     blockOffset, numSamples);
+                         }
+
+                         return true;
+                     });
+}
+
+//==============================================================================
+bool OfflineRenderer::processRange(juce::AudioProcessor& processor, juce::AudioFormatReader& reader,
+                                   juce::int64 start, juce::int64 preRoll, juce::int64 end,
+                                   const BlockSink& sink) const
+{
+    const int numChannels = std::max(2, processor.getTotalNumOutputChannels());
+    const bool monoFile = reader.numChannels == 1;
+
+    // Export quality: non-realtime selects the higher oversampling factor
+    processor.setNonRealtime(true);
+    processor.prepareToPlay(reader.sampleRate, kBlockSize);
+
+    const auto latency = static_cast<juce::int64>(processor.getLatencySamples());
+    const juce::int64 readEnd = end + latency;
+
+    juce::AudioBuffer<float> buffer(numChannels, kBlockSize);
+    juce::MidiBuffer midi;
+
+    // Reads before start are the pre-roll; reads past the file end are zero-filled by the reader
+    for (juce::int64 position = start - preRoll; position < readEnd; position += kBlockSize)
+    {
+        if (cancelled.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        const auto numSamples = static_cast<int>(std::min<juce::int64>(kBlockSize, readEnd - position));
+
+        buffer.clear();
+        reader.read(&buffer, 0, numSamples, position, true, !monoFile);
+
+        if (monoFile)
+        {
+            buffer.copyFrom(1, 0, buffer, 0, 0, numSamples);
+        }
+
+        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+        processor.processBlock(block, midi);
+
+        // Output sample i corresponds to file position (position + i - latency); keep [start, end)
+        const juce::int64 outputStart = position - latency;
+        const juce::int64 from = std::max(outputStart, start);
+        const juce::int64 to = std::min(outputStart + numSamples, end);
+
+        if (to > from && !sink(block, static_cast<int>(from - outputStart), from, static_cast<int>(to - from)))
+        {
+            return false;
+        }
+    }
+
+    processor.releaseResources();
+    return true;
+}
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+    GRAIN — Faster-than-realtime file render, split into segments that
+    run in parallel on a thread pool and are stitched back in order.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <functional>
+
+//==============================================================================
+/**
+ * Renders a whole file through fresh processor instances, one per segment.
+ *
+ * The pipeline is stateful (RMS envelope, DC blocker, shelf filters,
+ * oversampler filters), so a segment cannot start cold at its first sample.
+ * Each segment instead starts preRollSeconds earlier and discards that
+ * output: by the segment start its state has converged onto the state a
+ * single-threaded render would have. Segments also render crossfadeSamples
+ * past their end, and that overlap is crossfaded into the next segment's
+ * start to hide whatever residual is left.
+ *
+ * The default pre-roll is set by the slowest state. The 300 ms RMS release
+ * needs ten time constants (3 s) to settle below -80 dB; the 5 Hz DC blocker
+ * (32 ms) and the oversampler's IIR half-band filters (a few ms) settle long
+ * before. With the defaults, at the 4x non-realtime oversampling every
+ * render uses, the measured seam error against a single-threaded render
+ * stays below kSeamErrorBound (see OfflineRenderTest).
+ *
+ * The auto-gain trim is not covered: it follows 3 s short-term loudness and
+ * moves 2 % of its error per 100 ms, a time constant near 5 s over a ±12 dB
+ * range, so it would need close to a minute of pre-roll per segment. A
+ * processor with auto-gain on is therefore rendered sequentially on the
+ * calling thread, one block at a time straight into the writer: the
+ * single-threaded render itself.
+ *
+ * Segments finish out of order but are written in order. At most two
+ * segments per thread are in flight and a segment owns at most
+ * kMaxSegmentSamples, so memory stays bounded for arbitrarily long files.
+ *
+ * Thread safety: render() blocks the calling thread, which also calls the
+ * processor factory. cancel() and getProgress() may be called from any thread.
+ */
+class OfflineRenderer
+{
+public:
+    //==============================================================================
+    /** Creates a configured processor (called on the thread that calls render()). */
+    using ProcessorFactory = std::function<std::unique_ptr<juce::AudioProcessor>()>;
+
+    static constexpr int kBlockSize = 4096;
+    static constexpr double kDefaultSegmentSeconds = 30.0;
+    static constexpr juce::int64 kMaxSegmentSamples = juce::int64{1} << 24;  // About 6 min at 48 kHz
+    static constexpr double kDefaultPreRollSeconds = 3.0;
+    static constexpr int kDefaultCrossfadeSamples = 256;
+    static constexpr float kSeamErrorBound = 1.0e-4f;  // -80 dBFS
+
+    struct Options
+    {
+        int numThreads = 0;                               ///< Worker threads (0 = one per CPU core)
+        double segmentSeconds = kDefaultSegmentSeconds;   ///< Length of the file each segment owns (capped)
+        double preRollSeconds = kDefaultPreRollSeconds;   ///< Discarded lead-in before each segment
+        int crossfadeSamples = kDefaultCrossfadeSamples;  ///< Overlap blended into the next segment
+    };
+
+    explicit OfflineRenderer(ProcessorFactory factory);
+
+    //==============================================================================
+    /**
+     * Render a file, latency-compensated, sample-aligned with the source.
+     * @param source Audio file to read (mono files are duplicated to stereo)
+     * @param writer Receives the stereo output in order
+     * @param options Segmenting and thread settings
+     * @return false if the file could not be read, a processor could not be
+     *         created, writing failed or the render was cancelled
+     */
+    bool render(const juce::File& source, juce::AudioFormatWriter& writer, const Options& options);
+
+    /** Stop a running render(); it returns false as soon as workers notice. */
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+
+    /** @return Fraction of the output written, 0..1. */
+    float getProgress() const { return progress.load(std::memory_order_relaxed); }
+
+private:
+    //==============================================================================
+    struct Segment;
+
+    /** Receives processed output: numSamples of block from blockOffset, which are file positions from position. */
+    using BlockSink = std::function<bool(const juce::AudioBuffer<float>& block, int blockOffset,
+                                         juce::int64 position, int numSamples)>;
+
+    /** Fill a segment's output (runs on a pool thread). */
+    void renderSegment(Segment& segment) const;
+
+    /** Render the whole file through one processor, block by block into the writer. */
+    bool renderSequential(juce::AudioProcessor& processor, juce::AudioFormatReader& reader,
+                          juce::AudioFormatWriter& writer);
+
+    /**
+     * Prepare the processor, run it from file position start - preRoll and
+     * pass the latency-compensated output for [start, end) to sink in order.
+     * @return false if cancelled or the sink returned false
+     */
+    bool processRange(juce::AudioProcessor& processor, juce::AudioFormatReader& reader, juce::int64 start,
+                      juce::int64 preRoll, juce::int64 end, const BlockSink& sink) const;
+
+    ProcessorFactory processorFactory;
+    juce::AudioFormatManager formatManager;
+
+    std::atomic<bool> cancelled{false};
+    std::atomic<float> progress{0.0f};
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderer)
+};
@@ -0,0 +1,271 @@
+/*
+  ==============================================================================
+
+    PeakCache.cpp
+    GRAIN — Persistent on-disk cache of thumbnail peaks implementation.
+
+  ==============================================================================
+*/
+
+#include "PeakCache.h"
+
+namespace
+{
+constexpr juce::uint32 kMagic = 0x4B505247;  // "GRPK"
+constexpr juce::uint32 kVersion = 1;
+constexpr int kFingerprintBlockBytes = 64 * 1024;
+const char* const kEntryPattern = "*.peaks";
+
+constexpr juce::uint64 kFnvOffset = 14695981039346656037ULL;
+constexpr juce::uint64 kFnvPrime = 1099511628211ULL;
+
+juce::uint64 fnv1a(juce::uint64 hash, const void* data, size_t numBytes)
+{
+    const auto* bytes = static_cast<const juce::uint8*>(data);
+
+    for (size_t i = 0; i < numBytes; ++i)
+    {
+        hash = (hash ^ bytes[i]) * kFnvPrime;
+    }
+
+    return hash;
+}
+
+template <typename T>
+juce::uint64 fnv1aValue(juce::uint64 hash, T value)
+{
+    return fnv1a(hash, &value, sizeof(value));
+}
+}  // namespace
+
+//==============================================================================
+PeakCache::PeakCache(juce::File cacheDirectory, juce::int64 maxBytesToUse)
+    : directory(std::move(cacheDirectory))
+    , maxBytes(maxBytesToUse)
+{
+}
+
+juce::File PeakCache::getDefaultDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("GRAIN")
+        .getChildFile("PeakCache");
+}
+
+//==============================================================================
+PeakCache::Key PeakCache::makeKey(const juce::File& audioFile)
+{
+    Key key;
+    key.path = audioFile.getFullPathName();
+    key.size = audioFile.getSize();
+    key.modificationTime = audioFile.getLastModificationTime().toMilliseconds();
+
+    // Fingerprint head, middle and tail: catches rewrites that keep size and mtime
+    juce::uint64 hash = fnv1aValue(kFnvOffset, key.size);
+    juce::FileInputStream stream(audioFile);
+
+    if (stream.openedOk())
+    {
+        juce::HeapBlock<char> block(static_cast<size_t>(kFingerprintBlockBytes));
+        const auto blockBytes = static_cast<juce::int64>(kFingerprintBlockBytes);
+        const juce::int64 offsets[] = {0, std::max<juce::int64>(0, (key.size / 2) - (blockBytes / 2)),
+                                       std::max<juce::int64>(0, key.size - blockBytes)};
+
+        for (const auto offset : offsets)
+        {
+            if (stream.setPosition(offset))
+            {
+                const int bytesRead = stream.read(block.get(), kFingerprintBlockBytes);
+                hash = fnv1a(hash, block.get(), static_cast<size_t>(std::max(0, bytesRead)));
+            }
+        }
+    }
+
+    key.contentHash = hash;
+    return key;
+}
+
+juce::File PeakCache::getEntryFile(const Key& key) const
+{
+    juce::uint64 hash = fnv1a(kFnvOffset, key.path.toRawUTF8(), key.path.getNumBytesAsUTF8());
+    hash = fnv1aValue(hash, key.size);
+    hash = fnv1aValue(hash, key.modificationTime);
+    hash = fnv1aValue(hash, key.contentHash);
+
+    return directory.getChildFile(juce::String::toHexString(static_cast<juce::int64>(hash)).paddedLeft('0', 16)
+                                  + ".peaks");
+}
+
+//==============================================================================
+bool PeakCache::load(const juce::File& audioFile, GrainDSP::PeakPyramid& pyramid)
+{
+    const juce::ScopedLock scopedLock(lock);
+
+    const Key key = makeKey(audioFile);
+    const juce::File entry = getEntryFile(key);
+    juce::FileInputStream stream(entry);
+
+    if (!stream.openedOk())
+    {
+        return false;
+    }
+
+    // Header: the stored key must match exactly, and the length must match the pyramid
+    const auto magic = static_cast<juce::uint32>(stream.readInt());
+    const auto version = static_cast<juce::uint32>(stream.readInt());
+
+    if (magic != kMagic || version != kVersion)
+    {
+        return false;
+    }
+
+    Key stored;
+    stored.path = stream.readString();
+    stored.size = stream.readInt64();
+    stored.modificationTime = stream.readInt64();
+    stored.contentHash = static_cast<juce::uint64>(stream.readInt64());
+    const juce::int64 totalSamples = stream.readInt64();
+    const juce::int64 numBuckets = stream.readInt64();
+
+    const auto expectedBuckets = static_cast<juce::int64>(pyramid.getBaseLevel().size());
+
+    if (!(stored == key) || totalSamples != pyramid.getTotalSamples() || numBuckets != expectedBuckets)
+    {
+        return false;
+    }
+
+    // Bucket payload: little-endian float min/max pairs, read in one go
+    std::vector<juce::uint32> raw(static_cast<size_t>(numBuckets) * 2);
+    const auto payloadBytes = static_cast<int>(raw.size() * sizeof(juce::uint32));
+
+    if (stream.read(raw.data(), payloadBytes) != payloadBytes)
+    {
+        return false;
+    }
+
+    std::vector<GrainDSP::PeakPyramid::Bucket> buckets(static_cast<size_t>(numBuckets));
+
+    for (size_t i = 0; i < buckets.size(); ++i)
+    {
+        const juce::uint32 minBits = juce::ByteOrder::swapIfBigEndian(raw[2 * i]);
+        const juce::uint32 maxBits = juce::ByteOrder::swapIfBigEndian(raw[2 * i + 1]);
+        std::memcpy(&buckets[i].minVal, &minBits, sizeof(float));
+        std::memcpy(&buckets[i].maxVal, &maxBits, sizeof(float));
+    }
+
+    if (!pyramid.setBaseLevel(buckets.data(), buckets.size()))
+    {
+        return false;
+    }
+
+    // Most recently used
+    entry.setLastModificationTime(juce::Time::getCurrentTime());
+    return true;
+}
+
+bool PeakCache::store(const juce::File& audioFile, const GrainDSP::PeakPyramid& pyramid)
+{
+    const juce::ScopedLock scopedLock(lock);
+
+    const auto& buckets = pyramid.getBaseLevel();
+
+    if (buckets.empty() || directory.createDirectory().failed())
+    {
+        return false;
+    }
+
+    const Key key = makeKey(audioFile);
+    const juce::File entry = getEntryFile(key);
+
+    // Written to a temporary file and moved into place, so readers never see half an entry
+    juce::TemporaryFile temp(entry);
+
+    {
+        juce::FileOutputStream stream(temp.getFile());
+
+        if (!stream.openedOk())
+        {
+            return false;
+        }
+
+        stream.writeInt(static_cast<int>(kMagic));
+        stream.writeInt(static_cast<int>(kVersion));
+        stream.writeString(key.path);
+        stream.writeInt64(key.size);
+        stream.writeInt64(key.modificationTime);
+        stream.writeInt64(static_cast<juce::int64>(key.contentHash));
+        stream.writeInt64(pyramid.getTotalSamples());
+        stream.writeInt64(static_cast<juce::int64>(buckets.size()));
+
+        for (const auto& bucket : buckets)
+        {
+            stream.writeFloat(bucket.minVal);
+            stream.writeFloat(bucket.maxVal);
+        }
+
+        stream.flush();
+
+        if (stream.getStatus().failed())
+        {
+            return false;
+        }
+    }
+
+    if (!temp.overwriteTargetFileWithTemporary())
+    {
+        return false;
+    }
+
+    evict();
+    return true;
+}
+
+//==============================================================================
+juce::int64 PeakCache::getTotalBytes() const
+{
+    juce::int64 total = 0;
+
+    for (const auto& entry : directory.findChildFiles(juce::File::findFiles, false, kEntryPattern))
+    {
+        total += entry.getSize();
+    }
+
+    return total;
+}
+
+int PeakCache::getNumEntries() const
+{
+    return directory.getNumberOfChildFiles(juce::File::findFiles, kEntryPattern);
+}
+
+void PeakCache::evict()
+{
+    auto entries = directory.findChildFiles(juce::File::findFiles, false, kEntryPattern);
+
+    juce::int64 total = 0;
+
+    for (const auto& entry : entries)
+    {
+        total += entry.getSize();
+    }
+
+    if (total <= maxBytes)
+    {
+        return;
+    }
+
+    // Oldest use first
+    std::sort(entries.begin(), entries.end(), [](const juce::File& a, const juce::File& b)
+              { return a.getLastModificationTime() < b.getLastModificationTime(); });
+
+    for (const auto& entry : entries)
+    {
+        if (total <= maxBytes)
+        {
+            break;
+        }
+
+        total -= entry.getSize();
+        entry.deleteFile();
+    }
+}
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    PeakCache.h
+    GRAIN — Persistent on-disk cache of thumbnail peaks.
+    Lets a previously seen file show its waveform immediately instead of
+    re-scanning it on every load.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../DSP/PeakPyramid.h"
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+ * Disk-backed cache of PeakPyramid base levels, one entry file per audio file.
+ *
+ * Entries are keyed by the audio file's full path, size, modification time
+ * and a content fingerprint (FNV-1a over the head, middle and tail of the
+ * file — hashing the whole file would cost as much as rebuilding the peaks).
+ * The key is also stored inside the entry and compared on load, so a name
+ * collision or a stale entry is a miss, never wrong peaks.
+ *
+ * The directory is capped at a byte budget; after each store the least
+ * recently used entries (by modification time, refreshed on every hit) are
+ * deleted until the cache fits.
+ *
+ * Thread safety: load() and store() may be called from any thread; they
+ * serialise on an internal lock.
+ */
+class PeakCache
+{
+public:
+    //==============================================================================
+    static constexpr juce::int64 kDefaultMaxBytes = 256 * 1024 * 1024;
+
+    /** @param cacheDirectory Where entries live (created on first store).
+     *  @param maxBytes       Directory size budget for LRU eviction. */
+    explicit PeakCache(juce::File cacheDirectory = getDefaultDirectory(), juce::int64 maxBytes = kDefaultMaxBytes);
+
+    /** @return <user app data>/GRAIN/PeakCache */
+    static juce::File getDefaultDirectory();
+
+    //==============================================================================
+    /** Fill the pyramid from the cached entry for audioFile.
+     *  @param audioFile The audio file the peaks describe.
+     *  @param pyramid   Must already be reset() to the file's length; untouched on a miss.
+     *  @return true on a hit. */
+    bool load(const juce::File& audioFile, GrainDSP::PeakPyramid& pyramid);
+
+    /** Write the pyramid's base level as the entry for audioFile, then evict down to the budget.
+     *  @return true if the entry was written. */
+    bool store(const juce::File& audioFile, const GrainDSP::PeakPyramid& pyramid);
+
+    /** @return Total size of all entries in bytes. */
+    juce::int64 getTotalBytes() const;
+
+    /** @return Number of entries on disk. */
+    int getNumEntries() const;
+
+private:
+    //==============================================================================
+    struct Key
+    {
+        juce::String path;
+        juce::int64 size = 0;
+        juce::int64 modificationTime = 0;
+        juce::uint64 contentHash = 0;
+
+        bool operator==(const Key& other) const
+        {
+            return path == other.path && size == other.size && modificationTime == other.modificationTime
+                   && contentHash == other.contentHash;
+        }
+    };
+
+    /** Build the key for a file (reads up to three fingerprint blocks). */
+    static Key makeKey(const juce::File& audioFile);
+
+    /** Entry file for a key: the hash of all key fields as hex. */
+    juce::File getEntryFile(const Key& key) const;
+
+    /** Delete least recently used entries until the directory fits maxBytes. */
+    void evict();
+
+    //==============================================================================
+    juce::File directory;
+    juce::int64 maxBytes;
+    juce::CriticalSection lock;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PeakCache)
+};
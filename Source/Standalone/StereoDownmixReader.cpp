@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    StereoDownmixReader.cpp
+    GRAIN — Multichannel to stereo reader implementation.
+
+  ==============================================================================
+*/
+
+#include "StereoDownmixReader.h"
+
+namespace
+{
+constexpr float kMinus3dB = 0.70710678f;
+
+using ChannelType = juce::AudioChannelSet::ChannelType;
+
+bool isLeftSide(ChannelType type)
+{
+    return type == juce::AudioChannelSet::leftCentre || type == juce::AudioChannelSet::leftSurround
+           || type == juce::AudioChannelSet::leftSurroundSide || type == juce::AudioChannelSet::leftSurroundRear
+           || type == juce::AudioChannelSet::wideLeft || type == juce::AudioChannelSet::topFrontLeft
+           || type == juce::AudioChannelSet::topRearLeft;
+}
+
+bool isRightSide(ChannelType type)
+{
+    return type == juce::AudioChannelSet::rightCentre || type == juce::AudioChannelSet::rightSurround
+           || type == juce::AudioChannelSet::rightSurroundSide || type == juce::AudioChannelSet::rightSurroundRear
+           || type == juce::AudioChannelSet::wideRight || type == juce::AudioChannelSet::topFrontRight
+           || type == juce::AudioChannelSet::topRearRight;
+}
+}  // namespace
+
+//==============================================================================
+StereoDownmixReader::StereoDownmixReader(std::unique_ptr<juce::AudioFormatReader> sourceReader)
+    : juce::AudioFormatReader(nullptr, sourceReader->getFormatName())
+    , source(std::move(sourceReader))
+{
+    sampleRate = source->sampleRate;
+    bitsPerSample = 32;
+    lengthInSamples = source->lengthInSamples;
+    numChannels = 2;
+    usesFloatingPointData = true;
+    metadataValues = source->metadataValues;
+
+    const auto sourceChannels = static_cast<int>(source->numChannels);
+    const auto layout = source->getChannelLayout();
+    leftGains.assign(static_cast<size_t>(sourceChannels), 0.0f);
+    rightGains.assign(static_cast<size_t>(sourceChannels), 0.0f);
+
+    for (int ch = 0; ch < sourceChannels; ++ch)
+    {
+        const auto index = static_cast<size_t>(ch);
+        const auto type =
+            layout.size() == sourceChannels ? layout.getTypeOfChannel(ch) : juce::AudioChannelSet::unknown;
+        const bool positioned =
+            type != juce::AudioChannelSet::unknown && type < juce::AudioChannelSet::discreteChannel0;
+
+        if (!positioned)
+        {
+            // No position: the first two are the front pair, the rest alternate sides
+            if (ch < 2)
+            {
+                (ch == 0 ? leftGains : rightGains)[index] = 1.0f;
+            }
+            else
+            {
+                ((ch % 2) == 0 ? leftGains : rightGains)[index] = kMinus3dB;
+            }
+        }
+        else if (type == juce::AudioChannelSet::left)
+        {
+            leftGains[index] = 1.0f;
+        }
+        else if (type == juce::AudioChannelSet::right)
+        {
+            rightGains[index] = 1.0f;
+        }
+        else if (isLeftSide(type))
+        {
+            leftGains[index] = kMinus3dB;
+        }
+        else if (isRightSide(type))
+        {
+            rightGains[index] = kMinus3dB;
+        }
+        else if (type != juce::AudioChannelSet::LFE && type != juce::AudioChannelSet::LFE2)
+        {
+            // Centre and any other centred channel
+            leftGains[index] = kMinus3dB;
+            rightGains[index] = kMinus3dB;
+        }
+    }
+
+    scratch.setSize(sourceChannels, kChunkSamples);
+}
+
+//==============================================================================
+bool StereoDownmixReader::readSamples(int* const* destChannels,
+                                      int numDestChannels,
+                                      int startOffsetInDestBuffer,
+                                      juce::int64 startSampleInFile,
+                                      int numSamples)
+{
+    const int sourceChannels = scratch.getNumChannels();
+    bool ok = true;
+
+    for (int done = 0; done < numSamples; done += kChunkSamples)
+    {
+        const int count = std::min(kChunkSamples, numSamples - done);
+        ok = source->read(scratch.getArrayOfWritePointers(), sourceChannels, startSampleInFile + done, count) && ok;
+
+        for (int out = 0; out < std::min(numDestChannels, 2); ++out)
+        {
+            if (destChannels[out] == nullptr)
+            {
+                continue;
+            }
+
+            // Floating-point reader: the int buffers hold floats
+            auto* dest = reinterpret_cast<float*>(destChannels[out]) + startOffsetInDestBuffer + done;
+            const auto& gains = out == 0 ? leftGains : rightGains;
+            juce::FloatVectorOperations::clear(dest, count);
+
+            for (int ch = 0; ch < sourceChannels; ++ch)
+            {
+                const float gain = gains[static_cast<size_t>(ch)];
+
+                if (gain != 0.0f)
+                {
+                    juce::FloatVectorOperations::addWithMultiply(dest, scratch.getReadPointer(ch), gain, count);
+                }
+            }
+        }
+    }
+
+    return ok;
+}
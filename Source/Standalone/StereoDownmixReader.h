@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    StereoDownmixReader.h
+    GRAIN — Presents a multichannel audio file as stereo.
+    Lets surround and multitrack files feed the mono/stereo processor and
+    every reader-based path (playback, thumbnail, preview) unchanged.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+ * AudioFormatReader that reads every channel of a source reader and folds
+ * them into two.
+ *
+ * Gains follow the source's channel layout in the spirit of ITU-R BS.775:
+ * front left/right at unity, centre and other named channels at -3 dB to
+ * their side (or both sides when centred), LFE dropped. Channels without a
+ * named position (discrete layouts) alternate left/right at -3 dB, after
+ * the first two which are taken as left and right. No normalisation is
+ * applied, so dense material can exceed full scale like any downmix.
+ *
+ * Like any AudioFormatReader, one instance must only be read by one thread
+ * at a time.
+ */
+class StereoDownmixReader : public juce::AudioFormatReader
+{
+public:
+    //==============================================================================
+    /** @param sourceReader Reader to fold down (any channel count). */
+    explicit StereoDownmixReader(std::unique_ptr<juce::AudioFormatReader> sourceReader);
+
+    /** @return Gain of a source channel into the left and right outputs. */
+    float getLeftGain(int sourceChannel) const { return leftGains[static_cast<size_t>(sourceChannel)]; }
+    float getRightGain(int sourceChannel) const { return rightGains[static_cast<size_t>(sourceChannel)]; }
+
+    //==============================================================================
+    bool readSamples(int* const* destChannels,
+                     int numDestChannels,
+                     int startOffsetInDestBuffer,
+                     juce::int64 startSampleInFile,
+                     int numSamples) override;
+
+private:
+    //==============================================================================
+    static constexpr int kChunkSamples = 4096;
+
+    std::unique_ptr<juce::AudioFormatReader> source;
+    std::vector<float> leftGains;
+    std::vector<float> rightGains;
+    juce::AudioBuffer<float> scratch;  // Source channels for one chunk
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StereoDownmixReader)
+};
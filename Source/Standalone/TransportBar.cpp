@@ -25,7 +25,17 @@ TransportBar::TransportBar(FilePlayerSource& filePlayer) : player(filePlayer)
     // Open button
     openButton.setColour(juce::TextButton::buttonColourId, GrainColours::kSurface);
     openButton.setColour(juce::TextButton::textColourOffId, GrainColours::kTransportButton);
-    openButton.onClick = [this]() { listeners.call(&Listener::openFileRequested); };
+    openButton.onClick = [this]()
+    {
+        if (player.isLoading())
+        {
+            player.cancelLoad();
+        }
+        else
+        {
+            listeners.call(&Listener::openFileRequested);
+        }
+    };
     addAndMakeVisible(openButton);
 
     // Stop button — rewinds to start
@@ -71,19 +81,26 @@ TransportBar::TransportBar(FilePlayerSource& filePlayer) : player(filePlayer)
     exportButton.onClick = [this]() { listeners.call(&Listener::exportRequested); };
     addAndMakeVisible(exportButton);
 
+    // Stems toggle — export also writes the dry, wet-only and null-test difference signals for QC
+    stemsButton.setClickingTogglesState(true);
+    stemsButton.setColour(juce::TextButton::buttonColourId, GrainColours::kSurface);
+    stemsButton.setColour(juce::TextButton::buttonOnColourId, GrainColours::kAccent);
+    stemsButton.setColour(juce::TextButton::textColourOffId, GrainColours::kTransportButton);
+    stemsButton.setColour(juce::TextButton::textColourOnId, GrainColours::kTextBright);
+    addAndMakeVisible(stemsButton);
+
     // Register as transport listener
     player.addListener(this);
 
     // Initial state
     updateButtonStates();
 
-    // Start timer for position/progress updates (30 FPS)
-    startTimerHz(30);
+    // Initial position text; afterwards refreshes follow the transport
+    refreshRegistration.wake();
 }
 
 TransportBar::~TransportBar()
 {
-    stopTimer();
     player.removeListener(this);
 }
 
@@ -147,6 +164,9 @@ void TransportBar::resized()
     controlRow.removeFromLeft(kButtonGap);
 
     exportButton.setBounds(controlRow.removeFromLeft(kButtonWidth).reduced(0, 0));
+    controlRow.removeFromLeft(kButtonGap);
+
+    stemsButton.setBounds(controlRow.removeFromLeft(kButtonWidth).reduced(0, 0));
 }
 
 void TransportBar::mouseDown(const juce::MouseEvent& event)
@@ -169,6 +189,7 @@ void TransportBar::transportStateChanged(bool /*isNowPlaying*/)
 {
     // Must be called on the message thread (JUCE ChangeListener guarantees this)
     updateButtonStates();
+    refreshRegistration.wake();
 }
 
 void TransportBar::transportReachedEnd()
@@ -176,6 +197,23 @@ void TransportBar::transportReachedEnd()
     // No specific action needed here for the UI
 }
 
+void TransportBar::transportContentChanged()
+{
+    // Seek or file load/unload moves the time display and progress bar
+    refreshRegistration.wake();
+}
+
+void TransportBar::fileLoadProgress(float /*progress*/)
+{
+    refreshRegistration.wake();
+}
+
+void TransportBar::fileLoadFinished(bool /*success*/)
+{
+    updateButtonStates();
+    refreshRegistration.wake();
+}
+
 //==============================================================================
 void TransportBar::addListener(Listener* listener)
 {
@@ -193,16 +231,26 @@ void TransportBar::updateButtonStates()
     const bool fileLoaded = player.isFileLoaded();
     const bool playing = player.isPlaying();
 
+    openButton.setButtonText(player.isLoading() ? "Cancel" : "Open");
     playPauseButton.setButtonText(playing ? "Pause" : "Play");
     playPauseButton.setEnabled(fileLoaded);
     stopButton.setEnabled(fileLoaded);
     loopButton.setEnabled(fileLoaded);
     exportButton.setEnabled(fileLoaded && !playing);
+    stemsButton.setEnabled(fileLoaded && !playing);
+}
+
+bool TransportBar::isStemExportEnabled() const
+{
+    return stemsButton.getToggleState();
 }
 
 //==============================================================================
-void TransportBar::timerCallback()
+RefreshScheduler::Mode TransportBar::refreshTick()
 {
+    const juce::String previousText = timeText;
+    const float previousProgress = progressNormalized;
+
     if (player.isFileLoaded())
     {
         const double currentPos = player.getCurrentPosition();
@@ -226,7 +274,23 @@ void TransportBar::timerCallback()
         progressNormalized = 0.0f;
     }
 
-    repaint();
+    // The current file keeps playing while the next one loads: only the text says so
+    if (player.isLoading())
+    {
+        timeText = "Loading " + juce::String(juce::roundToInt(player.getLoadProgress() * 100.0f)) + "%";
+    }
+
+    // Repaint only when something visible moved (most frames move the bar by less than a pixel)
+    const auto barWidth = static_cast<float>(getProgressBarBounds().getWidth());
+    const bool barMoved =
+        static_cast<int>(previousProgress * barWidth) != static_cast<int>(progressNormalized * barWidth);
+
+    if (barMoved || timeText != previousText)
+    {
+        repaint();
+    }
+
+    return player.isPlaying() ? RefreshScheduler::Mode::kActive : RefreshScheduler::Mode::kIdle;
 }
 
 //==============================================================================
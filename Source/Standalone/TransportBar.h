@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "../UI/RefreshScheduler.h"
 #include "FilePlayerSource.h"
 
 #include <JuceHeader.h>
@@ -20,16 +21,18 @@
  * Transport bar component for the GRAIN standalone application.
  *
  * Layout (50px height):
- *   [Open] [■] [▶/⏸] [↻] [Export]   00:12 / 01:45
+ *   [Open] [■] [▶/⏸] [↻] [Export] [Stems]   00:12 / 01:45
  *   [═══════════════●══════════════════════════]
  *
  * Connects to a FilePlayerSource for transport control and state.
- * Uses a Timer to update position display and progress bar at 30 FPS.
+ * Position display and progress bar are refreshed by the shared
+ * RefreshScheduler: every display frame while playing, otherwise only
+ * on transport/content changes, and repainted only when they change.
  */
 class TransportBar
     : public juce::Component
     , public FilePlayerSource::Listener
-    , private juce::Timer
+    , private RefreshScheduler::Client
 {
 public:
     //==============================================================================
@@ -39,7 +42,7 @@ public:
     public:
         virtual ~Listener() = default;
 
-        /** Called when the user clicks "Open" to load a file. */
+        /** Called when the user clicks "Open" to load a file (while a load is pending the button cancels it). */
         virtual void openFileRequested() = 0;
 
         /** Called when the user clicks "Stop" (rewind to start). */
@@ -62,6 +65,9 @@ public:
     // FilePlayerSource::Listener
     void transportStateChanged(bool isNowPlaying) override;
     void transportReachedEnd() override;
+    void transportContentChanged() override;
+    void fileLoadProgress(float progress) override;
+    void fileLoadFinished(bool success) override;
 
     //==============================================================================
     void addListener(Listener* listener);
@@ -71,12 +77,17 @@ public:
     /** Update button states to reflect current transport state. */
     void updateButtonStates();
 
+    /** @return true if exports should also record the dry, wet-only and null-test stems (the "Stems" toggle). */
+    bool isStemExportEnabled() const;
+
     /** Format time in seconds to MM:SS string. */
     static juce::String formatTime(double seconds);
 
 private:
     //==============================================================================
-    void timerCallback() override;
+    // RefreshScheduler::Client
+    RefreshScheduler::Mode refreshTick() override;
+    juce::Component& getRefreshComponent() override { return *this; }
 
     /** Get the progress bar bounds within the component. */
     juce::Rectangle<int> getProgressBarBounds() const;
@@ -90,6 +101,7 @@ private:
     juce::TextButton playPauseButton{"Play"};
     juce::TextButton loopButton;
     juce::TextButton exportButton{"Export"};
+    juce::TextButton stemsButton{"Stems"};
 
     // Display state
     juce::String timeText;
@@ -98,6 +110,9 @@ private:
     // Listeners
     juce::ListenerList<Listener> listeners;
 
+    // Last member: unregisters before anything refreshTick() touches is destroyed
+    RefreshScheduler::Registration refreshRegistration{*this, RefreshScheduler::Mode::kIdle};
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TransportBar)
 };
@@ -17,23 +17,29 @@ constexpr int kPadding = 4;
 constexpr float kDryAlpha = 0.35f;
 constexpr float kWetAlpha = 0.8f;
 constexpr float kCursorWidth = 2.0f;
+constexpr double kWheelZoomOctaves = 4.0;  // Zoom factor 2^(deltaY * this) per wheel step
 }  // namespace
 
 //==============================================================================
 WaveformDisplay::WaveformDisplay(FilePlayerSource& filePlayer) : player(filePlayer)
 {
-    wetFifoBuffer.resize(2048, WetSample{});
+    wetFifoBuffer.resize(static_cast<size_t>(kWetFifoPeaks));
 
     // Register as transport listener
     player.addListener(this);
+    syncWithFile();
 
-    // Start timer for FIFO drain + repaint (30 FPS)
-    startTimerHz(30);
+    // First paint; afterwards refreshes are driven by transport/content changes
+    refreshRegistration.wake();
 }
 
 WaveformDisplay::~WaveformDisplay()
 {
-    stopTimer();
+    if (wetPreview != nullptr)
+    {
+        wetPreview->onJobStarted = nullptr;
+    }
+
     player.removeListener(this);
 }
 
@@ -63,11 +69,15 @@ void WaveformDisplay::paint(juce::Graphics& g)
         return;
     }
 
-    // Draw dry waveform (from AudioThumbnail)
-    drawDryWaveform(g, bounds);
+    // Normally refreshTick() keeps the layers current; this covers a paint before the first tick
+    if (!layersMatchView())
+    {
+        rebuildLayers();
+    }
 
-    // Draw wet waveform overlay (from accumulated samples)
-    drawWetWaveform(g, bounds);
+    // Cached dry and wet layers: blitting only the clipped region keeps partial repaints cheap
+    g.drawImageAt(dryLayer, bounds.getX(), bounds.getY());
+    g.drawImageAt(wetLayer, bounds.getX(), bounds.getY());
 
     // Draw playback cursor
     drawCursor(g, bounds);
@@ -75,15 +85,8 @@ void WaveformDisplay::paint(juce::Graphics& g)
 
 void WaveformDisplay::resized()
 {
-    // Resize wet columns to match display width
-    auto bounds = getWaveformBounds();
-    int const numColumns = bounds.getWidth();
-
-    if (numColumns > 0 && static_cast<int>(wetColumns.size()) != numColumns)
-    {
-        wetColumns.resize(static_cast<size_t>(numColumns));
-        clearWetBuffer();
-    }
+    // Peaks are kept per file position, not per column: nothing to rebuild
+    refreshRegistration.wake();
 }
 
 void WaveformDisplay::mouseDown(const juce::MouseEvent& event)
@@ -98,57 +101,82 @@ void WaveformDisplay::mouseDown(const juce::MouseEvent& event)
     }
 }
 
-//==============================================================================
-void WaveformDisplay::transportStateChanged(bool /*isNowPlaying*/)
+void WaveformDisplay::mouseDoubleClick(const juce::MouseEvent& /*event*/)
 {
-    // Repaint will be triggered by timer
+    zoomToFit();
 }
 
-void WaveformDisplay::transportReachedEnd()
+void WaveformDisplay::mouseWheelMove(const juce::MouseEvent& event, const juce::MouseWheelDetails& wheel)
 {
-    // Repaint will be triggered by timer
-}
-
-//==============================================================================
-void WaveformDisplay::pushWetSamples(const float* samples, int numSamples, juce::int64 samplePosition)
-{
-    // Write to FIFO (audio thread safe)
-    const int available = wetFifo.getFreeSpace();
-    const int toWrite = std::min(numSamples, available);
+    auto bounds = getWaveformBounds();
 
-    if (toWrite <= 0)
+    if (!player.isFileLoaded() || bounds.getWidth() <= 0)
     {
         return;
     }
 
-    int start1 = 0;
-    int size1 = 0;
-    int start2 = 0;
-    int size2 = 0;
-    wetFifo.prepareToWrite(toWrite, start1, size1, start2, size2);
+    auto const range = getVisibleRange();
 
-    // Write position-tagged samples
-    for (int i = 0; i < size1; ++i)
+    if (!juce::approximatelyEqual(wheel.deltaX, 0.0f) || event.mods.isShiftDown())
     {
-        wetFifoBuffer[static_cast<size_t>(start1 + i)] = {samples[i], samplePosition + i};
+        // Horizontal (or shift) wheel scrolls by a fraction of the view
+        float const delta = juce::approximatelyEqual(wheel.deltaX, 0.0f) ? wheel.deltaY : wheel.deltaX;
+        setVisibleRange(range.getStart() - (static_cast<double>(delta) * range.getLength()), range.getLength());
+        return;
     }
 
-    for (int i = 0; i < size2; ++i)
+    // Vertical wheel zooms, keeping the sample under the pointer in place
+    auto const relative =
+        static_cast<double>(event.getPosition().getX() - bounds.getX()) / static_cast<double>(bounds.getWidth());
+    double const anchor = range.getStart() + (juce::jlimit(0.0, 1.0, relative) * range.getLength());
+    zoomAround(anchor, std::exp2(static_cast<double>(wheel.deltaY) * kWheelZoomOctaves));
+}
+
+//==============================================================================
+void WaveformDisplay::transportStateChanged(bool /*isNowPlaying*/)
+{
+    // Refresh while playing; the tick after stopping drains the FIFO and goes idle
+    refreshRegistration.wake();
+}
+
+void WaveformDisplay::transportReachedEnd()
+{
+    refreshRegistration.wake();
+}
+
+void WaveformDisplay::transportContentChanged()
+{
+    // Seek, file load/unload or thumbnail progress
+    syncWithFile();
+    refreshRegistration.wake();
+}
+
+//==============================================================================
+void WaveformDisplay::pushWetSamples(const float* samples, int numSamples, juce::int64 samplePosition)
+{
+    if (wetDecimatorResetRequested.exchange(false))
     {
-        wetFifoBuffer[static_cast<size_t>(start2 + i)] = {samples[size1 + i], samplePosition + size1 + i};
+        wetDecimator.reset();
     }
 
-    wetFifo.finishedWrite(size1 + size2);
+    // Decimate to peaks; each completed peak is one FIFO entry (dropped only if the UI stalls for seconds)
+    wetDecimator.process(samples, numSamples, samplePosition,
+                         [this](const GrainDSP::PeakSummary& peak)
+                         {
+                             if (wetFifo.getFreeSpace() > 0)
+                             {
+                                 // A single-item write always lands in the first block
+                                 const auto scope = wetFifo.write(1);
+                                 wetFifoBuffer[static_cast<size_t>(scope.startIndex1)] = peak;
+                             }
+                         });
 }
 
 void WaveformDisplay::clearWetBuffer()
 {
-    for (auto& col : wetColumns)
-    {
-        col.minVal = 0.0f;
-        col.maxVal = 0.0f;
-        col.sampleCount = 0;
-    }
+    wetPyramid.clear();
+    wetHasData = false;
+    wetDirtyColumns = {0, wetLayer.getWidth()};
 
     // Drain any pending FIFO data
     const int available = wetFifo.getNumReady();
@@ -161,11 +189,99 @@ void WaveformDisplay::clearWetBuffer()
         wetFifo.prepareToRead(available, start1, size1, start2, size2);
         wetFifo.finishedRead(size1 + size2);
     }
+
+    // The partial peak in progress belongs to the old content; preview peaks are re-applied
+    wetDecimatorResetRequested.store(true);
+    wetPreviewPeaksConsumed = 0;
+    refreshRegistration.wake();
 }
 
-bool WaveformDisplay::hasWetData() const
+void WaveformDisplay::setWetPreview(WetPreviewRenderer* renderer)
 {
-    return std::any_of(wetColumns.begin(), wetColumns.end(), [](const WetColumn& c) { return c.sampleCount > 0; });
+    if (wetPreview != nullptr)
+    {
+        wetPreview->onJobStarted = nullptr;
+    }
+
+    wetPreview = renderer;
+    wetPreviewGeneration = 0;
+    wetPreviewPeaksConsumed = 0;
+
+    if (wetPreview != nullptr)
+    {
+        wetPreview->onJobStarted = [this]() { refreshRegistration.wake(); };
+    }
+
+    refreshRegistration.wake();
+}
+
+//==============================================================================
+void WaveformDisplay::setVisibleRange(double startSample, double numSamples)
+{
+    auto const totalSamples = static_cast<double>(player.getFileLengthInSamples());
+
+    if (totalSamples <= 0.0)
+    {
+        return;
+    }
+
+    auto const width = static_cast<double>(std::max(1, getWaveformBounds().getWidth()));
+    double const minLength = std::min(totalSamples, width * kMinSamplesPerPixel);
+    double const length = juce::jlimit(minLength, totalSamples, numSamples);
+
+    if (length >= totalSamples)
+    {
+        zoomToFit();
+        return;
+    }
+
+    visibleStart = juce::jlimit(0.0, totalSamples - length, startSample);
+    visibleLength = length;
+    refreshRegistration.wake();
+}
+
+juce::Range<double> WaveformDisplay::getVisibleRange() const
+{
+    auto const totalSamples = static_cast<double>(player.getFileLengthInSamples());
+
+    if (totalSamples <= 0.0)
+    {
+        return {};
+    }
+
+    if (visibleLength <= 0.0)
+    {
+        return {0.0, totalSamples};
+    }
+
+    return {visibleStart, visibleStart + visibleLength};
+}
+
+void WaveformDisplay::zoomAround(double anchorSample, double factor)
+{
+    auto const range = getVisibleRange();
+
+    if (range.isEmpty() || factor <= 0.0)
+    {
+        return;
+    }
+
+    double const newLength = range.getLength() / factor;
+    double const anchorFraction = (anchorSample - range.getStart()) / range.getLength();
+    setVisibleRange(anchorSample - (anchorFraction * newLength), newLength);
+}
+
+void WaveformDisplay::zoomToFit()
+{
+    visibleStart = 0.0;
+    visibleLength = 0.0;
+    refreshRegistration.wake();
+}
+
+double WaveformDisplay::getSamplesPerPixel() const
+{
+    const int width = getWaveformBounds().getWidth();
+    return width > 0 ? getVisibleRange().getLength() / static_cast<double>(width) : 0.0;
 }
 
 //==============================================================================
@@ -178,14 +294,32 @@ float WaveformDisplay::pixelToNormalized(int pixelX) const
         return 0.0f;
     }
 
-    auto const relative = static_cast<float>(pixelX - bounds.getX());
-    return juce::jlimit(0.0f, 1.0f, relative / static_cast<float>(bounds.getWidth()));
+    auto const relative = juce::jlimit(
+        0.0, 1.0, static_cast<double>(pixelX - bounds.getX()) / static_cast<double>(bounds.getWidth()));
+    auto const totalSamples = static_cast<double>(player.getFileLengthInSamples());
+
+    if (totalSamples <= 0.0)
+    {
+        return static_cast<float>(relative);
+    }
+
+    auto const range = getVisibleRange();
+    return static_cast<float>((range.getStart() + (relative * range.getLength())) / totalSamples);
 }
 
 int WaveformDisplay::normalizedToPixel(float normalized) const
 {
     auto bounds = getWaveformBounds();
-    return bounds.getX() + static_cast<int>(normalized * static_cast<float>(bounds.getWidth()));
+    auto const totalSamples = static_cast<double>(player.getFileLengthInSamples());
+
+    if (totalSamples <= 0.0)
+    {
+        return bounds.getX() + static_cast<int>(normalized * static_cast<float>(bounds.getWidth()));
+    }
+
+    auto const range = getVisibleRange();
+    double const relative = ((static_cast<double>(normalized) * totalSamples) - range.getStart()) / range.getLength();
+    return bounds.getX() + static_cast<int>(relative * static_cast<double>(bounds.getWidth()));
 }
 
 juce::Rectangle<int> WaveformDisplay::getWaveformBounds() const
@@ -194,122 +328,438 @@ juce::Rectangle<int> WaveformDisplay::getWaveformBounds() const
 }
 
 //==============================================================================
-void WaveformDisplay::timerCallback()
+RefreshScheduler::Mode WaveformDisplay::refreshTick()
 {
-    if (!player.isFileLoaded())
+    // Redraw only what changed; keep refreshing only while the cursor or the wet overlay move
+    syncWithFile();
+    drainWetFifo();
+    const bool previewRendering = consumeWetPreview();
+    followCursor();
+    updateLayers();
+    updateCursor();
+
+    return player.isPlaying() || previewRendering ? RefreshScheduler::Mode::kActive : RefreshScheduler::Mode::kIdle;
+}
+
+bool WaveformDisplay::consumeWetPreview()
+{
+    if (wetPreview == nullptr)
     {
+        return false;
+    }
+
+    // A new render job replaces everything the previous one produced
+    if (wetPreview->getGeneration() != wetPreviewGeneration)
+    {
+        wetPreviewGeneration = wetPreview->getGeneration();
+        wetPreviewPeaksConsumed = 0;
+        wetPyramid.clear();
+        wetHasData = false;
+        wetDirtyColumns = {0, wetLayer.getWidth()};
+    }
+
+    // Sample the running state first, so the last peaks published before the job ends are not missed
+    const bool rendering = wetPreview->isRendering();
+    const int ready = wetPreview->getNumPeaksReady();
+
+    if (wetPyramid.getNumLevels() > 0)
+    {
+        for (; wetPreviewPeaksConsumed < ready; ++wetPreviewPeaksConsumed)
+        {
+            accumulatePeak(wetPreview->getPeak(wetPreviewPeaksConsumed));
+        }
+    }
+
+    return rendering;
+}
+
+void WaveformDisplay::drainWetFifo()
+{
+    // Drain FIFO and accumulate into the wet pyramid
+    const int numReady = wetFifo.getNumReady();
+
+    if (numReady <= 0 || !player.isFileLoaded() || wetPyramid.getNumLevels() == 0)
+    {
+        return;
+    }
+
+    const auto scope = wetFifo.read(numReady);
+
+    for (int i = 0; i < scope.blockSize1; ++i)
+    {
+        accumulatePeak(wetFifoBuffer[static_cast<size_t>(scope.startIndex1 + i)]);
+    }
+
+    for (int i = 0; i < scope.blockSize2; ++i)
+    {
+        accumulatePeak(wetFifoBuffer[static_cast<size_t>(scope.startIndex2 + i)]);
+    }
+}
+
+void WaveformDisplay::accumulatePeak(const GrainDSP::PeakSummary& peak)
+{
+    wetPyramid.merge(peak);
+    wetHasData = true;
+
+    auto const columns = columnsForSamples(wetPyramid, peak.startPosition, peak.startPosition + peak.numSamples);
+
+    if (!columns.isEmpty())
+    {
+        wetDirtyColumns = wetDirtyColumns.isEmpty() ? columns : wetDirtyColumns.getUnionWith(columns);
+    }
+}
+
+void WaveformDisplay::syncWithFile()
+{
+    auto const file = player.isFileLoaded() ? player.getLoadedFile() : juce::File();
+    auto const totalSamples = player.isFileLoaded() ? player.getFileLengthInSamples() : 0;
+
+    if (file == knownFile && totalSamples == knownFileLength)
+    {
+        return;
+    }
+
+    // New content: whole-file view, empty wet pyramid sized for it, stale raw samples and layers dropped
+    knownFile = file;
+    knownFileLength = totalSamples;
+    visibleStart = 0.0;
+    visibleLength = 0.0;
+    detailStart = -1;
+    wetPyramid.reset(totalSamples);
+    wetHasData = false;
+    wetPreviewPeaksConsumed = 0;
+    dryLayer = {};
+    wetLayer = {};
+}
+
+void WaveformDisplay::followCursor()
+{
+    if (visibleLength <= 0.0 || !player.isPlaying())
+    {
+        return;
+    }
+
+    // Page forward (or back after a loop wrap) once the cursor leaves the view
+    double const cursorSample = player.getCurrentPosition() * player.getFileSampleRate();
+
+    if (cursorSample < visibleStart || cursorSample >= visibleStart + visibleLength)
+    {
+        setVisibleRange(cursorSample, visibleLength);
+    }
+}
+
+//==============================================================================
+bool WaveformDisplay::layersMatchView() const
+{
+    auto const bounds = getWaveformBounds();
+    return dryLayer.isValid() && dryLayer.getWidth() == bounds.getWidth() && dryLayer.getHeight() == bounds.getHeight()
+           && layerRange == getVisibleRange();
+}
+
+void WaveformDisplay::rebuildLayers()
+{
+    auto const bounds = getWaveformBounds();
+
+    if (bounds.isEmpty())
+    {
+        dryLayer = {};
+        wetLayer = {};
+        return;
+    }
+
+    // Reuse the images while the size holds (zooming and scrolling only redraw)
+    if (dryLayer.getBounds() != bounds.withZeroOrigin())
+    {
+        dryLayer = juce::Image(juce::Image::ARGB, bounds.getWidth(), bounds.getHeight(), true);
+        wetLayer = juce::Image(juce::Image::ARGB, bounds.getWidth(), bounds.getHeight(), true);
+    }
+
+    layerRange = getVisibleRange();
+    dryLayerLimit = player.getThumbnailSamplesReady();
+    wetDirtyColumns = {};
+
+    const juce::Range<int> allColumns(0, bounds.getWidth());
+    renderLayerColumns(dryLayer, allColumns, false);
+    renderLayerColumns(wetLayer, allColumns, true);
+
+    cursorX = computeCursorX();
+}
+
+void WaveformDisplay::updateLayers()
+{
+    auto const bounds = getWaveformBounds();
+
+    if (!layersMatchView())
+    {
+        rebuildLayers();
         repaint();
         return;
     }
 
-    // Drain FIFO and accumulate into wet columns
-    const int numReady = wetFifo.getNumReady();
+    juce::Range<int> dirty;
+
+    // Dry: only columns whose thumbnail buckets became final since the last tick
+    // (below the pyramid base the layer shows raw samples and needs no progress updates)
+    auto const ready = player.getThumbnailSamplesReady();
 
-    if (numReady > 0)
+    if (ready > dryLayerLimit && getSamplesPerPixel() >= static_cast<double>(GrainDSP::PeakPyramid::kBaseSamples))
     {
-        int start1 = 0;
-        int size1 = 0;
-        int start2 = 0;
-        int size2 = 0;
-        wetFifo.prepareToRead(numReady, start1, size1, start2, size2);
+        dirty = columnsForSamples(player.getThumbnail(), dryLayerLimit, ready);
+        dryLayerLimit = ready;
 
-        auto processChunk = [this](int start, int size)
+        if (!dirty.isEmpty())
         {
-            if (size <= 0 || wetColumns.empty())
-            {
-                return;
-            }
+            renderLayerColumns(dryLayer, dirty, false);
+        }
+    }
 
-            auto const totalFileSamples = player.getFileLengthInSamples();
+    // Wet: columns touched by peaks merged since the last tick
+    if (!wetDirtyColumns.isEmpty())
+    {
+        renderLayerColumns(wetLayer, wetDirtyColumns, true);
+        dirty = dirty.isEmpty() ? wetDirtyColumns : dirty.getUnionWith(wetDirtyColumns);
+        wetDirtyColumns = {};
+    }
 
-            if (totalFileSamples <= 0)
-            {
-                return;
-            }
+    if (!dirty.isEmpty())
+    {
+        repaint(bounds.getX() + dirty.getStart(), bounds.getY(), dirty.getLength(), bounds.getHeight());
+    }
+}
 
-            const int numColumns = static_cast<int>(wetColumns.size());
+void WaveformDisplay::renderLayerColumns(juce::Image& layer, juce::Range<int> columns, bool wet)
+{
+    const juce::Rectangle<int> strip(columns.getStart(), 0, columns.getLength(), layer.getHeight());
+    layer.clear(strip);
 
-            for (int i = 0; i < size; ++i)
-            {
-                auto const& ws = wetFifoBuffer[static_cast<size_t>(start + i)];
+    juce::Graphics g(layer);
+    g.reduceClipRegion(strip);
+
+    if (wet)
+    {
+        drawWetWaveform(g, layer.getBounds(), columns);
+    }
+    else
+    {
+        drawDryWaveform(g, layer.getBounds(), columns);
+    }
+}
 
-                // Map this sample to a column based on its actual file position
-                auto const columnIndex = static_cast<int>(
-                    (static_cast<double>(ws.filePosition) / static_cast<double>(totalFileSamples)) * numColumns);
-                const int clampedCol = juce::jlimit(0, numColumns - 1, columnIndex);
+juce::Range<int> WaveformDisplay::columnsForSamples(const GrainDSP::PeakPyramid& pyramid, juce::int64 start,
+                                                    juce::int64 end) const
+{
+    double const samplesPerPixel = getSamplesPerPixel();
+    const int width = getWaveformBounds().getWidth();
 
-                auto& col = wetColumns[static_cast<size_t>(clampedCol)];
-                col.minVal = std::min(col.minVal, ws.value);
-                col.maxVal = std::max(col.maxVal, ws.value);
-                col.sampleCount++;
-            }
-        };
+    if (samplesPerPixel <= 0.0 || width <= 0 || pyramid.getNumLevels() == 0 || end <= start)
+    {
+        return {};
+    }
 
-        processChunk(start1, size1);
-        processChunk(start2, size2);
+    // Columns read whole buckets of the drawing level, so widen to the bucket grid
+    auto const bucketSamples =
+        GrainDSP::PeakPyramid::getBucketSamples(pyramid.getLevelForSpan(samplesPerPixel));
+    auto const alignedStart = (start / bucketSamples) * bucketSamples;
+    auto const alignedEnd = ((end + bucketSamples - 1) / bucketSamples) * bucketSamples;
 
-        wetFifo.finishedRead(size1 + size2);
+    // One column of slack each side for the truncation in drawPyramid()
+    double const viewStart = getVisibleRange().getStart();
+    auto const first = static_cast<int>(std::floor((static_cast<double>(alignedStart) - viewStart) / samplesPerPixel));
+    auto const last = static_cast<int>(std::floor((static_cast<double>(alignedEnd) - viewStart) / samplesPerPixel));
+
+    return juce::Range<int>(first - 1, last + 2).getIntersectionWith({0, width});
+}
+
+void WaveformDisplay::updateCursor()
+{
+    const int newCursorX = computeCursorX();
+
+    if (newCursorX == cursorX)
+    {
+        return;
+    }
+
+    // Only the strips under the old and the new cursor change
+    auto const bounds = getWaveformBounds();
+    auto const stripWidth = static_cast<int>(std::ceil(kCursorWidth)) + 2;
+
+    for (const int x : {cursorX, newCursorX})
+    {
+        if (x >= 0)
+        {
+            repaint(x - (stripWidth / 2), bounds.getY(), stripWidth, bounds.getHeight());
+        }
+    }
+
+    cursorX = newCursorX;
+}
+
+int WaveformDisplay::computeCursorX() const
+{
+    if (!player.isFileLoaded() || player.getFileDurationSeconds() <= 0.0)
+    {
+        return -1;
     }
 
-    repaint();
+    auto const bounds = getWaveformBounds();
+    auto const normalized = static_cast<float>(player.getCurrentPosition() / player.getFileDurationSeconds());
+    const int x = normalizedToPixel(juce::jlimit(0.0f, 1.0f, normalized));
+
+    // Off-screen while zoomed elsewhere
+    return x < bounds.getX() || x > bounds.getRight() ? -1 : x;
 }
 
 //==============================================================================
-void WaveformDisplay::drawDryWaveform(juce::Graphics& g, juce::Rectangle<int> bounds)
+void WaveformDisplay::drawPyramid(juce::Graphics& g, juce::Rectangle<int> area, const GrainDSP::PeakPyramid& pyramid,
+                                  juce::int64 limit, juce::Range<int> columns)
 {
-    auto& thumbnail = player.getThumbnail();
+    double const samplesPerPixel = getSamplesPerPixel();
 
-    if (thumbnail.getTotalLength() <= 0.0)
+    if (samplesPerPixel <= 0.0 || pyramid.getNumLevels() == 0)
     {
         return;
     }
 
+    // A level whose buckets fit in one pixel: at most a few buckets per column at any zoom
+    const int level = pyramid.getLevelForSpan(samplesPerPixel);
+    double const viewStart = getVisibleRange().getStart();
+    auto const centreY = static_cast<float>(area.getCentreY());
+    auto const halfHeight = static_cast<float>(area.getHeight()) * 0.5f;
+
+    for (int x = columns.getStart(); x < columns.getEnd(); ++x)
+    {
+        auto const start = static_cast<juce::int64>(viewStart + (x * samplesPerPixel));
+        auto const end = std::max(start + 1, static_cast<juce::int64>(viewStart + ((x + 1) * samplesPerPixel)));
+
+        GrainDSP::PeakPyramid::Bucket bucket;
+
+        if (!pyramid.getRange(level, start, end, limit, bucket))
+        {
+            continue;
+        }
+
+        float const topY = centreY - (bucket.maxVal * halfHeight);
+        float const bottomY = centreY - (bucket.minVal * halfHeight);
+        float const lineHeight = std::max(1.0f, bottomY - topY);
+
+        g.fillRect(static_cast<float>(area.getX() + x), topY, 1.0f, lineHeight);
+    }
+}
+
+void WaveformDisplay::drawDryWaveform(juce::Graphics& g, juce::Rectangle<int> area, juce::Range<int> columns)
+{
     // Draw mono (channel 0 only) to match the wet waveform representation.
     // The wet signal is captured from channel 0, so dry must be consistent.
     g.setColour(GrainColours::kText.withAlpha(kDryAlpha));
-    thumbnail.drawChannel(g, bounds, 0.0, thumbnail.getTotalLength(), 0, 1.0f);
+
+    if (getSamplesPerPixel() < static_cast<double>(GrainDSP::PeakPyramid::kBaseSamples))
+    {
+        drawDrySamples(g, area);
+        return;
+    }
+
+    drawPyramid(g, area, player.getThumbnail(), dryLayerLimit, columns);
 }
 
-void WaveformDisplay::drawWetWaveform(juce::Graphics& g, juce::Rectangle<int> bounds)
+void WaveformDisplay::drawDrySamples(juce::Graphics& g, juce::Rectangle<int> area)
 {
-    if (wetColumns.empty() || !hasWetData())
+    auto const range = getVisibleRange();
+    double const samplesPerPixel = getSamplesPerPixel();
+
+    if (range.isEmpty() || samplesPerPixel <= 0.0)
     {
         return;
     }
 
-    const int numColumns = static_cast<int>(wetColumns.size());
-    auto const centreY = static_cast<float>(bounds.getCentreY());
-    auto const halfHeight = static_cast<float>(bounds.getHeight()) * 0.5f;
+    auto const first = static_cast<juce::int64>(range.getStart());
+    auto const count = static_cast<juce::int64>(std::ceil(range.getEnd())) - first + 1;
+    auto const cachedEnd = detailStart + static_cast<juce::int64>(detailSamples.size());
 
-    g.setColour(GrainColours::kAccent.withAlpha(kWetAlpha));
+    // The view is under kBaseSamples per pixel, so this is a few hundred kB at most;
+    // one view of margin each side keeps scrolling and cursor paging from re-reading
+    if (detailStart < 0 || first < detailStart || first + count > cachedEnd)
+    {
+        detailStart = std::max<juce::int64>(0, first - count);
+        detailSamples.resize(static_cast<size_t>(3 * count));
+
+        if (!player.readDisplaySamples(detailStart, static_cast<int>(detailSamples.size()), detailSamples.data()))
+        {
+            detailStart = -1;
+            return;
+        }
+    }
 
-    for (int i = 0; i < numColumns; ++i)
+    auto const sampleAt = [this](juce::int64 position)
+    { return detailSamples[static_cast<size_t>(position - detailStart)]; };
+
+    auto const centreY = static_cast<float>(area.getCentreY());
+    auto const halfHeight = static_cast<float>(area.getHeight()) * 0.5f;
+
+    if (samplesPerPixel < 1.0)
     {
-        auto const& col = wetColumns[static_cast<size_t>(i)];
+        // Fewer samples than pixels: connect the individual samples
+        juce::Path path;
 
-        if (col.sampleCount == 0)
+        for (juce::int64 i = first; i < first + count; ++i)
         {
-            continue;
+            double const offset = (static_cast<double>(i) - range.getStart()) / samplesPerPixel;
+            auto const x = static_cast<float>(area.getX() + offset);
+            float const y = centreY - (sampleAt(i) * halfHeight);
+
+            if (i == first)
+            {
+                path.startNewSubPath(x, y);
+            }
+            else
+            {
+                path.lineTo(x, y);
+            }
         }
 
-        float const topY = centreY - (col.maxVal * halfHeight);
-        float const bottomY = centreY - (col.minVal * halfHeight);
-        auto const x = static_cast<float>(bounds.getX() + i);
-        float const lineHeight = std::max(1.0f, bottomY - topY);
+        g.strokePath(path, juce::PathStrokeType(1.0f));
+        return;
+    }
+
+    // Between 1 and kBaseSamples per pixel: min/max of the raw samples in each column
+    for (int x = 0; x < area.getWidth(); ++x)
+    {
+        auto const start = static_cast<juce::int64>(range.getStart() + (x * samplesPerPixel));
+        auto const columnEnd = static_cast<juce::int64>(range.getStart() + ((x + 1) * samplesPerPixel));
+        auto const end = std::min(first + count, std::max(start + 1, columnEnd));
+
+        float minVal = sampleAt(start);
+        float maxVal = minVal;
+
+        for (juce::int64 i = start + 1; i < end; ++i)
+        {
+            minVal = std::min(minVal, sampleAt(i));
+            maxVal = std::max(maxVal, sampleAt(i));
+        }
 
-        g.fillRect(x, topY, 1.0f, lineHeight);
+        float const topY = centreY - (maxVal * halfHeight);
+        float const lineHeight = std::max(1.0f, (maxVal - minVal) * halfHeight);
+
+        g.fillRect(static_cast<float>(area.getX() + x), topY, 1.0f, lineHeight);
     }
 }
 
-void WaveformDisplay::drawCursor(juce::Graphics& g, juce::Rectangle<int> bounds)
+void WaveformDisplay::drawWetWaveform(juce::Graphics& g, juce::Rectangle<int> area, juce::Range<int> columns)
 {
-    if (!player.isFileLoaded() || player.getFileDurationSeconds() <= 0.0)
+    if (!wetHasData)
     {
         return;
     }
 
-    auto const normalized = static_cast<float>(player.getCurrentPosition() / player.getFileDurationSeconds());
-    const int cursorX = normalizedToPixel(juce::jlimit(0.0f, 1.0f, normalized));
+    g.setColour(GrainColours::kAccent.withAlpha(kWetAlpha));
+    drawPyramid(g, area, wetPyramid, wetPyramid.getTotalSamples(), columns);
+}
+
+void WaveformDisplay::drawCursor(juce::Graphics& g, juce::Rectangle<int> bounds)
+{
+    if (cursorX < 0)
+    {
+        return;
+    }
 
     g.setColour(GrainColours::kTextBright);
     g.fillRect(static_cast<float>(cursorX) - (kCursorWidth * 0.5f), static_cast<float>(bounds.getY()), kCursorWidth,
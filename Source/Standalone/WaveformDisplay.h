@@ -3,16 +3,20 @@
 
     WaveformDisplay.h
     GRAIN — Standalone waveform display with dry + wet overlay (GT-18).
-    Shows the original waveform (from AudioThumbnail) and the processed
-    output waveform superimposed with distinct colors. Supports click-to-seek
-    and a playback cursor.
+    Shows the original waveform (from the file player's peak pyramid) and the
+    processed output waveform superimposed with distinct colors. Supports
+    zoom/scroll, click-to-seek and a playback cursor.
 
   ==============================================================================
 */
 
 #pragma once
 
+#include "../DSP/PeakDecimator.h"
+#include "../DSP/PeakPyramid.h"
+#include "../UI/RefreshScheduler.h"
 #include "FilePlayerSource.h"
+#include "WetPreviewRenderer.h"
 
 #include <JuceHeader.h>
 
@@ -21,21 +25,34 @@
  * Waveform display component for the GRAIN standalone application.
  *
  * Renders two overlaid waveforms:
- *   - Dry (pre-processed): drawn from AudioThumbnail, semi-transparent
- *   - Wet (post-processed): accumulated in real-time from processed output
+ *   - Dry (pre-processed): drawn from FilePlayerSource's thumbnail pyramid
+ *     (or raw samples when zoomed in past its base), semi-transparent
+ *   - Wet (post-processed): precomputed in the background by a
+ *     WetPreviewRenderer when one is attached, and accumulated in real-time
+ *     from processed output during playback
+ *
+ * Both are kept as PeakPyramids over the whole file, so painting costs
+ * O(pixels) at any zoom and resizing or zooming never discards wet data.
+ * Each is rendered into a cached layer image; refresh ticks only redraw the
+ * columns touched by new peaks and repaint those columns plus the cursor
+ * strip. A full redraw happens only when the view, size or file changes.
  *
  * Features:
  *   - Click-to-seek (sends position to FilePlayerSource)
- *   - Playback cursor (vertical line at current position)
- *   - Full file always visible (no zoom/scroll for V1)
+ *   - Playback cursor (vertical line at current position, followed when zoomed)
+ *   - Mouse wheel zooms around the pointer, horizontal/shift wheel scrolls,
+ *     double-click shows the whole file
  *
  * The wet waveform is accumulated via pushWetSamples() called from the
- * editor's timer callback with processed output data.
+ * audio thread with processed output data.
+ *
+ * Refreshed by the shared RefreshScheduler: every display frame while
+ * playing, otherwise only when the file, position or thumbnail changes.
  */
 class WaveformDisplay
     : public juce::Component
     , public FilePlayerSource::Listener
-    , private juce::Timer
+    , private RefreshScheduler::Client
 {
 public:
     //==============================================================================
@@ -46,15 +63,19 @@ public:
     void paint(juce::Graphics& g) override;
     void resized() override;
     void mouseDown(const juce::MouseEvent& event) override;
+    void mouseDoubleClick(const juce::MouseEvent& event) override;
+    void mouseWheelMove(const juce::MouseEvent& event, const juce::MouseWheelDetails& wheel) override;
 
     //==============================================================================
     // FilePlayerSource::Listener
     void transportStateChanged(bool isNowPlaying) override;
     void transportReachedEnd() override;
+    void transportContentChanged() override;
 
     //==============================================================================
     /** Push processed (wet) output samples for real-time waveform accumulation.
-     *  Called from the audio thread via the processor. Thread-safe (uses FIFO).
+     *  Called from the audio thread via the processor. Samples are reduced to
+     *  min/max peaks of PeakDecimator::kSamplesPerPeak before entering the FIFO.
      *  @param samples        Pointer to mono sample data.
      *  @param numSamples     Number of samples in the buffer.
      *  @param samplePosition Position (in samples) within the file where this block starts. */
@@ -64,7 +85,29 @@ public:
     void clearWetBuffer();
 
     /** @return true if wet waveform data has been accumulated. */
-    bool hasWetData() const;
+    bool hasWetData() const { return wetHasData; }
+
+    /** Attach a background wet renderer whose peaks fill the overlay progressively.
+     *  Pass nullptr to detach. The renderer must outlive this display or be detached first. */
+    void setWetPreview(WetPreviewRenderer* renderer);
+
+    //==============================================================================
+    // Zoom / scroll (in file samples)
+
+    /** Show the given sample range, clamped to the file and to kMinSamplesPerPixel. */
+    void setVisibleRange(double startSample, double numSamples);
+
+    /** @return Visible range in samples (the whole file unless zoomed). */
+    juce::Range<double> getVisibleRange() const;
+
+    /** Zoom by a factor (> 1 zooms in) keeping anchorSample under the same pixel. */
+    void zoomAround(double anchorSample, double factor);
+
+    /** Show the whole file. */
+    void zoomToFit();
+
+    /** Closest zoom: pixels per sample is 1 / kMinSamplesPerPixel. */
+    static constexpr double kMinSamplesPerPixel = 0.125;
 
     //==============================================================================
     /** Map a pixel X position to normalized [0,1] file position. */
@@ -78,41 +121,111 @@ public:
 
 private:
     //==============================================================================
-    void timerCallback() override;
+    // RefreshScheduler::Client
+    RefreshScheduler::Mode refreshTick() override;
+    juce::Component& getRefreshComponent() override { return *this; }
+
+    /** Move pending FIFO peaks into the wet pyramid. */
+    void drainWetFifo();
+
+    /** Merge newly rendered preview peaks into the wet pyramid.
+     *  @return true while the preview is still rendering. */
+    bool consumeWetPreview();
+
+    /** Merge one peak into the wet pyramid and mark its columns dirty. */
+    void accumulatePeak(const GrainDSP::PeakSummary& peak);
+
+    /** Size the wet pyramid and the view for the loaded file when it changes. */
+    void syncWithFile();
+
+    /** Scroll so the playback cursor stays visible while zoomed in. */
+    void followCursor();
+
+    /** @return Samples per pixel for the current view (0 when nothing is loaded). */
+    double getSamplesPerPixel() const;
+
+    /** @return Layer columns whose pixels read pyramid buckets overlapping [start, end). */
+    juce::Range<int> columnsForSamples(const GrainDSP::PeakPyramid& pyramid, juce::int64 start,
+                                       juce::int64 end) const;
+
+    //==============================================================================
+    /** @return true if the cached layers were drawn for the current size and view. */
+    bool layersMatchView() const;
+
+    /** Redraw both layers completely (view, size or file changed). */
+    void rebuildLayers();
+
+    /** Redraw newly ready dry columns and dirty wet columns; repaint just those.
+     *  Falls back to rebuildLayers() + full repaint when the view changed. */
+    void updateLayers();
+
+    /** Clear and redraw a column range of one layer. */
+    void renderLayerColumns(juce::Image& layer, juce::Range<int> columns, bool wet);
+
+    /** Repaint the old and new cursor strips if the cursor moved. */
+    void updateCursor();
+
+    /** @return Cursor X in component coordinates, or -1 when hidden or off-view. */
+    int computeCursorX() const;
+
+    //==============================================================================
+    /** Draw one min/max bar per pixel column in `columns` from a pyramid. */
+    void drawPyramid(juce::Graphics& g, juce::Rectangle<int> area, const GrainDSP::PeakPyramid& pyramid,
+                     juce::int64 limit, juce::Range<int> columns);
+
+    /** Draw the dry waveform from the thumbnail pyramid, or from raw samples below its base. */
+    void drawDryWaveform(juce::Graphics& g, juce::Rectangle<int> area, juce::Range<int> columns);
 
-    /** Draw the dry waveform from AudioThumbnail. */
-    void drawDryWaveform(juce::Graphics& g, juce::Rectangle<int> bounds);
+    /** Draw raw dry samples (zoomed in below PeakPyramid::kBaseSamples per pixel). */
+    void drawDrySamples(juce::Graphics& g, juce::Rectangle<int> area);
 
-    /** Draw the wet waveform from accumulated samples. */
-    void drawWetWaveform(juce::Graphics& g, juce::Rectangle<int> bounds);
+    /** Draw the wet waveform from the wet pyramid. */
+    void drawWetWaveform(juce::Graphics& g, juce::Rectangle<int> area, juce::Range<int> columns);
 
-    /** Draw the playback cursor. */
+    /** Draw the playback cursor at cursorX. */
     void drawCursor(juce::Graphics& g, juce::Rectangle<int> bounds);
 
     //==============================================================================
     FilePlayerSource& player;
 
-    // Wet waveform accumulation
-    // We store min/max pairs per display column for efficient rendering.
-    // The buffer is resized when the component width changes.
-    struct WetColumn
-    {
-        float minVal = 0.0f;
-        float maxVal = 0.0f;
-        int sampleCount = 0;
-    };
-
-    std::vector<WetColumn> wetColumns;
-
-    /** FIFO entry: a sample value tagged with its file position. */
-    struct WetSample
-    {
-        float value = 0.0f;
-        juce::int64 filePosition = 0;
-    };
-
-    juce::AbstractFifo wetFifo{2048};
-    std::vector<WetSample> wetFifoBuffer;
+    // View: visible sample range; visibleLength <= 0 shows the whole file
+    double visibleStart = 0.0;
+    double visibleLength = 0.0;
+    juce::File knownFile;
+    juce::int64 knownFileLength = 0;
+
+    // Raw samples around the view, for sample-level zoom (refilled when the view leaves them)
+    std::vector<float> detailSamples;
+    juce::int64 detailStart = -1;
+
+    // Wet waveform over the whole file, independent of size and zoom
+    GrainDSP::PeakPyramid wetPyramid;
+    bool wetHasData = false;
+
+    // Cached layers covering the waveform area, drawn for layerRange
+    juce::Image dryLayer;
+    juce::Image wetLayer;
+    juce::Range<double> layerRange;
+    juce::int64 dryLayerLimit = 0;     // Thumbnail samples ready when the dry layer was last drawn
+    juce::Range<int> wetDirtyColumns;  // Wet layer columns waiting for a redraw
+    int cursorX = -1;                  // Where the cursor was last drawn (component coordinates)
+
+    // Audio thread → message thread: one min/max peak per 128 samples
+    // (1024 peaks ≈ 2.7 s at 48 kHz between refresh ticks)
+    static constexpr int kWetFifoPeaks = 1024;
+
+    GrainDSP::PeakDecimator wetDecimator;                // Audio thread only
+    std::atomic<bool> wetDecimatorResetRequested{false};  // Set by clearWetBuffer()
+    juce::AbstractFifo wetFifo{kWetFifoPeaks};
+    std::vector<GrainDSP::PeakSummary> wetFifoBuffer;
+
+    // Background wet preview (optional)
+    WetPreviewRenderer* wetPreview = nullptr;
+    juce::uint32 wetPreviewGeneration = 0;
+    int wetPreviewPeaksConsumed = 0;
+
+    // Last member: unregisters before anything refreshTick() touches is destroyed
+    RefreshScheduler::Registration refreshRegistration{*this, RefreshScheduler::Mode::kIdle};
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformDisplay)
@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+    WetPreviewRenderer.cpp
+    GRAIN — Background wet waveform precomputation implementation.
+
+  ==============================================================================
+*/
+
+#include "WetPreviewRenderer.h"
+
+#include "AudioFileUtils.h"
+
+//==============================================================================
+WetPreviewRenderer::WetPreviewRenderer(ProcessorFactory factory)
+    : juce::Thread("GRAIN Wet Preview")
+    , processorFactory(std::move(factory))
+{
+    formatManager.registerBasicFormats();
+}
+
+WetPreviewRenderer::~WetPreviewRenderer()
+{
+    stopTimer();
+    stopJob();
+}
+
+//==============================================================================
+void WetPreviewRenderer::setFile(const juce::File& file)
+{
+    currentFile = file;
+    stopJob();
+    startTimer(kDebounceMs);
+}
+
+void WetPreviewRenderer::parametersChanged()
+{
+    if (currentFile == juce::File())
+    {
+        return;
+    }
+
+    // Each change restarts the debounce; only the last one in a burst renders
+    stopJob();
+    startTimer(kDebounceMs);
+}
+
+void WetPreviewRenderer::renderNow()
+{
+    stopTimer();
+    startJob();
+}
+
+void WetPreviewRenderer::cancel()
+{
+    stopTimer();
+    stopJob();
+}
+
+bool WetPreviewRenderer::waitForCompletion(int timeoutMs)
+{
+    return waitForThreadToExit(timeoutMs);
+}
+
+void WetPreviewRenderer::timerCallback()
+{
+    stopTimer();
+    startJob();
+}
+
+//==============================================================================
+void WetPreviewRenderer::stopJob()
+{
+    stopThread(2000);
+    jobProcessor.reset();
+    jobReader.reset();
+}
+
+void WetPreviewRenderer::startJob()
+{
+    stopJob();
+
+    // New generation: readers drop what they accumulated and restart from peak 0
+    ++generation;
+    numPeaksReady.store(0, std::memory_order_release);
+    progress.store(0.0f, std::memory_order_relaxed);
+    totalSamples = 0;
+
+    if (!currentFile.existsAsFile())
+    {
+        return;
+    }
+
+    jobReader = AudioFileUtils::createStereoReader(formatManager, currentFile);
+
+    if (jobReader == nullptr || jobReader->lengthInSamples <= 0 || processorFactory == nullptr)
+    {
+        jobReader.reset();
+        return;
+    }
+
+    jobProcessor = processorFactory();
+
+    if (jobProcessor == nullptr)
+    {
+        jobReader.reset();
+        return;
+    }
+
+    // Same oversampling as playback, so the preview matches what is heard
+    jobProcessor->setNonRealtime(false);
+    jobProcessor->prepareToPlay(jobReader->sampleRate, kBlockSize);
+
+    totalSamples = jobReader->lengthInSamples;
+    peaks.resize(static_cast<size_t>(totalSamples / GrainDSP::PeakDecimator::kSamplesPerPeak + 2));
+
+    startThread(juce::Thread::Priority::low);
+
+    if (onJobStarted != nullptr)
+    {
+        onJobStarted();
+    }
+}
+
+//==============================================================================
+void WetPreviewRenderer::run()
+{
+    const int numChannels = std::max(2, jobProcessor->getTotalNumOutputChannels());
+    const bool monoFile = jobReader->numChannels == 1;
+    const auto latency = static_cast<juce::int64>(jobProcessor->getLatencySamples());
+
+    juce::AudioBuffer<float> buffer(numChannels, kBlockSize);
+    juce::MidiBuffer midi;
+    GrainDSP::PeakDecimator decimator;
+    int written = 0;
+
+    const auto emit = [this, &written](const GrainDSP::PeakSummary& peak)
+    {
+        if (static_cast<size_t>(written) < peaks.size())
+        {
+            peaks[static_cast<size_t>(written++)] = peak;
+        }
+    };
+
+    // Read latency samples past the end (the reader zero-fills) so the output tail is complete
+    const juce::int64 endPosition = totalSamples + latency;
+
+    for (juce::int64 position = 0; position < endPosition && !threadShouldExit(); position += kBlockSize)
+    {
+        const auto numSamples = static_cast<int>(std::min<juce::int64>(kBlockSize, endPosition - position));
+
+        buffer.clear();
+        jobReader->read(&buffer, 0, numSamples, position, true, !monoFile);
+
+        if (monoFile)
+        {
+            buffer.copyFrom(1, 0, buffer, 0, 0, numSamples);
+        }
+
+        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+        jobProcessor->processBlock(block, midi);
+
+        // Output sample i corresponds to file position (position + i - latency)
+        const juce::int64 outputStart = position - latency;
+        const auto skip = static_cast<int>(std::clamp<juce::int64>(-outputStart, 0, numSamples));
+        const auto keep = static_cast<int>(
+            std::min<juce::int64>(numSamples - skip, totalSamples - std::max<juce::int64>(outputStart, 0)));
+
+        if (keep > 0)
+        {
+            decimator.process(block.getReadPointer(0, skip), keep, std::max<juce::int64>(outputStart, 0), emit);
+        }
+
+        numPeaksReady.store(written, std::memory_order_release);
+        const double done = static_cast<double>(position + numSamples) / static_cast<double>(endPosition);
+        progress.store(static_cast<float>(done), std::memory_order_relaxed);
+    }
+
+    if (!threadShouldExit())
+    {
+        decimator.flush(emit);
+        numPeaksReady.store(written, std::memory_order_release);
+        progress.store(1.0f, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    WetPreviewRenderer.h
+    GRAIN — Background, faster-than-realtime wet waveform precomputation.
+    Renders the loaded file through a private processor instance and
+    publishes a min/max peak summary progressively for WaveformDisplay.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../DSP/PeakDecimator.h"
+
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+
+//==============================================================================
+/**
+ * Renders the wet (processed) waveform of a file in the background.
+ *
+ * Each job creates its own processor through the factory (configured with a
+ * snapshot of the live parameters), reads the file with its own reader and
+ * processes it block by block as fast as the CPU allows. Output channel 0 is
+ * reduced by a PeakDecimator into a preallocated peak array; readers see a
+ * growing prefix of it via getNumPeaksReady() (release/acquire), so the
+ * overlay fills in progressively without locks.
+ *
+ * Requests are debounced: a file load or a burst of parameter changes
+ * cancels the running job and starts one new job kDebounceMs after the
+ * last request. The realtime processor is never touched.
+ *
+ * Thread safety:
+ *   - All public methods except getNumPeaksReady()/getPeak()/getProgress():
+ *     message thread only.
+ *   - Peaks below getNumPeaksReady() are immutable until the next job starts,
+ *     which only happens on the message thread (see getGeneration()).
+ */
+class WetPreviewRenderer
+    : private juce::Thread
+    , private juce::Timer
+{
+public:
+    //==============================================================================
+    /** Creates a processor configured like the live one (called on the message thread). */
+    using ProcessorFactory = std::function<std::unique_ptr<juce::AudioProcessor>()>;
+
+    static constexpr int kDebounceMs = 250;
+    static constexpr int kBlockSize = 4096;
+
+    explicit WetPreviewRenderer(ProcessorFactory factory);
+    ~WetPreviewRenderer() override;
+
+    //==============================================================================
+    /** Render a new file (debounced). Pass an empty File to stop and clear. */
+    void setFile(const juce::File& file);
+
+    /** Parameters changed: re-render the current file (debounced). */
+    void parametersChanged();
+
+    /** Start the pending job now, skipping the debounce (e.g. for tests). */
+    void renderNow();
+
+    /** Cancel the running job and any pending request. Rendered peaks stay readable. */
+    void cancel();
+
+    /** Block until the running job finishes (for tests / offline use).
+     *  @return true if no job is running any more. */
+    bool waitForCompletion(int timeoutMs);
+
+    //==============================================================================
+    /** @return true while a job is rendering. */
+    bool isRendering() const { return isThreadRunning(); }
+
+    /** @return Fraction of the file rendered by the current job, 0..1. Thread-safe. */
+    float getProgress() const { return progress.load(std::memory_order_relaxed); }
+
+    /** @return Incremented whenever a new job starts; readers restart from peak 0. */
+    juce::uint32 getGeneration() const { return generation; }
+
+    /** @return Length of the file being rendered, in samples. */
+    juce::int64 getTotalSamples() const { return totalSamples; }
+
+    /** @return Number of peaks published so far. Thread-safe. */
+    int getNumPeaksReady() const { return numPeaksReady.load(std::memory_order_acquire); }
+
+    /** @return Peak at index (must be below getNumPeaksReady()). */
+    const GrainDSP::PeakSummary& getPeak(int index) const { return peaks[static_cast<size_t>(index)]; }
+
+    /** Called on the message thread when a job starts (e.g. to wake the display). */
+    std::function<void()> onJobStarted;
+
+private:
+    //==============================================================================
+    void run() override;
+    void timerCallback() override;
+
+    /** Stop the worker thread (message thread). */
+    void stopJob();
+
+    /** Create the processor and reader for currentFile and start the worker. */
+    void startJob();
+
+    //==============================================================================
+    ProcessorFactory processorFactory;
+    juce::AudioFormatManager formatManager;
+
+    juce::File currentFile;
+
+    // Job state: created on the message thread, used only by the worker while it runs
+    std::unique_ptr<juce::AudioProcessor> jobProcessor;
+    std::unique_ptr<juce::AudioFormatReader> jobReader;
+
+    // Published output
+    std::vector<GrainDSP::PeakSummary> peaks;
+    std::atomic<int> numPeaksReady{0};
+    std::atomic<float> progress{0.0f};
+    juce::int64 totalSamples = 0;
+    juce::uint32 generation = 0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WetPreviewRenderer)
+};
@@ -0,0 +1,295 @@
+/*
+  ==============================================================================
+
+    CalibrationProfileFile.cpp
+    GRAIN — Calibration profile reading and writing.
+
+  ==============================================================================
+*/
+
+#include "CalibrationProfileFile.h"
+
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+namespace
+{
+using GrainDSP::CalibrationConfig;
+
+/** One calibration value: its JSON location and where it lives in the config. */
+struct Field
+{
+    const char* module;
+    const char* name;
+    float& (*access)(CalibrationConfig&);
+};
+
+// Binary profile order: append only, never reorder
+const Field kFields[] = {
+    {"rms", "attackMs", [](CalibrationConfig& c) -> float& { return c.rms.attackMs; }},
+    {"rms", "releaseMs", [](CalibrationConfig& c) -> float& { return c.rms.releaseMs; }},
+    {"bias", "amount", [](CalibrationConfig& c) -> float& { return c.bias.amount; }},
+    {"bias", "scale", [](CalibrationConfig& c) -> float& { return c.bias.scale; }},
+    {"waveshaper", "driveMin", [](CalibrationConfig& c) -> float& { return c.waveshaper.driveMin; }},
+    {"waveshaper", "driveMax", [](CalibrationConfig& c) -> float& { return c.waveshaper.driveMax; }},
+    {"warmth", "depth", [](CalibrationConfig& c) -> float& { return c.warmth.depth; }},
+    {"focus", "lowShelfFreq", [](CalibrationConfig& c) -> float& { return c.focus.lowShelfFreq; }},
+    {"focus", "highShelfFreq", [](CalibrationConfig& c) -> float& { return c.focus.highShelfFreq; }},
+    {"focus", "shelfGainDb", [](CalibrationConfig& c) -> float& { return c.focus.shelfGainDb; }},
+    {"focus", "shelfQ", [](CalibrationConfig& c) -> float& { return c.focus.shelfQ; }},
+    {"dcBlocker", "cutoffHz", [](CalibrationConfig& c) -> float& { return c.dcBlocker.cutoffHz; }},
+};
+
+constexpr int kNumFields = static_cast<int>(std::size(kFields));
+
+const Field* findField(const juce::String& module, const juce::String& name)
+{
+    for (const auto& field : kFields)
+    {
+        if (module == field.module && name == field.name)
+        {
+            return &field;
+        }
+    }
+
+    return nullptr;
+}
+
+bool isKnownModule(const juce::String& module)
+{
+    for (const auto& field : kFields)
+    {
+        if (module == field.module)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+float readFloatLittleEndian(const char* bytes)
+{
+    const auto bits = juce::ByteOrder::littleEndianInt(bytes);
+    float value = 0.0f;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+}  // namespace
+
+//==============================================================================
+bool CalibrationProfileFile::load(const juce::File& file, GrainDSP::CalibrationConfig& result, juce::String& error)
+{
+    juce::MemoryBlock data;
+
+    if (!file.loadFileAsData(data))
+    {
+        error = "Cannot read " + file.getFullPathName();
+        return false;
+    }
+
+    if (data.getSize() >= sizeof(juce::uint32) && juce::ByteOrder::littleEndianInt(data.getData()) == kMagic)
+    {
+        return parseBinary(data.getData(), data.getSize(), result, error);
+    }
+
+    return parseJson(data.toString(), result, error);
+}
+
+bool CalibrationProfileFile::parseJson(const juce::String& json, GrainDSP::CalibrationConfig& result,
+                                       juce::String& error)
+{
+    juce::var parsed;
+    const auto parseResult = juce::JSON::parse(json, parsed);
+
+    if (parseResult.failed())
+    {
+        error = "Invalid JSON: " + parseResult.getErrorMessage();
+        return false;
+    }
+
+    auto* root = parsed.getDynamicObject();
+
+    if (root == nullptr)
+    {
+        error = "A calibration profile must be a JSON object";
+        return false;
+    }
+
+    auto candidate = GrainDSP::kDefaultCalibration;
+
+    for (const auto& module : root->getProperties())
+    {
+        const auto moduleName = module.name.toString();
+        auto* values = module.value.getDynamicObject();
+
+        if (!isKnownModule(moduleName) || values == nullptr)
+        {
+            error = "Unknown calibration module: " + moduleName;
+            return false;
+        }
+
+        for (const auto& value : values->getProperties())
+        {
+            const auto* field = findField(moduleName, value.name.toString());
+
+            if (field == nullptr)
+            {
+                error = "Unknown calibration value: " + moduleName + "." + value.name.toString();
+                return false;
+            }
+
+            if (!value.value.isDouble() && !value.value.isInt() && !value.value.isInt64())
+            {
+                error = moduleName + "." + value.name.toString() + " must be a number";
+                return false;
+            }
+
+            field->access(candidate) = static_cast<float>(static_cast<double>(value.value));
+        }
+    }
+
+    if (!validate(candidate, error))
+    {
+        return false;
+    }
+
+    result = candidate;
+    return true;
+}
+
+bool CalibrationProfileFile::parseBinary(const void* data, size_t sizeInBytes, GrainDSP::CalibrationConfig& result,
+                                         juce::String& error)
+{
+    const auto* bytes = static_cast<const char*>(data);
+
+    if (bytes == nullptr || sizeInBytes < static_cast<size_t>(kHeaderBytes)
+        || juce::ByteOrder::littleEndianInt(bytes) != kMagic)
+    {
+        error = "Not a binary calibration profile";
+        return false;
+    }
+
+    const auto version = juce::ByteOrder::littleEndianShort(bytes + 4);
+    const auto numValues = static_cast<int>(juce::ByteOrder::littleEndianShort(bytes + 6));
+
+    if (version > kVersion)
+    {
+        error = "Calibration profile version " + juce::String(version) + " is newer than this build";
+        return false;
+    }
+
+    if (sizeInBytes < static_cast<size_t>(kHeaderBytes) + (static_cast<size_t>(numValues) * sizeof(float)))
+    {
+        error = "Truncated calibration profile";
+        return false;
+    }
+
+    auto candidate = GrainDSP::kDefaultCalibration;
+
+    for (int i = 0; i < std::min(numValues, kNumFields); ++i)
+    {
+        kFields[i].access(candidate) = readFloatLittleEndian(bytes + kHeaderBytes + (i * 4));
+    }
+
+    if (!validate(candidate, error))
+    {
+        return false;
+    }
+
+    result = candidate;
+    return true;
+}
+
+//==============================================================================
+juce::String CalibrationProfileFile::toJson(const GrainDSP::CalibrationConfig& config)
+{
+    auto values = config;
+    const juce::DynamicObject::Ptr root = new juce::DynamicObject();
+
+    for (const auto& field : kFields)
+    {
+        if (!root->hasProperty(field.module))
+        {
+            root->setProperty(field.module, new juce::DynamicObject());
+        }
+
+        // Six decimals: the float's shortest readable form instead of its full double expansion
+        const double rounded = std::round(static_cast<double>(field.access(values)) * 1.0e6) / 1.0e6;
+        root->getProperty(field.module).getDynamicObject()->setProperty(field.name, rounded);
+    }
+
+    return juce::JSON::toString(juce::var(root.get()));
+}
+
+void CalibrationProfileFile::writeBinary(const GrainDSP::CalibrationConfig& config, juce::MemoryBlock& dest)
+{
+    auto values = config;
+
+    dest.setSize(static_cast<size_t>(kHeaderBytes + (kNumFields * 4)));
+    juce::MemoryOutputStream stream(dest, false);
+    stream.writeInt(static_cast<int>(kMagic));
+    stream.writeShort(static_cast<short>(kVersion));
+    stream.writeShort(static_cast<short>(kNumFields));
+
+    for (const auto& field : kFields)
+    {
+        stream.writeFloat(field.access(values));
+    }
+}
+
+bool CalibrationProfileFile::validate(const GrainDSP::CalibrationConfig& config, juce::String& error)
+{
+    auto values = config;
+
+    for (const auto& field : kFields)
+    {
+        if (!std::isfinite(field.access(values)))
+        {
+            error = juce::String(field.module) + "." + field.name + " is not a finite number";
+            return false;
+        }
+    }
+
+    const struct
+    {
+        const char* name;
+        float value;
+    } positives[] = {{"rms.attackMs", config.rms.attackMs},
+                     {"rms.releaseMs", config.rms.releaseMs},
+                     {"focus.lowShelfFreq", config.focus.lowShelfFreq},
+                     {"focus.highShelfFreq", config.focus.highShelfFreq},
+                     {"focus.shelfQ", config.focus.shelfQ},
+                     {"dcBlocker.cutoffHz", config.dcBlocker.cutoffHz}};
+
+    for (const auto& positive : positives)
+    {
+        if (positive.value <= 0.0f)
+        {
+            error = juce::String(positive.name) + " must be greater than zero";
+            return false;
+        }
+    }
+
+    // Shelves are prepared at the oversampled rate: 20 kHz stays below Nyquist from 44.1 kHz up
+    constexpr float kMaxShelfFreq = 20000.0f;
+
+    if (config.focus.lowShelfFreq > kMaxShelfFreq || config.focus.highShelfFreq > kMaxShelfFreq)
+    {
+        error = "Shelf frequencies must not exceed 20 kHz";
+        return false;
+    }
+
+    // The DC blocker pole 1 - 2*pi*fc/rate leaves the unit circle once fc > rate/pi (14 kHz at 44.1 kHz), and the
+    // approximation only holds far below that: 200 Hz keeps the pole above 0.97 from 44.1 kHz up
+    constexpr float kMaxDcBlockerCutoff = 200.0f;
+
+    if (config.dcBlocker.cutoffHz > kMaxDcBlockerCutoff)
+    {
+        error = "dcBlocker.cutoffHz must not exceed 200 Hz";
+        return false;
+    }
+
+    return true;
+}
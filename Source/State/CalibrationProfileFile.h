@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    CalibrationProfileFile.h
+    GRAIN — Calibration profiles on disk (JSON or compact binary).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../DSP/CalibrationConfig.h"
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+ * Reads and writes CalibrationConfig as a profile file, so calibration
+ * experiments need no rebuild.
+ *
+ * JSON profiles group values by module, using the CalibrationConfig field
+ * names; anything left out keeps its default:
+ *
+ *     { "bias": { "amount": 0.35 }, "focus": { "shelfGainDb": 2.0 } }
+ *
+ * Unknown modules or fields are errors rather than silently ignored, so a
+ * typo cannot pass for a listening-test result.
+ *
+ * Binary profiles (little-endian) are uint32 magic "GRCB", uint16 version,
+ * uint16 value count, then the float values in a fixed order. Fields are
+ * only ever appended to that order: a shorter profile leaves the newer
+ * fields at their defaults.
+ */
+namespace CalibrationProfileFile
+{
+
+constexpr juce::uint32 kMagic = 0x42435247;  // "GRCB"
+constexpr juce::uint16 kVersion = 1;
+constexpr int kHeaderBytes = 8;
+
+/**
+ * Load a JSON or binary profile (detected from its first bytes).
+ * @param file Profile to read
+ * @param result Receives the calibration (untouched on failure)
+ * @param error Receives a description of the problem on failure
+ * @return false if the file cannot be read, does not parse or holds an invalid value
+ */
+bool load(const juce::File& file, GrainDSP::CalibrationConfig& result, juce::String& error);
+
+/** Parse a JSON profile. Same contract as load(). */
+bool parseJson(const juce::String& json, GrainDSP::CalibrationConfig& result, juce::String& error);
+
+/** Parse a binary profile. Same contract as load(). */
+bool parseBinary(const void* data, size_t sizeInBytes, GrainDSP::CalibrationConfig& result, juce::String& error);
+
+/** @return Every value of a calibration as a JSON profile */
+juce::String toJson(const GrainDSP::CalibrationConfig& config);
+
+/** Replace dest with the binary profile of a calibration. */
+void writeBinary(const GrainDSP::CalibrationConfig& config, juce::MemoryBlock& dest);
+
+/**
+ * Check that a calibration gives stable filters at 44.1 kHz and above.
+ * @return false, with error set, on a non-finite value, a non-positive time,
+ *         frequency or Q, a shelf frequency above 20 kHz or a DC blocker
+ *         cutoff above 200 Hz
+ */
+bool validate(const GrainDSP::CalibrationConfig& config, juce::String& error);
+
+}  // namespace CalibrationProfileFile
@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    ParameterStateCodec.cpp
+    GRAIN — Compact binary plugin state implementation.
+
+  ==============================================================================
+*/
+
+#include "ParameterStateCodec.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+juce::AudioProcessorParameterWithID* asParameterWithId(juce::AudioProcessorParameter* parameter)
+{
+    return dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter);
+}
+
+float readFloatLittleEndian(const char* bytes)
+{
+    const auto bits = juce::ByteOrder::littleEndianInt(bytes);
+    float value = 0.0f;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+}  // namespace
+
+//==============================================================================
+juce::uint32 ParameterStateCodec::hashParameterId(const juce::String& parameterId)
+{
+    juce::uint32 hash = 2166136261u;
+
+    for (auto* c = parameterId.toRawUTF8(); *c != 0; ++c)
+    {
+        hash = (hash ^ static_cast<juce::uint8>(*c)) * 16777619u;
+    }
+
+    return hash;
+}
+
+void ParameterStateCodec::write(const juce::Array<juce::AudioProcessorParameter*>& parameters, juce::MemoryBlock& dest)
+{
+    int numRecords = 0;
+
+    for (auto* parameter : parameters)
+    {
+        numRecords += asParameterWithId(parameter) != nullptr ? 1 : 0;
+    }
+
+    dest.setSize(static_cast<size_t>(kHeaderBytes + (numRecords * kRecordBytes)));
+    juce::MemoryOutputStream stream(dest, false);
+    stream.writeInt(static_cast<int>(kMagic));
+    stream.writeShort(static_cast<short>(kVersion));
+    stream.writeShort(static_cast<short>(numRecords));
+
+    for (auto* parameter : parameters)
+    {
+        if (auto* withId = asParameterWithId(parameter))
+        {
+            stream.writeInt(static_cast<int>(hashParameterId(withId->paramID)));
+            stream.writeFloat(withId->getValue());
+        }
+    }
+}
+
+bool ParameterStateCodec::isBinaryState(const void* data, int sizeInBytes)
+{
+    return data != nullptr && sizeInBytes >= kHeaderBytes && juce::ByteOrder::littleEndianInt(data) == kMagic;
+}
+
+bool ParameterStateCodec::read(const juce::Array<juce::AudioProcessorParameter*>& parameters, const void* data,
+                               int sizeInBytes)
+{
+    if (!isBinaryState(data, sizeInBytes))
+    {
+        return false;
+    }
+
+    const auto* bytes = static_cast<const char*>(data);
+    const auto version = juce::ByteOrder::littleEndianShort(bytes + 4);
+    const auto numRecords = static_cast<int>(juce::ByteOrder::littleEndianShort(bytes + 6));
+
+    // Validate everything before the first parameter changes
+    if (version > kVersion || sizeInBytes < kHeaderBytes + (numRecords * kRecordBytes))
+    {
+        return false;
+    }
+
+    const char* records = bytes + kHeaderBytes;
+
+    for (auto* parameter : parameters)
+    {
+        auto* withId = asParameterWithId(parameter);
+
+        if (withId == nullptr)
+        {
+            continue;
+        }
+
+        const auto hash = hashParameterId(withId->paramID);
+        float value = withId->getDefaultValue();
+
+        for (int i = 0; i < numRecords; ++i)
+        {
+            const char* record = records + (i * kRecordBytes);
+
+            if (juce::ByteOrder::littleEndianInt(record) == hash)
+            {
+                const float stored = readFloatLittleEndian(record + 4);
+                value = std::isfinite(stored) ? juce::jlimit(0.0f, 1.0f, stored) : value;
+                break;
+            }
+        }
+
+        // The fast path: most of a session sits at values the parameter already has
+        if (!juce::exactlyEqual(withId->getValue(), value))
+        {
+            withId->setValueNotifyingHost(value);
+        }
+    }
+
+    return true;
+}
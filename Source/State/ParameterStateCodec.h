@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    ParameterStateCodec.h
+    GRAIN — Compact versioned binary plugin state.
+    Saved by getStateInformation(); XML states from older sessions are
+    still read by setStateInformation().
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+ * Binary plugin state: the parameter values, nothing else.
+ *
+ * Layout (little-endian):
+ *   uint32 magic "GRNB", uint16 version, uint16 record count,
+ *   then per parameter: uint32 FNV-1a hash of the parameter ID,
+ *   float normalised value.
+ *
+ * Eight bytes per parameter instead of an XML document: saving is one
+ * getValue() per parameter and restoring writes values straight into the
+ * parameters — no XML parse, no ValueTree rebuild and no replaceState().
+ * Parameters whose value is already right are skipped, so restoring a
+ * mostly-default session touches almost nothing.
+ *
+ * Records are matched by ID hash, not position, so parameters can be added
+ * or reordered: unknown records are ignored, and parameters without a
+ * record go back to their default (as a full XML restore would).
+ */
+namespace ParameterStateCodec
+{
+
+constexpr juce::uint32 kMagic = 0x424e5247;  // "GRNB"
+constexpr juce::uint16 kVersion = 1;
+constexpr int kHeaderBytes = 8;
+constexpr int kRecordBytes = 8;
+
+/** @return FNV-1a hash of a parameter ID's UTF-8 bytes. */
+juce::uint32 hashParameterId(const juce::String& parameterId);
+
+/** Replace dest with the binary state of every parameter that has an ID. */
+void write(const juce::Array<juce::AudioProcessorParameter*>& parameters, juce::MemoryBlock& dest);
+
+/** @return true if data holds a binary state (anything else is treated as a legacy XML state). */
+bool isBinaryState(const void* data, int sizeInBytes);
+
+/**
+ * Apply a binary state to the parameters (notifying the host).
+ * @return false, leaving every parameter untouched, if the data is truncated
+ *         or from a newer format version
+ */
+bool read(const juce::Array<juce::AudioProcessorParameter*>& parameters, const void* data, int sizeInBytes);
+
+}  // namespace ParameterStateCodec
@@ -0,0 +1,314 @@
+/*
+  ==============================================================================
+
+    CalibrationProfileTest.cpp
+    Tests for runtime calibration profiles and their hot swap.
+    Verifies that prepared calibrations match per-module preparation, that a
+    swap keeps filter state, the exchange's reclamation under a concurrent
+    reader, and JSON/binary profile parsing and validation.
+
+  ==============================================================================
+*/
+
+#include "../DSP/CalibrationExchange.h"
+#include "../DSP/GrainDSPPipeline.h"
+#include "../DSP/RMSDetector.h"
+#include "../State/CalibrationProfileFile.h"
+
+#include <JuceHeader.h>
+
+#include <atomic>
+#include <thread>
+
+//==============================================================================
+class CalibrationProfileTest : public juce::UnitTest
+{
+public:
+    CalibrationProfileTest() : juce::UnitTest("GRAIN Calibration Profiles") {}
+
+    void runTest() override
+    {
+        runPreparedMatchesModulesTest();
+        runSwapKeepsStateTest();
+        runExchangeTest();
+        runConcurrentExchangeTest();
+        runJsonProfileTest();
+        runInvalidProfileTest();
+        runBinaryProfileTest();
+        runLoadFileTest();
+    }
+
+private:
+    static constexpr float kSampleRate = 96000.0f;
+
+    static GrainDSP::CalibrationConfig makeAlternateCalibration()
+    {
+        auto cal = GrainDSP::kDefaultCalibration;
+        cal.rms.releaseMs = 150.0f;
+        cal.bias.amount = 0.5f;
+        cal.warmth.depth = 0.1f;
+        cal.focus.shelfGainDb = 4.0f;
+        cal.focus.highShelfFreq = 6000.0f;
+        cal.dcBlocker.cutoffHz = 8.0f;
+        return cal;
+    }
+
+    static float testSignal(int i) { return 0.7f * std::sin(0.013f * static_cast<float>(i)); }
+
+    //==========================================================================
+    void runPreparedMatchesModulesTest()
+    {
+        beginTest("Profiles: prepared calibration is bit-identical to preparing each module");
+
+        const auto cal = makeAlternateCalibration();
+        const auto prepared = GrainDSP::PreparedCalibration::create(cal, kSampleRate);
+
+        GrainDSP::RMSDetector detector;
+        detector.prepare(kSampleRate, cal.rms);
+        expectEquals(prepared.rmsAttackCoeff, detector.attackCoeff);
+        expectEquals(prepared.rmsReleaseCoeff, detector.releaseCoeff);
+
+        for (const auto mode : {GrainDSP::FocusMode::kLow, GrainDSP::FocusMode::kMid, GrainDSP::FocusMode::kHigh})
+        {
+            GrainDSP::DSPPipeline reference;
+            GrainDSP::DSPPipeline swapped;
+            reference.prepare(kSampleRate, mode, cal);
+            swapped.setCalibration(prepared, mode);
+
+            float maxDiff = 0.0f;
+
+            for (int i = 0; i < 4096; ++i)
+            {
+                const float a = reference.processSample(testSignal(i), 0.2f, 0.6f, 0.4f, 0.8f, 1.0f);
+                const float b = swapped.processSample(testSignal(i), 0.2f, 0.6f, 0.4f, 0.8f, 1.0f);
+                maxDiff = std::max(maxDiff, std::abs(a - b));
+            }
+
+            expectEquals(maxDiff, 0.0f);
+        }
+    }
+
+    void runSwapKeepsStateTest()
+    {
+        beginTest("Profiles: swapping mid-stream keeps filter state (no reset, no click)");
+
+        const auto defaults = GrainDSP::PreparedCalibration::create(GrainDSP::kDefaultCalibration, kSampleRate);
+        const auto alternate = GrainDSP::PreparedCalibration::create(makeAlternateCalibration(), kSampleRate);
+
+        GrainDSP::DSPPipeline swapped;
+        GrainDSP::DSPPipeline reference;
+        swapped.setCalibration(defaults, GrainDSP::FocusMode::kMid);
+        reference.setCalibration(defaults, GrainDSP::FocusMode::kMid);
+
+        for (int i = 0; i < 2048; ++i)
+        {
+            swapped.processSample(testSignal(i), 0.2f, 0.5f, 0.5f, 1.0f, 1.0f);
+            reference.processSample(testSignal(i), 0.2f, 0.5f, 0.5f, 1.0f, 1.0f);
+        }
+
+        // Reference: same history, new coefficients installed by a fresh prepare plus the old state
+        const auto state = reference.getState();
+        reference.prepare(kSampleRate, GrainDSP::FocusMode::kMid, makeAlternateCalibration());
+        reference.setState(state);
+        swapped.setCalibration(alternate, GrainDSP::FocusMode::kMid);
+
+        float maxDiff = 0.0f;
+
+        for (int i = 2048; i < 4096; ++i)
+        {
+            const float a = reference.processSample(testSignal(i), 0.2f, 0.5f, 0.5f, 1.0f, 1.0f);
+            const float b = swapped.processSample(testSignal(i), 0.2f, 0.5f, 0.5f, 1.0f, 1.0f);
+            maxDiff = std::max(maxDiff, std::abs(a - b));
+        }
+
+        expectEquals(maxDiff, 0.0f);
+    }
+
+    //==========================================================================
+    void runExchangeTest()
+    {
+        beginTest("Profiles: exchange keeps the reader's calibration alive until it moves on");
+
+        GrainDSP::CalibrationExchange exchange;
+        expect(exchange.acquire() == nullptr);
+
+        exchange.publish(std::make_unique<const GrainDSP::PreparedCalibration>(
+            GrainDSP::PreparedCalibration::create(GrainDSP::kDefaultCalibration, kSampleRate)));
+        const auto* first = exchange.acquire();
+        expect(first != nullptr);
+
+        // The reader still holds the first one: it is retired, not deleted
+        exchange.publish(std::make_unique<const GrainDSP::PreparedCalibration>(
+            GrainDSP::PreparedCalibration::create(makeAlternateCalibration(), kSampleRate)));
+        expectEquals(exchange.getNumRetired(), 1);
+        expectEquals(first->config.bias.amount, GrainDSP::kDefaultCalibration.bias.amount);
+
+        const auto* second = exchange.acquire();
+        expect(second != first);
+        expectEquals(second->config.bias.amount, 0.5f);
+
+        exchange.collectGarbage();
+        expectEquals(exchange.getNumRetired(), 0);
+    }
+
+    void runConcurrentExchangeTest()
+    {
+        beginTest("Profiles: a reader racing thousands of publishes only sees whole calibrations");
+
+        GrainDSP::CalibrationExchange exchange;
+        std::atomic<bool> finished{false};
+        std::atomic<int> inconsistent{0};
+        std::atomic<int> reads{0};
+
+        // Each calibration's sample rate is derived from its warmth depth, so a torn or freed
+        // object shows up as a mismatch
+        std::thread reader(
+            [&]
+            {
+                while (!finished.load())
+                {
+                    if (const auto* prepared = exchange.acquire())
+                    {
+                        if (!juce::exactlyEqual(prepared->sampleRate, prepared->config.warmth.depth * 1000.0f))
+                        {
+                            ++inconsistent;
+                        }
+
+                        ++reads;
+                    }
+                }
+            });
+
+        int maxRetired = 0;
+
+        for (int i = 1; i <= 20000; ++i)
+        {
+            auto cal = GrainDSP::kDefaultCalibration;
+            cal.warmth.depth = static_cast<float>((i % 1000) + 1) / 1000.0f;
+            exchange.publish(std::make_unique<const GrainDSP::PreparedCalibration>(
+                GrainDSP::PreparedCalibration::create(cal, cal.warmth.depth * 1000.0f)));
+            maxRetired = std::max(maxRetired, exchange.getNumRetired());
+        }
+
+        finished.store(true);
+        reader.join();
+
+        expectEquals(inconsistent.load(), 0);
+        expectGreaterThan(reads.load(), 0);
+        expectLessOrEqual(maxRetired, 1);  // Only the one the reader held at each publish
+        logMessage("Reader acquisitions during 20000 publishes: " + juce::String(reads.load()));
+    }
+
+    //==========================================================================
+    void runJsonProfileTest()
+    {
+        beginTest("Profiles: JSON overrides given fields and keeps the defaults for the rest");
+
+        GrainDSP::CalibrationConfig cal;
+        juce::String error;
+        expect(CalibrationProfileFile::parseJson(R"({ "bias": { "amount": 0.35 }, "focus": { "shelfQ": 1 } })", cal,
+                                                 error),
+               error);
+        expectWithinAbsoluteError(cal.bias.amount, 0.35f, 1.0e-6f);
+        expectEquals(cal.focus.shelfQ, 1.0f);
+        expectEquals(cal.bias.scale, GrainDSP::kDefaultCalibration.bias.scale);
+        expectEquals(cal.rms.releaseMs, GrainDSP::kDefaultCalibration.rms.releaseMs);
+
+        // Every value survives toJson() → parseJson()
+        const auto alternate = makeAlternateCalibration();
+        GrainDSP::CalibrationConfig parsed;
+        expect(CalibrationProfileFile::parseJson(CalibrationProfileFile::toJson(alternate), parsed, error), error);
+        expectEquals(parsed.rms.releaseMs, alternate.rms.releaseMs);
+        expectEquals(parsed.warmth.depth, alternate.warmth.depth);
+        expectEquals(parsed.focus.highShelfFreq, alternate.focus.highShelfFreq);
+        expectEquals(parsed.dcBlocker.cutoffHz, alternate.dcBlocker.cutoffHz);
+    }
+
+    void runInvalidProfileTest()
+    {
+        beginTest("Profiles: typos, non-numbers and unstable values are rejected without side effects");
+
+        const char* const invalid[] = {
+            R"({ "bias": { "ammount": 0.35 } })",          // Unknown field
+            R"({ "saturation": { "amount": 1 } })",        // Unknown module
+            R"({ "bias": { "amount": "0.35" } })",         // Not a number
+            R"({ "rms": { "attackMs": 0 } })",             // Zero time constant
+            R"({ "focus": { "highShelfFreq": 30000 } })",  // Above 20 kHz
+            R"({ "dcBlocker": { "cutoffHz": 30000 } })",   // Pole outside the unit circle
+            R"([ 1, 2, 3 ])",                              // Not an object
+            R"({ "bias": { "amount": )",                   // Broken JSON
+        };
+
+        for (const auto* json : invalid)
+        {
+            auto cal = makeAlternateCalibration();
+            juce::String error;
+            expect(!CalibrationProfileFile::parseJson(json, cal, error), json);
+            expect(error.isNotEmpty());
+            expectEquals(cal.bias.amount, 0.5f);
+        }
+    }
+
+    void runBinaryProfileTest()
+    {
+        beginTest("Profiles: binary round-trips, accepts shorter profiles and rejects newer ones");
+
+        const auto alternate = makeAlternateCalibration();
+        juce::MemoryBlock data;
+        CalibrationProfileFile::writeBinary(alternate, data);
+
+        GrainDSP::CalibrationConfig parsed;
+        juce::String error;
+        expect(CalibrationProfileFile::parseBinary(data.getData(), data.getSize(), parsed, error), error);
+        expectEquals(parsed.rms.releaseMs, alternate.rms.releaseMs);
+        expectEquals(parsed.focus.shelfGainDb, alternate.focus.shelfGainDb);
+        expectEquals(parsed.dcBlocker.cutoffHz, alternate.dcBlocker.cutoffHz);
+
+        // A profile from before a field was appended: the missing fields keep their defaults
+        auto shorter = data;
+        shorter[6] = 2;
+        shorter.setSize(static_cast<size_t>(CalibrationProfileFile::kHeaderBytes) + (2 * sizeof(float)));
+        expect(CalibrationProfileFile::parseBinary(shorter.getData(), shorter.getSize(), parsed, error), error);
+        expectEquals(parsed.rms.releaseMs, alternate.rms.releaseMs);
+        expectEquals(parsed.dcBlocker.cutoffHz, GrainDSP::kDefaultCalibration.dcBlocker.cutoffHz);
+
+        auto newer = data;
+        newer[4] = static_cast<char>(CalibrationProfileFile::kVersion + 1);
+        expect(!CalibrationProfileFile::parseBinary(newer.getData(), newer.getSize(), parsed, error));
+        expect(!CalibrationProfileFile::parseBinary(data.getData(), data.getSize() - 1, parsed, error));
+    }
+
+    void runLoadFileTest()
+    {
+        beginTest("Profiles: load() detects JSON and binary files");
+
+        const auto alternate = makeAlternateCalibration();
+        auto jsonFile = juce::File::createTempFile(".json");
+        auto binaryFile = juce::File::createTempFile(".grcal");
+        expect(jsonFile.replaceWithText(CalibrationProfileFile::toJson(alternate)));
+
+        juce::MemoryBlock data;
+        CalibrationProfileFile::writeBinary(alternate, data);
+        expect(binaryFile.replaceWithData(data.getData(), data.getSize()));
+
+        for (const auto& file : {jsonFile, binaryFile})
+        {
+            GrainDSP::CalibrationConfig loaded;
+            juce::String error;
+            expect(CalibrationProfileFile::load(file, loaded, error), error);
+            expectEquals(loaded.focus.highShelfFreq, alternate.focus.highShelfFreq);
+        }
+
+        GrainDSP::CalibrationConfig untouched;
+        juce::String error;
+        expect(!CalibrationProfileFile::load(jsonFile.getSiblingFile("missing.json"), untouched, error));
+        expect(error.isNotEmpty());
+
+        jsonFile.deleteFile();
+        binaryFile.deleteFile();
+    }
+};
+
+//==============================================================================
+static CalibrationProfileTest
+    calibrationProfileTest;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables,misc-use-anonymous-namespace)
@@ -3,7 +3,8 @@
 
     DragDropTest.cpp
     Unit tests for the standalone drag & drop file loading (GT-19).
-    Tests file extension filtering via AudioFileUtils::isSupportedAudioFile.
+    Tests file extension filtering via AudioFileUtils::isSupportedAudioFile
+    and reader creation via AudioFileUtils::createReader.
 
   ==============================================================================
 */
@@ -22,7 +23,9 @@ public:
     {
         runAcceptWavTest();
         runAcceptAiffTest();
+        runAcceptCompressedTest();
         runRejectUnsupportedTest();
+        runMemoryMappedReaderTest();
     }
 
 private:
@@ -47,18 +50,78 @@ private:
         expect(AudioFileUtils::isSupportedAudioFile("/path/to/FILE.AIF"), ".AIF (uppercase) should be accepted");
     }
 
+    //==========================================================================
+    void runAcceptCompressedTest()
+    {
+        beginTest("DragDrop: accepts .flac/.ogg/.mp3 files");
+
+        expect(AudioFileUtils::isSupportedAudioFile("/path/to/file.flac"), ".flac should be accepted");
+        expect(AudioFileUtils::isSupportedAudioFile("/path/to/file.ogg"), ".ogg should be accepted");
+        expect(AudioFileUtils::isSupportedAudioFile("/path/to/file.mp3"), ".mp3 should be accepted");
+        expect(AudioFileUtils::isSupportedAudioFile("/path/to/FILE.FLAC"), ".FLAC (uppercase) should be accepted");
+
+        // The file chooser offers exactly what drag & drop accepts
+        expectEquals(AudioFileUtils::getSupportedWildcard(), juce::String("*.wav;*.aiff;*.aif;*.flac;*.ogg;*.mp3"));
+    }
+
     //==========================================================================
     void runRejectUnsupportedTest()
     {
         beginTest("DragDrop: rejects unsupported file types");
 
-        expect(!AudioFileUtils::isSupportedAudioFile("/path/to/file.mp3"), ".mp3 should be rejected");
         expect(!AudioFileUtils::isSupportedAudioFile("/path/to/file.txt"), ".txt should be rejected");
-        expect(!AudioFileUtils::isSupportedAudioFile("/path/to/file.flac"), ".flac should be rejected");
-        expect(!AudioFileUtils::isSupportedAudioFile("/path/to/file.ogg"), ".ogg should be rejected");
         expect(!AudioFileUtils::isSupportedAudioFile("/path/to/file.m4a"), ".m4a should be rejected");
         expect(!AudioFileUtils::isSupportedAudioFile("/path/to/file"), "No extension should be rejected");
     }
+
+    //==========================================================================
+    void runMemoryMappedReaderTest()
+    {
+        beginTest("AudioFileUtils: WAV and AIFF readers are memory-mapped");
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        juce::WavAudioFormat wavFormat;
+        juce::AiffAudioFormat aiffFormat;
+        juce::AudioFormat* const formats[] = {&wavFormat, &aiffFormat};
+
+        juce::AudioBuffer<float> ramp(2, 1000);
+
+        for (int i = 0; i < ramp.getNumSamples(); ++i)
+        {
+            ramp.setSample(0, i, static_cast<float>(i) / 1000.0f);
+            ramp.setSample(1, i, -static_cast<float>(i) / 1000.0f);
+        }
+
+        for (auto* format : formats)
+        {
+            auto file = juce::File::createTempFile(format->getFileExtensions()[0]);
+
+            {
+                std::unique_ptr<juce::OutputStream> stream = file.createOutputStream();
+                auto options =
+                    juce::AudioFormatWriterOptions().withSampleRate(44100.0).withNumChannels(2).withBitsPerSample(24);
+                auto writer = format->createWriterFor(stream, options);
+                expect(writer != nullptr);
+                writer->writeFromAudioSampleBuffer(ramp, 0, ramp.getNumSamples());
+            }
+
+            auto reader = AudioFileUtils::createReader(formatManager, file);
+            expect(dynamic_cast<juce::MemoryMappedAudioFormatReader*>(reader.get()) != nullptr,
+                   format->getFormatName() + " should be mapped");
+
+            // Mapped reads match what was written, including a read that runs past the end
+            juce::AudioBuffer<float> read(2, 100);
+            reader->read(&read, 0, 100, 950, true, true);
+            expectWithinAbsoluteError(read.getSample(0, 0), 0.95f, 1.0e-5f);
+            expectWithinAbsoluteError(read.getSample(1, 49), -0.999f, 1.0e-5f);
+            expectEquals(read.getSample(0, 50), 0.0f);
+
+            reader.reset();
+            file.deleteFile();
+        }
+    }
 };
 
 //==============================================================================
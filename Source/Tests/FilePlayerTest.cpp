@@ -3,104 +3,17 @@
 
     FilePlayerTest.cpp
     Unit tests for the standalone FilePlayerSource (GT-15, GT-16).
-    Tests file loading, validation, metadata, thumbnail, sample rate handling,
-    and transport controls (play/stop/loop/seek).
+    Tests file loading (synchronous and asynchronous), validation, metadata,
+    thumbnail, sample rate handling, and transport controls (play/stop/loop/seek).
 
   ==============================================================================
 */
 
 #include "../Standalone/FilePlayerSource.h"
+#include "TestFixtures.h"
 
 #include <JuceHeader.h>
 
-//==============================================================================
-namespace
-{
-
-/** Create a temporary WAV file with a sine wave. */
-juce::File createTestWavFile(double sampleRate, int numChannels, double durationSeconds, float frequency = 440.0f)
-{
-    auto tempFile = juce::File::createTempFile(".wav");
-    std::unique_ptr<juce::OutputStream> outputStream = tempFile.createOutputStream();
-
-    if (outputStream == nullptr)
-    {
-        return {};
-    }
-
-    juce::WavAudioFormat wavFormat;
-    auto options =
-        juce::AudioFormatWriterOptions().withSampleRate(sampleRate).withNumChannels(numChannels).withBitsPerSample(16);
-    auto writer = wavFormat.createWriterFor(outputStream, options);
-
-    if (writer == nullptr)
-    {
-        return {};
-    }
-
-    int const totalSamples = static_cast<int>(sampleRate * durationSeconds);
-    juce::AudioBuffer<float> buffer(numChannels, totalSamples);
-
-    for (int i = 0; i < totalSamples; ++i)
-    {
-        float const sample = 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * frequency * static_cast<float>(i) /
-                                             static_cast<float>(sampleRate));
-
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            buffer.setSample(ch, i, sample);
-        }
-    }
-
-    writer->writeFromAudioSampleBuffer(buffer, 0, totalSamples);
-    writer.reset();
-
-    return tempFile;
-}
-
-/** Create a temporary AIFF file with a sine wave. */
-juce::File createTestAiffFile(double sampleRate, int numChannels, double durationSeconds, float frequency = 440.0f)
-{
-    auto tempFile = juce::File::createTempFile(".aiff");
-    std::unique_ptr<juce::OutputStream> outputStream = tempFile.createOutputStream();
-
-    if (outputStream == nullptr)
-    {
-        return {};
-    }
-
-    juce::AiffAudioFormat aiffFormat;
-    auto options =
-        juce::AudioFormatWriterOptions().withSampleRate(sampleRate).withNumChannels(numChannels).withBitsPerSample(16);
-    auto writer = aiffFormat.createWriterFor(outputStream, options);
-
-    if (writer == nullptr)
-    {
-        return {};
-    }
-
-    int const totalSamples = static_cast<int>(sampleRate * durationSeconds);
-    juce::AudioBuffer<float> buffer(numChannels, totalSamples);
-
-    for (int i = 0; i < totalSamples; ++i)
-    {
-        float const sample = 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * frequency * static_cast<float>(i) /
-                                             static_cast<float>(sampleRate));
-
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            buffer.setSample(ch, i, sample);
-        }
-    }
-
-    writer->writeFromAudioSampleBuffer(buffer, 0, totalSamples);
-    writer.reset();
-
-    return tempFile;
-}
-
-}  // namespace
-
 //==============================================================================
 class FilePlayerTest : public juce::UnitTest
 {
@@ -118,6 +31,9 @@ public:
         runSampleRateMismatchTest();
         runUnloadFileTest();
         runMetadataAccuracyTest();
+        runPreloadBudgetTest();
+        runLoadFlacTest();
+        runMultichannelDownmixTest();
 
         // GT-16: Transport tests
         runPlayStartsFromPositionZeroTest();
@@ -126,6 +42,10 @@ public:
         runSeekSetsPositionTest();
         runSeekProducesNoNanInfTest();
         runFileAudioReplacesInputTest();
+
+        // Asynchronous loading
+        runAsyncLoadSwapsInTest();
+        runAsyncLoadCancelTest();
     }
 
 private:
@@ -134,10 +54,10 @@ private:
     {
         beginTest("FilePlayer: load valid WAV file");
 
-        auto tempFile = createTestWavFile(44100.0, 2, 1.0);
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 1.0);
         expect(tempFile.existsAsFile(), "Failed to create test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         bool const loaded = player.loadFile(tempFile);
 
         expect(loaded, "loadFile returned false for valid WAV");
@@ -155,10 +75,12 @@ private:
     {
         beginTest("FilePlayer: load valid AIFF file");
 
-        auto tempFile = createTestAiffFile(48000.0, 1, 0.5);
+        juce::AiffAudioFormat aiffFormat;
+        auto tempFile =
+            TestFixtures::writeTempAudioFile(aiffFormat, TestFixtures::createSineBuffer(48000.0, 1, 0.5), 48000.0, 16);
         expect(tempFile.existsAsFile(), "Failed to create test AIFF file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         bool const loaded = player.loadFile(tempFile);
 
         expect(loaded, "loadFile returned false for valid AIFF");
@@ -178,7 +100,7 @@ private:
         auto tempFile = juce::File::createTempFile(".wav");
         tempFile.replaceWithText("this is not audio data");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         bool const loaded = player.loadFile(tempFile);
 
         expect(!loaded, "loadFile should return false for invalid file");
@@ -193,7 +115,7 @@ private:
     {
         beginTest("FilePlayer: reject non-existent file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         bool const loaded = player.loadFile(juce::File("/nonexistent/path/audio.wav"));
 
         expect(!loaded, "loadFile should return false for non-existent file");
@@ -206,10 +128,10 @@ private:
     {
         beginTest("FilePlayer: thumbnail generation completes");
 
-        auto tempFile = createTestWavFile(44100.0, 2, 0.5);
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 0.5);
         expect(tempFile.existsAsFile(), "Failed to create test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         player.loadFile(tempFile);
 
         // Poll for thumbnail completion (async generation)
@@ -227,7 +149,16 @@ private:
         }
 
         expect(ready, "Thumbnail did not finish generating within 1 second");
-        expect(player.getThumbnail().getTotalLength() > 0.0, "Thumbnail has zero length");
+        expectEquals(player.getThumbnail().getTotalSamples(), player.getFileLengthInSamples());
+
+        // The top level summarises the whole 0.5-amplitude sine
+        auto const& thumbnail = player.getThumbnail();
+        GrainDSP::PeakPyramid::Bucket whole;
+        expect(thumbnail.getRange(thumbnail.getNumLevels() - 1, 0, thumbnail.getTotalSamples(),
+                                  player.getThumbnailSamplesReady(), whole),
+               "Thumbnail has no data");
+        expectWithinAbsoluteError(whole.maxVal, 0.5f, 0.01f);
+        expectWithinAbsoluteError(whole.minVal, -0.5f, 0.01f);
 
         tempFile.deleteFile();
     }
@@ -237,10 +168,10 @@ private:
     {
         beginTest("FilePlayer: sample rate mismatch handling");
 
-        auto tempFile = createTestWavFile(96000.0, 2, 0.5);
+        auto tempFile = TestFixtures::createSineWavFile(96000.0, 2, 0.5);
         expect(tempFile.existsAsFile(), "Failed to create 96kHz test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         bool const loaded = player.loadFile(tempFile);
 
         expect(loaded, "loadFile should succeed for 96kHz file");
@@ -259,10 +190,10 @@ private:
     {
         beginTest("FilePlayer: unload resets state");
 
-        auto tempFile = createTestWavFile(44100.0, 2, 1.0);
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 1.0);
         expect(tempFile.existsAsFile(), "Failed to create test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         player.loadFile(tempFile);
         expect(player.isFileLoaded(), "File should be loaded");
 
@@ -282,10 +213,10 @@ private:
     {
         beginTest("FilePlayer: metadata accuracy");
 
-        auto tempFile = createTestWavFile(44100.0, 2, 2.0);
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 2.0);
         expect(tempFile.existsAsFile(), "Failed to create test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         player.loadFile(tempFile);
 
         expectEquals(player.getFileLengthInSamples(), static_cast<juce::int64>(88200));
@@ -297,15 +228,134 @@ private:
 
     //==========================================================================
     // GT-16: Transport tests
+    //==========================================================================
+    void runPreloadBudgetTest()
+    {
+        beginTest("FilePlayer: files within the preload budget play from memory");
+
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 1.0, 441.0f);
+
+        FilePlayerSource streaming(TestFixtures::getPeakCacheDirectory());
+        streaming.setPreloadBudget(0);
+        expect(streaming.loadFile(tempFile));
+        expect(!streaming.isPreloaded(), "Budget 0 streams");
+
+        // 1 s of 32-bit stereo needs 352800 bytes
+        FilePlayerSource preloaded(TestFixtures::getPeakCacheDirectory());
+        preloaded.setPreloadBudget(352800);
+        expect(preloaded.loadFile(tempFile));
+        expect(preloaded.isPreloaded(), "Fits the budget exactly");
+        preloaded.prepareToPlay(44100.0, 512);
+
+        // A seek is served from memory on the very next block, sample-accurately
+        preloaded.seekToPosition(0.5);
+        preloaded.play();
+
+        juce::AudioBuffer<float> buffer(2, 512);
+        juce::AudioSourceChannelInfo const channelInfo(&buffer, 0, 512);
+        preloaded.getNextAudioBlock(channelInfo);
+
+        float maxError = 0.0f;
+
+        for (int i = 0; i < 512; ++i)
+        {
+            const float expected = 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 441.0f *
+                                                   static_cast<float>(22050 + i) / 44100.0f);
+            maxError = std::max(maxError, std::abs(buffer.getSample(0, i) - expected));
+        }
+
+        expect(maxError < 1.0e-3f, "Preloaded audio after seek differs by " + juce::String(maxError));
+
+        preloaded.stop();
+        preloaded.releaseResources();
+        tempFile.deleteFile();
+    }
+
+    //==========================================================================
+    void runLoadFlacTest()
+    {
+        beginTest("FilePlayer: load FLAC file");
+
+        auto tempFile = juce::File::createTempFile(".flac");
+
+        {
+            std::unique_ptr<juce::OutputStream> outputStream = tempFile.createOutputStream();
+            juce::FlacAudioFormat flacFormat;
+            auto options =
+                juce::AudioFormatWriterOptions().withSampleRate(48000.0).withNumChannels(2).withBitsPerSample(16);
+            auto writer = flacFormat.createWriterFor(outputStream, options);
+            expect(writer != nullptr, "FLAC writer available");
+
+            juce::AudioBuffer<float> buffer(2, 24000);
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(0), 0.25f, 24000);
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(1), -0.25f, 24000);
+            writer->writeFromAudioSampleBuffer(buffer, 0, 24000);
+        }
+
+        // Streamed, so the decode runs on the read-ahead thread
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
+        player.setPreloadBudget(0);
+        player.prepareToPlay(48000.0, 512);
+        expect(player.loadFile(tempFile), "FLAC should load: " + player.getLastError());
+        expectEquals(player.getFileLengthInSamples(), static_cast<juce::int64>(24000));
+        expectEquals(player.getFileNumChannels(), 2);
+
+        player.play();
+        juce::AudioBuffer<float> block(2, 512);
+        juce::AudioSourceChannelInfo const channelInfo(&block, 0, 512);
+        player.getNextAudioBlock(channelInfo);
+        expectWithinAbsoluteError(block.getSample(0, 100), 0.25f, 1.0e-3f);
+        expectWithinAbsoluteError(block.getSample(1, 100), -0.25f, 1.0e-3f);
+
+        player.stop();
+        player.releaseResources();
+        tempFile.deleteFile();
+    }
+
+    //==========================================================================
+    void runMultichannelDownmixTest()
+    {
+        beginTest("FilePlayer: 5.1 files play as a stereo downmix");
+
+        // L, R, C, LFE, Ls, Rs
+        auto tempFile = TestFixtures::writeTempWavFile(
+            TestFixtures::createConstantBuffer({0.1f, 0.2f, 0.3f, 0.9f, 0.05f, 0.06f}, 44100), 44100.0);
+        const float g = 0.70710678f;
+        const float expectedLeft = 0.1f + (g * 0.3f) + (g * 0.05f);
+        const float expectedRight = 0.2f + (g * 0.3f) + (g * 0.06f);
+
+        for (const juce::int64 budget : {FilePlayerSource::kDefaultPreloadBudgetBytes, juce::int64{0}})
+        {
+            FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
+            player.setPreloadBudget(budget);
+            player.prepareToPlay(44100.0, 512);
+            expect(player.loadFile(tempFile), "Multichannel file should load: " + player.getLastError());
+            expectEquals(player.getFileNumChannels(), 6);
+            expect(player.isPreloaded() == (budget > 0));
+
+            player.play();
+            juce::AudioBuffer<float> block(2, 512);
+            juce::AudioSourceChannelInfo const channelInfo(&block, 0, 512);
+            player.getNextAudioBlock(channelInfo);
+            expectWithinAbsoluteError(block.getSample(0, 100), expectedLeft, 1.0e-5f);
+            expectWithinAbsoluteError(block.getSample(1, 100), expectedRight, 1.0e-5f);
+
+            player.stop();
+            player.releaseResources();
+        }
+
+        tempFile.deleteFile();
+    }
+
     //==========================================================================
     void runPlayStartsFromPositionZeroTest()
     {
         beginTest("Transport: play starts from position 0");
 
-        auto tempFile = createTestWavFile(44100.0, 2, 1.0);
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 1.0);
         expect(tempFile.existsAsFile(), "Failed to create test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         player.loadFile(tempFile);
         player.prepareToPlay(44100.0, 512);
 
@@ -327,10 +377,10 @@ private:
     {
         beginTest("Transport: stop pauses at current position");
 
-        auto tempFile = createTestWavFile(44100.0, 2, 2.0);
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 2.0);
         expect(tempFile.existsAsFile(), "Failed to create test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         player.loadFile(tempFile);
         player.prepareToPlay(44100.0, 512);
 
@@ -359,10 +409,10 @@ private:
     {
         beginTest("Transport: loop mode setting");
 
-        auto tempFile = createTestWavFile(44100.0, 2, 0.5);
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 0.5);
         expect(tempFile.existsAsFile(), "Failed to create test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         player.loadFile(tempFile);
         player.prepareToPlay(44100.0, 512);
 
@@ -386,10 +436,10 @@ private:
     {
         beginTest("Transport: seek sets position correctly");
 
-        auto tempFile = createTestWavFile(44100.0, 2, 2.0);
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 2.0);
         expect(tempFile.existsAsFile(), "Failed to create test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         player.loadFile(tempFile);
         player.prepareToPlay(44100.0, 512);
 
@@ -418,10 +468,10 @@ private:
     {
         beginTest("Transport: seek produces no NaN/Inf in output");
 
-        auto tempFile = createTestWavFile(44100.0, 2, 1.0);
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 1.0);
         expect(tempFile.existsAsFile(), "Failed to create test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         player.loadFile(tempFile);
         player.prepareToPlay(44100.0, 512);
 
@@ -461,10 +511,10 @@ private:
     {
         beginTest("Transport: file audio replaces device input (not silence)");
 
-        auto tempFile = createTestWavFile(44100.0, 2, 1.0, 440.0f);
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 1.0, 440.0f);
         expect(tempFile.existsAsFile(), "Failed to create test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         player.loadFile(tempFile);
         player.prepareToPlay(44100.0, 512);
 
@@ -484,6 +534,98 @@ private:
         player.releaseResources();
         tempFile.deleteFile();
     }
+
+    //==========================================================================
+    /** Records fileLoadFinished() callbacks. */
+    struct LoadListener : public FilePlayerSource::Listener
+    {
+        void transportStateChanged(bool) override {}
+        void transportReachedEnd() override {}
+        void fileLoadFinished(bool success) override { results.add(success); }
+
+        juce::Array<bool> results;
+    };
+
+    void runAsyncLoadSwapsInTest()
+    {
+        beginTest("Async load: previous file plays until the new one is swapped in");
+
+        auto firstFile = TestFixtures::createSineWavFile(44100.0, 2, 1.0);
+        auto secondFile = TestFixtures::createSineWavFile(48000.0, 1, 2.0);
+
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
+        LoadListener listener;
+        player.addListener(&listener);
+        player.prepareToPlay(44100.0, 512);
+        expect(player.loadFile(firstFile));
+        player.play();
+
+        player.loadFileAsync(secondFile);
+        expect(player.isLoading(), "Request pending");
+
+        // Until the swap is delivered on the message thread the old file keeps playing
+        juce::AudioBuffer<float> buffer(2, 512);
+        juce::AudioSourceChannelInfo const channelInfo(&buffer, 0, 512);
+        player.getNextAudioBlock(channelInfo);
+        expect(buffer.getRMSLevel(0, 0, 512) > 0.01f, "Previous file still audible");
+        expect(player.getLoadedFile() == firstFile);
+
+        expect(player.waitForLoad(10000), "Load finishes");
+        expect(!player.isLoading());
+        expectEquals(listener.results.size(), 1);
+        expect(listener.results.getFirst(), "Load reported success");
+
+        expect(player.getLoadedFile() == secondFile);
+        expectEquals(player.getFileSampleRate(), 48000.0);
+        expectEquals(player.getFileNumChannels(), 1);
+        expect(!player.isPlaying(), "New file starts stopped");
+
+        // The new chain was primed at the device rate and plays straight away
+        player.play();
+        buffer.clear();
+        player.getNextAudioBlock(channelInfo);
+        expect(buffer.getRMSLevel(0, 0, 512) > 0.01f, "New file audible");
+
+        player.stop();
+        player.removeListener(&listener);
+        player.releaseResources();
+        firstFile.deleteFile();
+        secondFile.deleteFile();
+    }
+
+    void runAsyncLoadCancelTest()
+    {
+        beginTest("Async load: cancelled and failed loads keep the current file");
+
+        auto firstFile = TestFixtures::createSineWavFile(44100.0, 2, 1.0);
+        auto secondFile = TestFixtures::createSineWavFile(44100.0, 2, 1.0);
+
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
+        LoadListener listener;
+        player.addListener(&listener);
+        expect(player.loadFile(firstFile));
+
+        player.loadFileAsync(secondFile);
+        player.cancelLoad();
+        expect(!player.isLoading());
+        expect(player.waitForLoad(10000));
+        expect(player.getLoadedFile() == firstFile);
+
+        // A newer request supersedes an older one: only the newest is reported and installed
+        player.loadFileAsync(secondFile);
+        player.loadFileAsync(juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("missing.wav"));
+        expect(player.waitForLoad(10000));
+        expect(player.getLoadedFile() == firstFile);
+        expect(player.getLastError().startsWith("File not found"), "Failure explained");
+
+        expectEquals(listener.results.size(), 2);
+        expect(!listener.results[0], "Cancel reported");
+        expect(!listener.results[1], "Failure reported");
+
+        player.removeListener(&listener);
+        firstFile.deleteFile();
+        secondFile.deleteFile();
+    }
 };
 
 //==============================================================================
@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    HarmonicAnalyzerTest.cpp
+    Unit tests for the background HarmonicAnalyzer.
+    Feeds synthetic signals with known harmonic content straight into
+    analyseWindow() and checks THD, even/odd balance and the difference
+    spectrum.
+
+  ==============================================================================
+*/
+
+#include "../Metering/HarmonicAnalyzer.h"
+
+#include <JuceHeader.h>
+
+//==============================================================================
+class HarmonicAnalyzerTest : public juce::UnitTest
+{
+public:
+    HarmonicAnalyzerTest() : juce::UnitTest("GRAIN Harmonic Analyzer") {}
+
+    void runTest() override
+    {
+        runSilenceTest();
+        runPureSineTest();
+        runKnownHarmonicsTest();
+        runDifferenceSpectrumTest();
+        runPushWithoutThreadTest();
+    }
+
+private:
+    static constexpr double kSampleRate = 48000.0;
+    static constexpr float kFundamentalHz = 1000.0f;
+
+    /** Sum of harmonics: amplitudes[0] is the fundamental, amplitudes[1] the 2nd harmonic, ... */
+    static std::vector<float> makeSignal(std::initializer_list<float> amplitudes)
+    {
+        std::vector<float> signal(static_cast<size_t>(HarmonicAnalyzer::kFftSize), 0.0f);
+        const float w = juce::MathConstants<float>::twoPi * kFundamentalHz / static_cast<float>(kSampleRate);
+
+        for (size_t i = 0; i < signal.size(); ++i)
+        {
+            int harmonic = 1;
+            for (const float amplitude : amplitudes)
+            {
+                signal[i] += amplitude * std::sin(w * static_cast<float>(harmonic) * static_cast<float>(i));
+                ++harmonic;
+            }
+        }
+
+        return signal;
+    }
+
+    //==========================================================================
+    void runSilenceTest()
+    {
+        beginTest("Harmonic Analyzer: silence is not analysed");
+
+        HarmonicAnalyzer analyzer;
+        analyzer.prepare(kSampleRate);
+
+        const std::vector<float> silence(static_cast<size_t>(HarmonicAnalyzer::kFftSize), 0.0f);
+        analyzer.analyseWindow(silence.data(), silence.data());
+
+        const auto result = analyzer.getLatestResult();
+        expect(!result.valid, "Silence should not produce a valid result");
+        expectEquals(static_cast<int>(result.sequence), 1, "Result should still be published");
+    }
+
+    //==========================================================================
+    void runPureSineTest()
+    {
+        beginTest("Harmonic Analyzer: pure sine has negligible THD");
+
+        HarmonicAnalyzer analyzer;
+        analyzer.prepare(kSampleRate);
+
+        const auto sine = makeSignal({0.5f});
+        analyzer.analyseWindow(sine.data(), sine.data());
+
+        const auto result = analyzer.getLatestResult();
+        expect(result.valid);
+        expectWithinAbsoluteError(result.fundamentalHz, kFundamentalHz, 2.0f);
+        expectLessThan(result.thdPercent, 0.05f);
+    }
+
+    //==========================================================================
+    void runKnownHarmonicsTest()
+    {
+        beginTest("Harmonic Analyzer: THD and even/odd ratio match known content");
+
+        HarmonicAnalyzer analyzer;
+        analyzer.prepare(kSampleRate);
+
+        // 2nd at -20 dB, 3rd at -26 dB relative to the fundamental
+        const auto dry = makeSignal({0.5f});
+        const auto output = makeSignal({0.5f, 0.05f, 0.025f});
+        analyzer.analyseWindow(dry.data(), output.data());
+
+        const auto result = analyzer.getLatestResult();
+        const float expectedThd = 100.0f * std::sqrt(0.05f * 0.05f + 0.025f * 0.025f) / 0.5f;  // ≈ 11.18 %
+        const float expectedEvenOdd = 20.0f * std::log10(0.05f / 0.025f);                      // ≈ +6.02 dB
+
+        expect(result.valid);
+        expectWithinAbsoluteError(result.thdPercent, expectedThd, 0.3f);
+        expectWithinAbsoluteError(result.evenOddRatioDb, expectedEvenOdd, 0.3f);
+    }
+
+    //==========================================================================
+    void runDifferenceSpectrumTest()
+    {
+        beginTest("Harmonic Analyzer: difference spectrum shows added harmonics only");
+
+        HarmonicAnalyzer analyzer;
+        analyzer.prepare(kSampleRate);
+
+        const auto dry = makeSignal({0.5f});
+        const auto output = makeSignal({0.5f, 0.05f});
+        analyzer.analyseWindow(dry.data(), output.data());
+
+        const auto result = analyzer.getLatestResult();
+
+        // Locate the bands holding the fundamental and the 2nd harmonic (same spacing as the analyzer)
+        const auto nyquist = static_cast<float>(kSampleRate * 0.5);
+        const auto bandOf = [nyquist](float hz)
+        {
+            const float position = std::log(hz / 20.0f) / std::log(nyquist / 20.0f);
+            return static_cast<size_t>(position * static_cast<float>(HarmonicAnalyzer::kNumBands));
+        };
+
+        expectWithinAbsoluteError(result.differenceDb[bandOf(kFundamentalHz)], 0.0f, 0.5f,
+                                  "Fundamental band should be unchanged");
+        expectGreaterThan(result.differenceDb[bandOf(2.0f * kFundamentalHz)], 20.0f,
+                          "2nd harmonic band should rise well above the dry signal");
+    }
+
+    //==========================================================================
+    void runPushWithoutThreadTest()
+    {
+        beginTest("Harmonic Analyzer: pushing with no analysis thread drops blocks safely");
+
+        HarmonicAnalyzer analyzer;
+        analyzer.prepare(kSampleRate);
+        expect(!analyzer.isEnabled(), "Thread should not run until enabled");
+
+        // Far more than the FIFO holds — excess blocks must be dropped, not overrun
+        const std::vector<float> block(512, 0.25f);
+        for (int i = 0; i < 64; ++i)
+        {
+            analyzer.pushSamples(block.data(), block.data(), static_cast<int>(block.size()));
+        }
+
+        expectEquals(static_cast<int>(analyzer.getLatestResult().sequence), 0, "Nothing analysed without the thread");
+    }
+};
+
+//==============================================================================
+static HarmonicAnalyzerTest
+    harmonicAnalyzerTest;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables,misc-use-anonymous-namespace)
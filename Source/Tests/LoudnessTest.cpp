@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    LoudnessTest.cpp
+    Unit tests for the BS.1770 loudness meter.
+    Checks calibration against EBU Tech 3341 style sine references, gating
+    behaviour and block-size independence.
+
+  ==============================================================================
+*/
+
+#include "../DSP/LoudnessMeter.h"
+
+#include <JuceHeader.h>
+
+//==============================================================================
+class LoudnessTest : public juce::UnitTest
+{
+public:
+    LoudnessTest() : juce::UnitTest("GRAIN Loudness") {}
+
+    void runTest() override
+    {
+        runStereoCalibrationTest();
+        runOtherSampleRateTest();
+        runMonoTest();
+        runAbsoluteGateTest();
+        runRelativeGateTest();
+        runBlockSizeIndependenceTest();
+    }
+
+private:
+    static constexpr float kToleranceLu = 0.1f;
+
+    /** Feed `seconds` of a 1 kHz sine at `dbfs` (peak) on both channels, in blocks of `blockSize`. */
+    static void feedSine(GrainDSP::LoudnessMeter& meter, double sampleRate, float dbfs, double seconds,
+                         bool stereo = true, int blockSize = 512)
+    {
+        const float amplitude = std::pow(10.0f, dbfs / 20.0f);
+        const auto total = static_cast<int>(sampleRate * seconds);
+        std::vector<float> block(static_cast<size_t>(blockSize));
+
+        for (int start = 0; start < total; start += blockSize)
+        {
+            const int n = std::min(blockSize, total - start);
+            for (int i = 0; i < n; ++i)
+            {
+                const double t = static_cast<double>(start + i) / sampleRate;
+                block[static_cast<size_t>(i)] =
+                    amplitude * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * 1000.0 * t));
+            }
+
+            meter.process(block.data(), stereo ? block.data() : nullptr, n);
+        }
+    }
+
+    //==========================================================================
+    void runStereoCalibrationTest()
+    {
+        beginTest("Loudness: stereo 1 kHz sine at -23 dBFS reads -23 LUFS");
+
+        GrainDSP::LoudnessMeter meter;
+        meter.prepare(48000.0);
+        feedSine(meter, 48000.0, -23.0f, 5.0);
+
+        expectWithinAbsoluteError(meter.getMomentaryLufs(), -23.0f, kToleranceLu);
+        expectWithinAbsoluteError(meter.getShortTermLufs(), -23.0f, kToleranceLu);
+        expectWithinAbsoluteError(meter.getIntegratedLufs(), -23.0f, kToleranceLu);
+    }
+
+    //==========================================================================
+    void runOtherSampleRateTest()
+    {
+        beginTest("Loudness: calibration holds at 44.1 kHz");
+
+        GrainDSP::LoudnessMeter meter;
+        meter.prepare(44100.0);
+        feedSine(meter, 44100.0, -23.0f, 5.0);
+
+        expectWithinAbsoluteError(meter.getIntegratedLufs(), -23.0f, kToleranceLu);
+    }
+
+    //==========================================================================
+    void runMonoTest()
+    {
+        beginTest("Loudness: mono input sums one channel (-3 LU vs dual mono)");
+
+        GrainDSP::LoudnessMeter meter;
+        meter.prepare(48000.0);
+        feedSine(meter, 48000.0, -23.0f, 5.0, false);
+
+        expectWithinAbsoluteError(meter.getIntegratedLufs(), -26.01f, kToleranceLu);
+    }
+
+    //==========================================================================
+    void runAbsoluteGateTest()
+    {
+        beginTest("Loudness: blocks below -70 LUFS do not pull integrated down");
+
+        GrainDSP::LoudnessMeter meter;
+        meter.prepare(48000.0);
+        feedSine(meter, 48000.0, -20.0f, 10.0);
+        feedSine(meter, 48000.0, -90.0f, 10.0);
+
+        expectWithinAbsoluteError(meter.getIntegratedLufs(), -20.0f, kToleranceLu);
+        expectLessThan(meter.getShortTermLufs(), -70.0f, "Short-term follows the quiet section");
+    }
+
+    //==========================================================================
+    void runRelativeGateTest()
+    {
+        beginTest("Loudness: relative gate drops blocks more than 10 LU below");
+
+        // EBU Tech 3341 case 3: 10 s at -36, 60 s at -23, 10 s at -36 → -23 LUFS
+        GrainDSP::LoudnessMeter meter;
+        meter.prepare(48000.0);
+        feedSine(meter, 48000.0, -36.0f, 10.0);
+        feedSine(meter, 48000.0, -23.0f, 60.0);
+        feedSine(meter, 48000.0, -36.0f, 10.0);
+
+        expectWithinAbsoluteError(meter.getIntegratedLufs(), -23.0f, kToleranceLu);
+
+        meter.resetIntegrated();
+        expectEquals(meter.getIntegratedLufs(), GrainDSP::LoudnessMeter::kSilenceLufs);
+    }
+
+    //==========================================================================
+    void runBlockSizeIndependenceTest()
+    {
+        beginTest("Loudness: readings do not depend on host block size");
+
+        GrainDSP::LoudnessMeter small;
+        small.prepare(48000.0);
+        feedSine(small, 48000.0, -18.0f, 4.0, true, 64);
+
+        GrainDSP::LoudnessMeter large;
+        large.prepare(48000.0);
+        feedSine(large, 48000.0, -18.0f, 4.0, true, 4096);
+
+        expectWithinAbsoluteError(small.getShortTermLufs(), large.getShortTermLufs(), 0.01f);
+        expectWithinAbsoluteError(small.getIntegratedLufs(), large.getIntegratedLufs(), 0.01f);
+    }
+};
+
+//==============================================================================
+static LoudnessTest
+    loudnessTest;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables,misc-use-anonymous-namespace)
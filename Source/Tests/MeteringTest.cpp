@@ -0,0 +1,311 @@
+/*
+  ==============================================================================
+
+    MeteringTest.cpp
+    Unit tests for the subscription-based MeterHub and the true-peak detector.
+    Tests mask aggregation, subscription lifetime, multi-block peak
+    aggregation at the subscriber rate, inter-sample peak detection and
+    the true-peak max-hold.
+
+  ==============================================================================
+*/
+
+#include "../DSP/TruePeakDetector.h"
+#include "../Metering/MeterHub.h"
+
+#include <JuceHeader.h>
+
+//==============================================================================
+class MeteringTest : public juce::UnitTest
+{
+public:
+    MeteringTest() : juce::UnitTest("GRAIN Metering") {}
+
+    void runTest() override
+    {
+        runNoSubscribersTest();
+        runSubscriptionLifetimeTest();
+        runCombinedMaskTest();
+        runAggregationTest();
+        runMoveSubscriptionTest();
+        runTruePeakSilenceTest();
+        runTruePeakInterSampleTest();
+        runTruePeakBlockSplitTest();
+        runTruePeakHoldTest();
+        runActiveMetersCallbackTest();
+        runLoudnessPublishTest();
+    }
+
+private:
+    //==========================================================================
+    void runNoSubscribersTest()
+    {
+        beginTest("Metering: no subscribers means empty mask");
+
+        MeterHub hub;
+        hub.prepare(48000.0);
+
+        expectEquals(static_cast<int>(hub.getActiveMask()), static_cast<int>(MeterHub::kNone));
+        expectEquals(hub.getPeak(MeterHub::Point::kInput, 0), 0.0f);
+        expectEquals(hub.getPeak(MeterHub::Point::kOutput, 1), 0.0f);
+    }
+
+    //==========================================================================
+    void runSubscriptionLifetimeTest()
+    {
+        beginTest("Metering: subscription sets mask, reset clears it");
+
+        MeterHub hub;
+        hub.prepare(48000.0);
+
+        {
+            auto sub = hub.subscribe(MeterHub::kInputPeak, 30.0);
+            expect(sub.isActive(), "Subscription should be active");
+            expectEquals(static_cast<int>(hub.getActiveMask()), static_cast<int>(MeterHub::kInputPeak));
+        }
+
+        expectEquals(static_cast<int>(hub.getActiveMask()), static_cast<int>(MeterHub::kNone));
+
+        auto sub = hub.subscribe(MeterHub::kOutputPeak, 30.0);
+        sub.reset();
+        expect(!sub.isActive(), "Reset subscription should be inactive");
+        expectEquals(static_cast<int>(hub.getActiveMask()), static_cast<int>(MeterHub::kNone));
+    }
+
+    //==========================================================================
+    void runCombinedMaskTest()
+    {
+        beginTest("Metering: mask is the union of all subscriptions");
+
+        MeterHub hub;
+        hub.prepare(48000.0);
+
+        auto inputSub = hub.subscribe(MeterHub::kInputPeak, 20.0);
+        auto outputSub = hub.subscribe(MeterHub::kOutputPeak, 30.0);
+
+        expectEquals(static_cast<int>(hub.getActiveMask()),
+                     static_cast<int>(MeterHub::kInputPeak | MeterHub::kOutputPeak));
+
+        inputSub.reset();
+        expectEquals(static_cast<int>(hub.getActiveMask()), static_cast<int>(MeterHub::kOutputPeak));
+    }
+
+    //==========================================================================
+    void runAggregationTest()
+    {
+        beginTest("Metering: peaks aggregate across blocks until the subscriber interval");
+
+        MeterHub hub;
+        hub.prepare(48000.0);
+
+        // 30 Hz at 48 kHz → publish every 1600 samples (4 blocks of 512)
+        auto sub = hub.subscribe(MeterHub::kOutputPeak, 30.0);
+
+        const float blockPeaks[] = {0.2f, 0.9f, 0.4f, 0.1f};
+        int publishCount = 0;
+
+        for (int block = 0; block < 4; ++block)
+        {
+            hub.accumulatePeak(MeterHub::Point::kOutput, 0, blockPeaks[block]);
+
+            if (hub.endBlock(512))
+            {
+                ++publishCount;
+                expectEquals(block, 3, "Should publish on the 4th block");
+            }
+            else
+            {
+                expectEquals(hub.getPeak(MeterHub::Point::kOutput, 0), 0.0f, "Nothing published before interval");
+            }
+        }
+
+        expectEquals(publishCount, 1);
+        expectEquals(hub.getPeak(MeterHub::Point::kOutput, 0), 0.9f, "Published value is the max over the window");
+
+        // Next window starts fresh
+        hub.accumulatePeak(MeterHub::Point::kOutput, 0, 0.3f);
+        hub.endBlock(1600);
+        expectEquals(hub.getPeak(MeterHub::Point::kOutput, 0), 0.3f);
+    }
+
+    //==========================================================================
+    void runMoveSubscriptionTest()
+    {
+        beginTest("Metering: moved subscription keeps the meter alive");
+
+        MeterHub hub;
+        hub.prepare(44100.0);
+
+        MeterHub::Subscription kept;
+        {
+            auto temp = hub.subscribe(MeterHub::kInputPeak);
+            kept = std::move(temp);
+        }
+
+        expect(kept.isActive(), "Moved-to subscription should be active");
+        expectEquals(static_cast<int>(hub.getActiveMask()), static_cast<int>(MeterHub::kInputPeak));
+
+        kept.reset();
+        expectEquals(static_cast<int>(hub.getActiveMask()), static_cast<int>(MeterHub::kNone));
+    }
+
+    //==========================================================================
+    void runTruePeakSilenceTest()
+    {
+        beginTest("Metering: true peak of silence is zero");
+
+        GrainDSP::TruePeakDetector detector;
+        detector.prepare(512);
+
+        const std::vector<float> silence(512, 0.0f);
+        expectEquals(detector.processBlock(silence.data(), 512), 0.0f);
+        expectEquals(GrainDSP::TruePeakDetector::toDecibels(0.0f), -120.0f);
+    }
+
+    //==========================================================================
+    void runTruePeakInterSampleTest()
+    {
+        beginTest("Metering: true peak finds inter-sample peaks missed by sample peak");
+
+        // fs/4 sine at 45° phase: every sample lands on ±0.707, the waveform peaks at 1.0
+        constexpr int kNumSamples = 4096;
+        std::vector<float> signal(kNumSamples);
+        for (int i = 0; i < kNumSamples; ++i)
+        {
+            signal[static_cast<size_t>(i)] = std::sin(juce::MathConstants<float>::halfPi * static_cast<float>(i) +
+                                                      juce::MathConstants<float>::pi * 0.25f);
+        }
+
+        float samplePeak = 0.0f;
+        for (const float s : signal)
+        {
+            samplePeak = std::max(samplePeak, std::abs(s));
+        }
+
+        GrainDSP::TruePeakDetector detector;
+        detector.prepare(kNumSamples);
+        const float truePeak = detector.processBlock(signal.data(), kNumSamples);
+
+        expectWithinAbsoluteError(samplePeak, 0.7071f, 0.001f, "Sample peak should miss the crest");
+        expectWithinAbsoluteError(truePeak, 1.0f, 0.05f, "True peak should recover the crest (~0 dBTP)");
+    }
+
+    //==========================================================================
+    void runTruePeakBlockSplitTest()
+    {
+        beginTest("Metering: true peak is independent of block size");
+
+        constexpr int kNumSamples = 2048;
+        std::vector<float> signal(kNumSamples);
+        juce::Random random(1234);
+        for (auto& s : signal)
+        {
+            s = random.nextFloat() * 2.0f - 1.0f;
+        }
+
+        GrainDSP::TruePeakDetector whole;
+        whole.prepare(kNumSamples);
+        const float wholePeak = whole.processBlock(signal.data(), kNumSamples);
+
+        // Prepared for 256 but fed odd-sized blocks (including ones larger than capacity)
+        GrainDSP::TruePeakDetector split;
+        split.prepare(256);
+        float splitPeak = 0.0f;
+        const int blockSizes[] = {1, 77, 256, 300, 511, 903};
+        int offset = 0;
+        for (const int size : blockSizes)
+        {
+            splitPeak = std::max(splitPeak, split.processBlock(signal.data() + offset, size));
+            offset += size;
+        }
+
+        expectEquals(offset, kNumSamples);
+        expectWithinAbsoluteError(splitPeak, wholePeak, 1.0e-6f);
+    }
+
+    //==========================================================================
+    void runTruePeakHoldTest()
+    {
+        beginTest("Metering: true-peak hold keeps the maximum until reset");
+
+        MeterHub hub;
+        hub.prepare(48000.0);
+        auto sub = hub.subscribe(MeterHub::kTruePeak, 30.0);
+
+        hub.accumulatePeak(MeterHub::Point::kOutputTruePeak, 0, 0.8f);
+        hub.endBlock(1600);
+        hub.accumulatePeak(MeterHub::Point::kOutputTruePeak, 0, 0.3f);
+        hub.endBlock(1600);
+
+        expectEquals(hub.getPeak(MeterHub::Point::kOutputTruePeak, 0), 0.3f, "Published value follows the window");
+        expectEquals(hub.getTruePeakHold(0), 0.8f, "Hold keeps the highest value");
+
+        // Reset is applied by the audio side on the next publish
+        hub.resetTruePeakHold();
+        expectEquals(hub.getTruePeakHold(0), 0.8f, "Reset is deferred until the next publish");
+
+        hub.accumulatePeak(MeterHub::Point::kOutputTruePeak, 0, 0.2f);
+        hub.endBlock(1600);
+        expectEquals(hub.getTruePeakHold(0), 0.2f, "Hold restarts from the current window after reset");
+    }
+
+    //==========================================================================
+    void runActiveMetersCallbackTest()
+    {
+        beginTest("Metering: mask-change callback fires only when the mask changes");
+
+        MeterHub hub;
+        hub.prepare(48000.0);
+
+        int callCount = 0;
+        juce::uint32 lastMask = MeterHub::kNone;
+        hub.onActiveMetersChanged = [&](juce::uint32 mask)
+        {
+            ++callCount;
+            lastMask = mask;
+        };
+
+        auto first = hub.subscribe(MeterHub::kAnalysis);
+        expectEquals(callCount, 1);
+        expectEquals(static_cast<int>(lastMask), static_cast<int>(MeterHub::kAnalysis));
+
+        // Same meter again: mask unchanged, no callback
+        auto second = hub.subscribe(MeterHub::kAnalysis);
+        expectEquals(callCount, 1);
+
+        first.reset();
+        expectEquals(callCount, 1, "Mask still held by the second subscription");
+
+        second.reset();
+        expectEquals(callCount, 2);
+        expectEquals(static_cast<int>(lastMask), static_cast<int>(MeterHub::kNone));
+    }
+
+    //==========================================================================
+    void runLoudnessPublishTest()
+    {
+        beginTest("Metering: loudness readings publish per point and reset requests fire once");
+
+        MeterHub hub;
+        hub.prepare(48000.0);
+
+        expectEquals(hub.getLoudness(MeterHub::Point::kOutput).shortTerm, MeterHub::kSilenceLufs);
+
+        hub.publishLoudness(MeterHub::Point::kInput, {-20.0f, -21.0f, -22.0f});
+        hub.publishLoudness(MeterHub::Point::kOutput, {-14.0f, -15.0f, -16.0f});
+
+        expectEquals(hub.getLoudness(MeterHub::Point::kInput).integrated, -22.0f);
+        expectEquals(hub.getLoudness(MeterHub::Point::kOutput).momentary, -14.0f);
+        expectEquals(hub.getLoudness(MeterHub::Point::kOutputTruePeak).shortTerm, MeterHub::kSilenceLufs,
+                     "True-peak point has no loudness");
+
+        expect(!hub.takeIntegratedLoudnessResetRequest());
+        hub.resetIntegratedLoudness();
+        expect(hub.takeIntegratedLoudnessResetRequest());
+        expect(!hub.takeIntegratedLoudnessResetRequest(), "Request is consumed");
+    }
+};
+
+//==============================================================================
+static MeteringTest
+    meteringTest;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables,misc-use-anonymous-namespace)
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    NullTestTest.cpp
+    Unit tests for the null-test difference statistics.
+    Verifies peak/RMS, that energy lands in the right octave band, and the
+    JSON report layout.
+
+  ==============================================================================
+*/
+
+#include "../Standalone/NullTestAnalyzer.h"
+
+#include <JuceHeader.h>
+
+//==============================================================================
+class NullTestTest : public juce::UnitTest
+{
+public:
+    NullTestTest() : juce::UnitTest("GRAIN NullTest") {}
+
+    void runTest() override
+    {
+        runSineLevelsTest();
+        runSilenceTest();
+        runJsonReportTest();
+    }
+
+private:
+    static constexpr double kSampleRate = 48000.0;
+
+    /** Feed a stereo sine through the analyzer in blocks. */
+    static void processSine(NullTestAnalyzer& analyzer, float frequency, float amplitude, int numSamples)
+    {
+        juce::AudioBuffer<float> block(2, 512);
+        int position = 0;
+
+        while (position < numSamples)
+        {
+            const int blockSize = std::min(512, numSamples - position);
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const auto sample = amplitude * std::sin(juce::MathConstants<float>::twoPi * frequency *
+                                                         static_cast<float>(position + i) /
+                                                         static_cast<float>(kSampleRate));
+                block.setSample(0, i, sample);
+                block.setSample(1, i, sample);
+            }
+
+            analyzer.process(block, blockSize);
+            position += blockSize;
+        }
+    }
+
+    //==============================================================================
+    void runSineLevelsTest()
+    {
+        beginTest("NullTest: a 1 kHz difference reports its level and lands in the 1 kHz band");
+
+        NullTestAnalyzer analyzer;
+        analyzer.prepare(kSampleRate, 2, 0);
+        processSine(analyzer, 1000.0f, 0.5f, static_cast<int>(kSampleRate));
+
+        const auto report = analyzer.getReport();
+        expectEquals(report.numSamples, static_cast<juce::int64>(kSampleRate));
+        expectWithinAbsoluteError(report.peak, 0.5f, 1.0e-3f);
+        expectWithinAbsoluteError(report.rms, 0.5f / std::sqrt(2.0f), 1.0e-3f);
+
+        int loudest = 0;
+
+        for (int band = 1; band < report.numBands; ++band)
+        {
+            if (report.bandRmsDb[static_cast<size_t>(band)] > report.bandRmsDb[static_cast<size_t>(loudest)])
+            {
+                loudest = band;
+            }
+        }
+
+        expectEquals(report.bandCentreHz[static_cast<size_t>(loudest)], 1000.0f);
+        expectWithinAbsoluteError(report.bandRmsDb[static_cast<size_t>(loudest)], report.getRmsDb(), 1.0f);
+        expectLessThan(report.bandRmsDb[0], report.getRmsDb() - 40.0f);
+    }
+
+    void runSilenceTest()
+    {
+        beginTest("NullTest: an exact null reports silence in every band");
+
+        NullTestAnalyzer analyzer;
+        analyzer.prepare(kSampleRate, 2, 32);
+        processSine(analyzer, 1000.0f, 0.0f, 10000);
+
+        const auto report = analyzer.getReport();
+        expectEquals(report.peak, 0.0f);
+        expectEquals(report.getPeakDb(), NullTestAnalyzer::kSilenceDb);
+        expectEquals(report.getRmsDb(), NullTestAnalyzer::kSilenceDb);
+
+        for (int band = 0; band < report.numBands; ++band)
+        {
+            expectEquals(report.bandRmsDb[static_cast<size_t>(band)], NullTestAnalyzer::kSilenceDb);
+        }
+    }
+
+    void runJsonReportTest()
+    {
+        beginTest("NullTest: JSON report holds levels, latency and only bands below Nyquist");
+
+        NullTestAnalyzer analyzer;
+        analyzer.prepare(32000.0, 1, 17);
+
+        const auto report = analyzer.getReport();
+        expectEquals(report.numBands, NullTestAnalyzer::kNumBands - 1);
+
+        const auto parsed = juce::JSON::parse(report.toJson());
+        expect(parsed.isObject());
+        expectEquals(static_cast<int>(parsed["latencySamples"]), 17);
+        expectEquals(static_cast<double>(parsed["sampleRate"]), 32000.0);
+        expect(parsed["peak"].hasProperty("dBFS"));
+        expect(parsed["rms"].hasProperty("linear"));
+        expectEquals(parsed["octaveBands"].size(), NullTestAnalyzer::kNumBands - 1);
+        expectEquals(static_cast<double>(parsed["octaveBands"][0]["centreHz"]), 31.5);
+    }
+};
+
+//==============================================================================
+static NullTestTest
+    nullTestTest;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables,misc-use-anonymous-namespace)
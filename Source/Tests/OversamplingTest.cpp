@@ -1,181 +1,268 @@
-/*
-  ==============================================================================
-
-    OversamplingTest.cpp
-    Unit tests for JUCE oversampling integration (Task 007).
-    Validates upsample/downsample behavior, block sizes, and signal integrity.
-
-  ==============================================================================
-*/
-
-#include "../DSP/DSPHelpers.h"
-
-#include <juce_dsp/juce_dsp.h>
-
-#include <JuceHeader.h>
-
-//==============================================================================
-namespace TestConstants
-{
-constexpr float kOsTolerance = 1e-5f;
-}
-
-//==============================================================================
-class OversamplingTest : public juce::UnitTest
-{
-public:
-    OversamplingTest() : juce::UnitTest("GRAIN Oversampling") {}
-
-    void runTest() override
-    {
-        runSilenceTest();
-        run2xBlockSizeTest();
-        run4xBlockSizeTest();
-        runLatencyTest();
-        runSignalIntegrityTest();
-    }
-
-private:
-    //==========================================================================
-    void runSilenceTest()
-    {
-        beginTest("Oversampling: silence in produces silence out");
-
-        juce::dsp::Oversampling<float> os(1, 1, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
-
-        constexpr int kBlockSize = 512;
-        os.initProcessing(kBlockSize);
-
-        juce::AudioBuffer<float> buffer(1, kBlockSize);
-        buffer.clear();
-
-        juce::dsp::AudioBlock<float> block(buffer);
-
-        // Upsample
-        auto upBlock = os.processSamplesUp(block);
-
-        // Verify upsampled block is silent
-        for (int i = 0; i < static_cast<int>(upBlock.getNumSamples()); ++i)
-        {
-            expectWithinAbsoluteError(upBlock.getSample(0, i), 0.0f, TestConstants::kOsTolerance);
-        }
-
-        // Downsample
-        os.processSamplesDown(block);
-
-        // Verify output is silent
-        for (int i = 0; i < kBlockSize; ++i)
-        {
-            expectWithinAbsoluteError(buffer.getSample(0, i), 0.0f, TestConstants::kOsTolerance);
-        }
-    }
-
-    //==========================================================================
-    void run2xBlockSizeTest()
-    {
-        beginTest("Oversampling: 2x upsampled block has correct size");
-
-        juce::dsp::Oversampling<float> os(1, 1, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
-
-        constexpr int kBlockSize = 256;
-        os.initProcessing(kBlockSize);
-
-        juce::AudioBuffer<float> buffer(1, kBlockSize);
-        buffer.clear();
-
-        juce::dsp::AudioBlock<float> block(buffer);
-        auto upBlock = os.processSamplesUp(block);
-
-        // 2× should double the samples
-        expectEquals(static_cast<int>(upBlock.getNumSamples()), kBlockSize * 2);
-
-        os.processSamplesDown(block);
-    }
-
-    //==========================================================================
-    void run4xBlockSizeTest()
-    {
-        beginTest("Oversampling: 4x upsampled block has correct size");
-
-        juce::dsp::Oversampling<float> os(1, 2, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
-
-        constexpr int kBlockSize = 256;
-        os.initProcessing(kBlockSize);
-
-        juce::AudioBuffer<float> buffer(1, kBlockSize);
-        buffer.clear();
-
-        juce::dsp::AudioBlock<float> block(buffer);
-        auto upBlock = os.processSamplesUp(block);
-
-        // 4× should quadruple the samples
-        expectEquals(static_cast<int>(upBlock.getNumSamples()), kBlockSize * 4);
-
-        os.processSamplesDown(block);
-    }
-
-    //==========================================================================
-    void runLatencyTest()
-    {
-        beginTest("Oversampling: latency is within reasonable bounds");
-
-        juce::dsp::Oversampling<float> os(1, 1, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
-
-        os.initProcessing(512);
-
-        const float latency = os.getLatencyInSamples();
-
-        // Polyphase IIR should have some latency, but not excessive
-        expect(latency >= 0.0f);
-        expect(latency < 50.0f);
-    }
-
-    //==========================================================================
-    void runSignalIntegrityTest()
-    {
-        beginTest("Oversampling: signal passes through with minimal change");
-
-        juce::dsp::Oversampling<float> os(1, 1, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
-
-        constexpr int kBlockSize = 512;
-        os.initProcessing(kBlockSize);
-
-        const float sampleRate = 44100.0f;
-        const float freq = 440.0f;
-        juce::AudioBuffer<float> buffer(1, kBlockSize);
-
-        // Process multiple blocks to get past initial transient
-        for (int rep = 0; rep < 10; ++rep)
-        {
-            for (int i = 0; i < kBlockSize; ++i)
-            {
-                const float phase = GrainDSP::kTwoPi * freq * static_cast<float>(i + (rep * kBlockSize)) / sampleRate;
-                buffer.setSample(0, i, 0.5f * std::sin(phase));
-            }
-
-            juce::dsp::AudioBlock<float> block(buffer);
-            auto upBlock = os.processSamplesUp(block);
-            // No processing — just pass through
-            os.processSamplesDown(block);
-        }
-
-        // After settling, signal should be close to original
-        float rms = 0.0f;
-        for (int i = 0; i < kBlockSize; ++i)
-        {
-            const float s = buffer.getSample(0, i);
-            rms += s * s;
-        }
-        rms = std::sqrt(rms / static_cast<float>(kBlockSize));
-
-        // Original RMS of 0.5 sine ≈ 0.354
-        // After oversampling round-trip, should be close
-        expect(rms > 0.2f);
-        expect(rms < 0.5f);
-    }
-};
-
-//==============================================================================
-// Register the test
-static OversamplingTest
-    oversamplingTest;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables,misc-use-anonymous-namespace)
+/*
+  ==============================================================================
+
+    OversamplingTest.cpp
+    Unit tests for JUCE oversampling integration (Task 007).
+    Validates upsample/downsample behavior, block sizes, signal integrity,
+    and that a processor restored from a captured state resumes through
+    the oversampler.
+
+  ==============================================================================
+*/
+
+#include "../DSP/DSPHelpers.h"
+#include "../DSP/ProcessorState.h"
+#include "../PluginProcessor.h"
+#include "TestFixtures.h"
+
+#include <juce_dsp/juce_dsp.h>
+
+#include <JuceHeader.h>
+#include <vector>
+
+//==============================================================================
+namespace TestConstants
+{
+constexpr float kOsTolerance = 1e-5f;
+}
+
+//==============================================================================
+class OversamplingTest : public juce::UnitTest
+{
+public:
+    OversamplingTest() : juce::UnitTest("GRAIN Oversampling") {}
+
+    void runTest() override
+    {
+        runSilenceTest();
+        run2xBlockSizeTest();
+        run4xBlockSizeTest();
+        runLatencyTest();
+        runSignalIntegrityTest();
+        runHistoryReplayTest();
+    }
+
+private:
+    //==========================================================================
+    void runSilenceTest()
+    {
+        beginTest("Oversampling: silence in produces silence out");
+
+        juce::dsp::Oversampling<float> os(1, 1, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
+
+        constexpr int kBlockSize = 512;
+        os.initProcessing(kBlockSize);
+
+        juce::AudioBuffer<float> buffer(1, kBlockSize);
+        buffer.clear();
+
+        juce::dsp::AudioBlock<float> block(buffer);
+
+        // Upsample
+        auto upBlock = os.processSamplesUp(block);
+
+        // Verify upsampled block is silent
+        for (int i = 0; i < static_cast<int>(upBlock.getNumSamples()); ++i)
+        {
+            expectWithinAbsoluteError(upBlock.getSample(0, i), 0.0f, TestConstants::kOsTolerance);
+        }
+
+        // Downsample
+        os.processSamplesDown(block);
+
+        // Verify output is silent
+        for (int i = 0; i < kBlockSize; ++i)
+        {
+            expectWithinAbsoluteError(buffer.getSample(0, i), 0.0f, TestConstants::kOsTolerance);
+        }
+    }
+
+    //==========================================================================
+    void run2xBlockSizeTest()
+    {
+        beginTest("Oversampling: 2x upsampled block has correct size");
+
+        juce::dsp::Oversampling<float> os(1, 1, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
+
+        constexpr int kBlockSize = 256;
+        os.initProcessing(kBlockSize);
+
+        juce::AudioBuffer<float> buffer(1, kBlockSize);
+        buffer.clear();
+
+        juce::dsp::AudioBlock<float> block(buffer);
+        auto upBlock = os.processSamplesUp(block);
+
+        // 2× should double the samples
+        expectEquals(static_cast<int>(upBlock.getNumSamples()), kBlockSize * 2);
+
+        os.processSamplesDown(block);
+    }
+
+    //==========================================================================
+    void run4xBlockSizeTest()
+    {
+        beginTest("Oversampling: 4x upsampled block has correct size");
+
+        juce::dsp::Oversampling<float> os(1, 2, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
+
+        constexpr int kBlockSize = 256;
+        os.initProcessing(kBlockSize);
+
+        juce::AudioBuffer<float> buffer(1, kBlockSize);
+        buffer.clear();
+
+        juce::dsp::AudioBlock<float> block(buffer);
+        auto upBlock = os.processSamplesUp(block);
+
+        // 4× should quadruple the samples
+        expectEquals(static_cast<int>(upBlock.getNumSamples()), kBlockSize * 4);
+
+        os.processSamplesDown(block);
+    }
+
+    //==========================================================================
+    void runLatencyTest()
+    {
+        beginTest("Oversampling: latency is within reasonable bounds");
+
+        juce::dsp::Oversampling<float> os(1, 1, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
+
+        os.initProcessing(512);
+
+        const float latency = os.getLatencyInSamples();
+
+        // Polyphase IIR should have some latency, but not excessive
+        expect(latency >= 0.0f);
+        expect(latency < 50.0f);
+    }
+
+    //==========================================================================
+    void runSignalIntegrityTest()
+    {
+        beginTest("Oversampling: signal passes through with minimal change");
+
+        juce::dsp::Oversampling<float> os(1, 1, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
+
+        constexpr int kBlockSize = 512;
+        os.initProcessing(kBlockSize);
+
+        const float sampleRate = 44100.0f;
+        const float freq = 440.0f;
+        juce::AudioBuffer<float> buffer(1, kBlockSize);
+
+        // Process multiple blocks to get past initial transient
+        for (int rep = 0; rep < 10; ++rep)
+        {
+            for (int i = 0; i < kBlockSize; ++i)
+            {
+                const float phase = GrainDSP::kTwoPi * freq * static_cast<float>(i + (rep * kBlockSize)) / sampleRate;
+                buffer.setSample(0, i, 0.5f * std::sin(phase));
+            }
+
+            juce::dsp::AudioBlock<float> block(buffer);
+            auto upBlock = os.processSamplesUp(block);
+            // No processing — just pass through
+            os.processSamplesDown(block);
+        }
+
+        // After settling, signal should be close to original
+        float rms = 0.0f;
+        for (int i = 0; i < kBlockSize; ++i)
+        {
+            const float s = buffer.getSample(0, i);
+            rms += s * s;
+        }
+        rms = std::sqrt(rms / static_cast<float>(kBlockSize));
+
+        // Original RMS of 0.5 sine ≈ 0.354
+        // After oversampling round-trip, should be close
+        expect(rms > 0.2f);
+        expect(rms < 0.5f);
+    }
+
+    //==========================================================================
+    void runHistoryReplayTest()
+    {
+        beginTest("Oversampling: a processor restored from a captured state resumes through the oversampler");
+
+        constexpr double kSampleRate = 48000.0;
+        constexpr int kBlockSize = 128;
+        constexpr int kWarmupBlocks = 40;
+
+        auto makeProcessor = []
+        {
+            auto processor = std::make_unique<GRAINAudioProcessor>();
+            TestFixtures::setParameter(processor->getAPVTS(), "mix", 1.0f);
+            processor->prepareToPlay(kSampleRate, kBlockSize);
+            return processor;
+        };
+
+        auto original = makeProcessor();
+        auto restored = makeProcessor();
+        auto cold = makeProcessor();
+
+        juce::MidiBuffer midi;
+        auto processBlock = [&midi](GRAINAudioProcessor& processor, juce::AudioBuffer<float>& buffer, int start)
+        {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            {
+                for (int i = 0; i < kBlockSize; ++i)
+                {
+                    buffer.setSample(ch, i, 0.6f * std::sin(0.07f * static_cast<float>(start + i)));
+                }
+            }
+
+            processor.processBlock(buffer, midi);
+        };
+
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+
+        for (int b = 0; b < kWarmupBlocks; ++b)
+        {
+            processBlock(*original, buffer, b * kBlockSize);
+        }
+
+        // restoreState() replays the captured oversampler history: its filter memory is not reachable
+        auto state = std::make_unique<GrainDSP::ProcessorState>();
+        original->captureState(*state);
+        expect(restored->restoreState(*state), "State restores into a processor prepared the same way");
+
+        juce::AudioBuffer<float> expected(2, kBlockSize);
+        float replayError = 0.0f;
+        float coldError = 0.0f;
+
+        for (int b = kWarmupBlocks; b < kWarmupBlocks + 8; ++b)
+        {
+            processBlock(*original, expected, b * kBlockSize);
+
+            processBlock(*restored, buffer, b * kBlockSize);
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                for (int i = 0; i < kBlockSize; ++i)
+                {
+                    replayError =
+                        std::max(replayError, std::abs(buffer.getSample(ch, i) - expected.getSample(ch, i)));
+                }
+            }
+
+            processBlock(*cold, buffer, b * kBlockSize);
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                for (int i = 0; i < kBlockSize; ++i)
+                {
+                    coldError = std::max(coldError, std::abs(buffer.getSample(ch, i) - expected.getSample(ch, i)));
+                }
+            }
+        }
+
+        // The IIR memory decays well within the history length, so what is left is far below the cold restart
+        expectLessThan(replayError, 1.0e-3f);
+        expectGreaterThan(coldError, 1.0e-2f);
+    }
+};
+
+//==============================================================================
+// Register the test
+static OversamplingTest
+    oversamplingTest;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables,misc-use-anonymous-namespace)
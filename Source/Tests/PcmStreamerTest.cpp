@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+    PcmStreamerTest.cpp
+    Unit tests for the headless raw PCM streamer.
+    Verifies latency-trimmed float streams, int24 conversion and clipping,
+    mono streams and a trailing partial frame.
+
+  ==============================================================================
+*/
+
+#include "../Headless/PcmStreamer.h"
+#include "TestFixtures.h"
+
+#include <JuceHeader.h>
+
+#include <vector>
+
+//==============================================================================
+namespace
+{
+
+/** Pack a signed integer as little-endian 24-bit. */
+void appendInt24(juce::MemoryOutputStream& stream, int value)
+{
+    const auto bits = static_cast<juce::uint32>(value);
+    stream.writeByte(static_cast<char>(bits & 0xff));
+    stream.writeByte(static_cast<char>((bits >> 8) & 0xff));
+    stream.writeByte(static_cast<char>((bits >> 16) & 0xff));
+}
+
+int readInt24(const juce::MemoryBlock& data, size_t offset)
+{
+    const auto* bytes = static_cast<const juce::uint8*>(data.getData()) + offset;
+    const auto bits = static_cast<juce::uint32>(bytes[0]) | (static_cast<juce::uint32>(bytes[1]) << 8)
+                      | (static_cast<juce::uint32>(bytes[2]) << 16);
+    return static_cast<int>(bits << 8) >> 8;
+}
+
+}  // namespace
+
+//==============================================================================
+class PcmStreamerTest : public juce::UnitTest
+{
+public:
+    PcmStreamerTest() : juce::UnitTest("GRAIN PcmStreamer") {}
+
+    void runTest() override
+    {
+        runFloatLatencyTrimTest();
+        runInt24Test();
+        runMonoPartialFrameTest();
+    }
+
+private:
+    /** Stream a byte block through a processor and return the output bytes. */
+    juce::MemoryBlock stream(juce::AudioProcessor& processor, const PcmStreamer::Options& options,
+                             const juce::MemoryBlock& input, bool& succeeded)
+    {
+        juce::MemoryInputStream inputStream(input, false);
+        juce::MemoryOutputStream outputStream;
+        PcmStreamer streamer(processor, options);
+        succeeded = streamer.run(inputStream, outputStream);
+        expectEquals(streamer.getFramesRead(),
+                     static_cast<juce::int64>(input.getSize()) / PcmStreamer::getFrameBytes(options));
+        return outputStream.getMemoryBlock();
+    }
+
+    //==============================================================================
+    void runFloatLatencyTrimTest()
+    {
+        beginTest("PcmStreamer: float stream comes out aligned and of equal length despite latency");
+
+        // Not a multiple of the block size, and latency longer than a block
+        constexpr int kNumFrames = 1000;
+        juce::MemoryOutputStream input;
+
+        for (int i = 0; i < kNumFrames; ++i)
+        {
+            input.writeFloat(std::sin(0.01f * static_cast<float>(i)));
+            input.writeFloat(0.25f);
+        }
+
+        PcmStreamer::Options options;
+        options.blockSize = 64;
+        TestFixtures::DelayGainProcessor processor(0.5f, 100);
+
+        bool succeeded = false;
+        const auto output = stream(processor, options, input.getMemoryBlock(), succeeded);
+        expect(succeeded);
+        expectEquals(static_cast<int>(output.getSize()), kNumFrames * 8);
+
+        juce::MemoryInputStream reader(output, false);
+        float error = 0.0f;
+
+        for (int i = 0; i < kNumFrames; ++i)
+        {
+            error = std::max(error, std::abs(reader.readFloat() - (0.5f * std::sin(0.01f * static_cast<float>(i)))));
+            error = std::max(error, std::abs(reader.readFloat() - 0.125f));
+        }
+
+        expectEquals(error, 0.0f);
+    }
+
+    void runInt24Test()
+    {
+        beginTest("PcmStreamer: int24 round-trips within one step and clips at full scale");
+
+        const int values[] = {0, 1, -1, 4194304, -4194304, 8388607, -8388608, 123456};
+        juce::MemoryOutputStream input;
+
+        for (const int value : values)
+        {
+            appendInt24(input, value);
+            appendInt24(input, value / 2);
+        }
+
+        PcmStreamer::Options options;
+        options.format = PcmStreamer::SampleFormat::int24;
+        options.blockSize = 3;
+
+        bool succeeded = false;
+        TestFixtures::DelayGainProcessor unity(1.0f, 0);
+        const auto output = stream(unity, options, input.getMemoryBlock(), succeeded);
+        expect(succeeded);
+        expectEquals(output.getSize(), input.getDataSize());
+
+        const auto expected = input.getMemoryBlock();
+        int maxError = 0;
+
+        for (size_t i = 0; i < output.getSize() / 3; ++i)
+        {
+            maxError = std::max(maxError, std::abs(readInt24(output, i * 3) - readInt24(expected, i * 3)));
+        }
+
+        expectLessOrEqual(maxError, 1);
+
+        // Half-scale samples boosted past full scale clip instead of wrapping
+        TestFixtures::DelayGainProcessor boost(4.0f, 0);
+        const auto clipped = stream(boost, options, expected, succeeded);
+        expect(succeeded);
+        expectGreaterOrEqual(readInt24(clipped, 3 * 6), 8388606);
+        expectLessOrEqual(readInt24(clipped, 3 * 8), -8388606);
+    }
+
+    void runMonoPartialFrameTest()
+    {
+        beginTest("PcmStreamer: mono stream feeds a stereo processor and drops a trailing partial frame");
+
+        juce::MemoryOutputStream input;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            input.writeFloat(0.5f);
+        }
+
+        input.writeShort(0x1234);  // Half a float frame
+
+        PcmStreamer::Options options;
+        options.numChannels = 1;
+        options.blockSize = 32;
+        TestFixtures::DelayGainProcessor processor(2.0f, 7);
+
+        bool succeeded = false;
+        const auto output = stream(processor, options, input.getMemoryBlock(), succeeded);
+        expect(succeeded);
+        expectEquals(static_cast<int>(output.getSize()), 100 * 4);
+
+        juce::MemoryInputStream reader(output, false);
+        bool allOne = true;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            allOne = allOne && juce::exactlyEqual(reader.readFloat(), 1.0f);
+        }
+
+        expect(allOne);
+    }
+};
+
+//==============================================================================
+static PcmStreamerTest
+    pcmStreamerTest;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables,misc-use-anonymous-namespace)
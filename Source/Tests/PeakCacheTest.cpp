@@ -0,0 +1,191 @@
+/*
+  ==============================================================================
+
+    PeakCacheTest.cpp
+    Unit tests for the persistent on-disk thumbnail peak cache.
+    Verifies round-trips, invalidation when the file changes and LRU
+    eviction under the size budget.
+
+  ==============================================================================
+*/
+
+#include "../Standalone/PeakCache.h"
+
+#include <JuceHeader.h>
+
+//==============================================================================
+class PeakCacheTest : public juce::UnitTest
+{
+public:
+    PeakCacheTest() : juce::UnitTest("GRAIN PeakCache") {}
+
+    void runTest() override
+    {
+        runRoundTripTest();
+        runInvalidationTest();
+        runLruEvictionTest();
+    }
+
+private:
+    static constexpr int kNumSamples = 100 * GrainDSP::PeakPyramid::kBaseSamples;
+
+    /** Fresh empty directory for one test. */
+    static juce::File createCacheDirectory()
+    {
+        auto dir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                       .getChildFile("GRAINPeakCacheTest")
+                       .getNonexistentChildFile("cache", "");
+        dir.createDirectory();
+        return dir;
+    }
+
+    /** The cache never parses audio: any file stands in for one. */
+    static juce::File createSourceFile(const juce::File& dir, const juce::String& name, char fill)
+    {
+        auto file = dir.getChildFile(name);
+        juce::MemoryBlock data(200000, false);
+        data.fillWith(static_cast<juce::uint8>(fill));
+        file.replaceWithData(data.getData(), data.getSize());
+        return file;
+    }
+
+    /** Pyramid over kNumSamples with a distinct value per base bucket. */
+    static GrainDSP::PeakPyramid createPyramid(float scale)
+    {
+        GrainDSP::PeakPyramid pyramid;
+        pyramid.reset(kNumSamples);
+
+        for (int i = 0; i < kNumSamples / GrainDSP::PeakPyramid::kBaseSamples; ++i)
+        {
+            GrainDSP::PeakSummary peak;
+            peak.startPosition = static_cast<std::int64_t>(i) * GrainDSP::PeakPyramid::kBaseSamples;
+            peak.numSamples = GrainDSP::PeakPyramid::kBaseSamples;
+            peak.maxVal = scale * static_cast<float>(i) / 100.0f;
+            peak.minVal = -peak.maxVal;
+            pyramid.merge(peak);
+        }
+
+        return pyramid;
+    }
+
+    /** Push every entry's last use further into the past. */
+    static void ageEntries(const juce::File& cacheDir, int seconds)
+    {
+        for (const auto& entry : cacheDir.findChildFiles(juce::File::findFiles, false, "*.peaks"))
+        {
+            entry.setLastModificationTime(entry.getLastModificationTime() - juce::RelativeTime::seconds(seconds));
+        }
+    }
+
+    //==============================================================================
+    void runRoundTripTest()
+    {
+        beginTest("PeakCache: stored peaks load back identically, every level rebuilt");
+
+        auto const cacheDir = createCacheDirectory();
+        auto const sourceFile = createSourceFile(cacheDir.getParentDirectory(), "roundtrip.wav", 1);
+        PeakCache cache(cacheDir);
+
+        GrainDSP::PeakPyramid loaded;
+        loaded.reset(kNumSamples);
+        expect(!cache.load(sourceFile, loaded), "Empty cache misses");
+
+        auto const original = createPyramid(1.0f);
+        expect(cache.store(sourceFile, original));
+        expectEquals(cache.getNumEntries(), 1);
+        expect(cache.load(sourceFile, loaded), "Stored entry hits");
+
+        bool identical = true;
+
+        for (size_t i = 0; i < original.getBaseLevel().size(); ++i)
+        {
+            identical = identical && loaded.getBaseLevel()[i].minVal == original.getBaseLevel()[i].minVal
+                        && loaded.getBaseLevel()[i].maxVal == original.getBaseLevel()[i].maxVal;
+        }
+
+        expect(identical, "Base level differs after a round-trip");
+
+        GrainDSP::PeakPyramid::Bucket whole;
+        expect(loaded.getRange(loaded.getNumLevels() - 1, 0, kNumSamples, kNumSamples, whole));
+        expectEquals(whole.maxVal, 0.99f);
+
+        // A pyramid of another length cannot take the entry
+        GrainDSP::PeakPyramid shorter;
+        shorter.reset(kNumSamples / 2);
+        expect(!cache.load(sourceFile, shorter), "Length mismatch must miss");
+
+        sourceFile.deleteFile();
+        cacheDir.deleteRecursively();
+    }
+
+    void runInvalidationTest()
+    {
+        beginTest("PeakCache: a changed file misses even with the same size and time");
+
+        auto const cacheDir = createCacheDirectory();
+        auto const sourceFile = createSourceFile(cacheDir.getParentDirectory(), "changed.wav", 1);
+        PeakCache cache(cacheDir);
+
+        expect(cache.store(sourceFile, createPyramid(1.0f)));
+
+        // Rewrite the content but restore size and modification time
+        auto const modified = sourceFile.getLastModificationTime();
+        createSourceFile(cacheDir.getParentDirectory(), "changed.wav", 2);
+        sourceFile.setLastModificationTime(modified);
+
+        GrainDSP::PeakPyramid loaded;
+        loaded.reset(kNumSamples);
+        expect(!cache.load(sourceFile, loaded), "Content fingerprint must catch the rewrite");
+
+        sourceFile.deleteFile();
+        cacheDir.deleteRecursively();
+    }
+
+    void runLruEvictionTest()
+    {
+        beginTest("PeakCache: least recently used entries are evicted over budget");
+
+        auto const cacheDir = createCacheDirectory();
+        auto const parent = cacheDir.getParentDirectory();
+        auto const fileA = createSourceFile(parent, "lru_a.wav", 1);
+        auto const fileB = createSourceFile(parent, "lru_b.wav", 2);
+        auto const fileC = createSourceFile(parent, "lru_c.wav", 3);
+        auto const pyramid = createPyramid(1.0f);
+
+        // Same-length paths give same-size entries: budget for two and a half
+        juce::int64 entryBytes = 0;
+        {
+            PeakCache measure(cacheDir);
+            measure.store(fileA, pyramid);
+            entryBytes = measure.getTotalBytes();
+        }
+
+        PeakCache cache(cacheDir, (entryBytes * 5) / 2);
+        ageEntries(cacheDir, 7200);
+
+        expect(cache.store(fileB, pyramid));
+        ageEntries(cacheDir, 3600);
+
+        // Using A makes B the least recently used
+        GrainDSP::PeakPyramid loaded;
+        loaded.reset(kNumSamples);
+        expect(cache.load(fileA, loaded));
+
+        expect(cache.store(fileC, pyramid));
+        expectEquals(cache.getNumEntries(), 2);
+        expect(cache.getTotalBytes() <= (entryBytes * 5) / 2);
+
+        expect(cache.load(fileA, loaded), "Recently used entry kept");
+        expect(!cache.load(fileB, loaded), "Least recently used entry evicted");
+        expect(cache.load(fileC, loaded), "Newest entry kept");
+
+        fileA.deleteFile();
+        fileB.deleteFile();
+        fileC.deleteFile();
+        cacheDir.deleteRecursively();
+    }
+};
+
+//==============================================================================
+static PeakCacheTest
+    peakCacheTest;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables,misc-use-anonymous-namespace)
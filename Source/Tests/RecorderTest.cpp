@@ -3,15 +3,47 @@
 
     RecorderTest.cpp
     Unit tests for the standalone AudioRecorder (GT-20).
-    Tests WAV file creation, recording fidelity, and graceful stop.
+    Tests WAV file creation, recording fidelity, graceful stop, loss
+    accounting when the writer cannot keep up, aligned multi-tap files, and
+    the float WAV (BWF) and FLAC export formats, and the null-test difference,
+    including a mix-0 pass through GRAINAudioProcessor itself.
 
   ==============================================================================
 */
 
+#include "../PluginProcessor.h"
 #include "../Standalone/AudioRecorder.h"
+#include "TestFixtures.h"
 
 #include <JuceHeader.h>
 
+//==============================================================================
+namespace
+{
+
+/** In-memory stream that stalls on every write, like a disk that cannot keep up. */
+class SlowOutputStream : public juce::OutputStream
+{
+public:
+    explicit SlowOutputStream(int delayMsPerWrite) : delayMs(delayMsPerWrite) {}
+
+    void flush() override {}
+    bool setPosition(juce::int64 newPosition) override { return memory.setPosition(newPosition); }
+    juce::int64 getPosition() override { return memory.getPosition(); }
+
+    bool write(const void* data, size_t numBytes) override
+    {
+        juce::Thread::sleep(delayMs);
+        return memory.write(data, numBytes);
+    }
+
+private:
+    juce::MemoryOutputStream memory;
+    int delayMs;
+};
+
+}  // namespace
+
 //==============================================================================
 class RecorderTest : public juce::UnitTest
 {
@@ -25,6 +57,14 @@ public:
         runStopMidFileTest();
         runSampleRateMatchesTest();
         runRecordedLengthTest();
+        runFifoSizedFromHeadroomTest();
+        runSlowWriterOverflowTest();
+        runPartialChunkFlushedOnStopTest();
+        runMultiTapAlignedTest();
+        runFloatWavKeepsOversTest();
+        runFlacExportTest();
+        runNullTestDifferenceTest();
+        runProcessedNullTest();
     }
 
 private:
@@ -217,6 +257,456 @@ private:
 
         tempFile.deleteFile();
     }
+
+    //==========================================================================
+    void runFifoSizedFromHeadroomTest()
+    {
+        beginTest("Recorder: ring buffer holds the requested headroom at the recording rate");
+
+        AudioRecorder recorder;
+
+        expect(recorder.startRecording(std::make_unique<juce::MemoryOutputStream>(), 96000.0, 2, 2.0));
+        expect(recorder.getFifoCapacity() >= 192000, "2 s at 96 kHz");
+        expect(recorder.stopRecording());
+
+        expect(recorder.startRecording(std::make_unique<juce::MemoryOutputStream>(), 44100.0, 2));
+        expect(recorder.getFifoCapacity() >= static_cast<int>(44100.0 * AudioRecorder::kDefaultHeadroomSeconds));
+        expect(recorder.stopRecording());
+    }
+
+    //==========================================================================
+    void runSlowWriterOverflowTest()
+    {
+        beginTest("Recorder: a stalled writer is reported, never silently dropped");
+
+        constexpr int kBlockSize = 512;
+        constexpr int kNumBlocks = 400;  // ~4.6 s at 44.1 kHz, pushed far faster than the writer drains
+        auto const block = generateSineBuffer(44100.0, 2, kBlockSize);
+
+        // Small ring: the stalls outlast it
+        {
+            AudioRecorder recorder;
+            expect(recorder.startRecording(std::make_unique<SlowOutputStream>(50), 44100.0, 2, 0.25));
+
+            for (int i = 0; i < kNumBlocks; ++i)
+            {
+                recorder.pushSamples(block, kBlockSize);
+            }
+
+            expect(recorder.getNumOverflows() > 0, "Overflows counted");
+            expect(recorder.getNumDroppedSamples() > 0, "Dropped samples counted");
+            expect(recorder.getNumDroppedSamples() <= static_cast<juce::int64>(kNumBlocks) * kBlockSize);
+
+            expect(!recorder.stopRecording(), "Lossy recording must report failure");
+            expect(recorder.getLastError().contains("lost"), "Error says audio was lost");
+        }
+
+        // Enough headroom: the same stalls are absorbed by the ring
+        {
+            AudioRecorder recorder;
+            expect(recorder.startRecording(std::make_unique<SlowOutputStream>(50), 44100.0, 2, 10.0));
+
+            for (int i = 0; i < kNumBlocks; ++i)
+            {
+                recorder.pushSamples(block, kBlockSize);
+            }
+
+            expectEquals(recorder.getNumOverflows(), 0);
+            expect(recorder.stopRecording(), "Nothing lost: " + recorder.getLastError());
+        }
+    }
+
+    //==========================================================================
+    void runPartialChunkFlushedOnStopTest()
+    {
+        beginTest("Recorder: audio short of a full write chunk is written on stop");
+
+        // The writer only wakes for whole chunks; 1000 samples never wake it
+        auto tempFile = juce::File::createTempFile(".wav");
+        auto const buffer = generateSineBuffer(44100.0, 2, 1000);
+
+        {
+            AudioRecorder recorder;
+            expect(recorder.startRecording(tempFile, 44100.0, 2));
+            recorder.pushSamples(buffer, 1000);
+            expect(recorder.stopRecording());
+        }
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(tempFile));
+        expect(reader != nullptr);
+
+        if (reader != nullptr)
+        {
+            expectEquals(reader->lengthInSamples, static_cast<juce::int64>(1000));
+        }
+
+        reader.reset();
+        tempFile.deleteFile();
+    }
+
+    //==========================================================================
+    void runMultiTapAlignedTest()
+    {
+        beginTest("Recorder: taps of one pass are written to sample-aligned files of equal length");
+
+        constexpr int kBlockSize = 480;
+        constexpr int kNumBlocks = 100;
+        constexpr int kTotalSamples = kBlockSize * kNumBlocks;
+
+        auto const outputFile = juce::File::createTempFile(".wav");
+        auto const dryFile = AudioRecorder::getTapFile(outputFile, AudioRecorder::Tap::dry);
+        auto const wetFile = AudioRecorder::getTapFile(outputFile, AudioRecorder::Tap::wet);
+        expect(dryFile.getFileName() == outputFile.getFileNameWithoutExtension() + "_dry.wav");
+        expect(AudioRecorder::getTapFile(outputFile, AudioRecorder::Tap::output) == outputFile);
+
+        // Output and dry only: the wet tap stays off and its pushes are ignored
+        AudioRecorder::TapFiles tapFiles;
+        tapFiles[static_cast<size_t>(AudioRecorder::Tap::output)] = outputFile;
+        tapFiles[static_cast<size_t>(AudioRecorder::Tap::dry)] = dryFile;
+
+        {
+            AudioRecorder recorder;
+            expect(recorder.startRecording(tapFiles, 44100.0, 2));
+            expect(recorder.isTapRecording(AudioRecorder::Tap::dry));
+            expect(!recorder.isTapRecording(AudioRecorder::Tap::wet));
+            expect(recorder.getRecordingFile(AudioRecorder::Tap::dry) == dryFile);
+
+            // A ramp running across block boundaries: the output is the dry signal doubled
+            juce::AudioBuffer<float> dry(2, kBlockSize);
+            juce::AudioBuffer<float> output(2, kBlockSize);
+
+            for (int block = 0; block < kNumBlocks; ++block)
+            {
+                for (int i = 0; i < kBlockSize; ++i)
+                {
+                    auto const value = static_cast<float>((block * kBlockSize + i) % 1000) / 2000.0f;
+
+                    for (int ch = 0; ch < 2; ++ch)
+                    {
+                        dry.setSample(ch, i, value);
+                        output.setSample(ch, i, 2.0f * value);
+                    }
+                }
+
+                recorder.pushSamples(AudioRecorder::Tap::dry, dry, kBlockSize);
+                recorder.pushSamples(AudioRecorder::Tap::wet, dry, kBlockSize);
+                recorder.pushSamples(output, kBlockSize);
+            }
+
+            expect(recorder.stopRecording(), recorder.getLastError());
+        }
+
+        expect(!wetFile.existsAsFile(), "A tap without a file writes nothing");
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        std::unique_ptr<juce::AudioFormatReader> outputReader(formatManager.createReaderFor(outputFile));
+        std::unique_ptr<juce::AudioFormatReader> dryReader(formatManager.createReaderFor(dryFile));
+        expect(outputReader != nullptr && dryReader != nullptr);
+
+        if (outputReader != nullptr && dryReader != nullptr)
+        {
+            expectEquals(outputReader->lengthInSamples, static_cast<juce::int64>(kTotalSamples));
+            expectEquals(dryReader->lengthInSamples, static_cast<juce::int64>(kTotalSamples));
+
+            juce::AudioBuffer<float> outputRead(2, kTotalSamples);
+            juce::AudioBuffer<float> dryRead(2, kTotalSamples);
+            outputReader->read(&outputRead, 0, kTotalSamples, 0, true, true);
+            dryReader->read(&dryRead, 0, kTotalSamples, 0, true, true);
+
+            float maxError = 0.0f;
+
+            for (int i = 0; i < kTotalSamples; ++i)
+            {
+                maxError = std::max(maxError, std::abs(outputRead.getSample(1, i) - 2.0f * dryRead.getSample(1, i)));
+            }
+
+            // 24-bit quantisation only; a one-sample offset would be off by a whole ramp step
+            expectLessThan(maxError, 1.0e-5f);
+        }
+
+        outputReader.reset();
+        dryReader.reset();
+        outputFile.deleteFile();
+        dryFile.deleteFile();
+    }
+
+    //==========================================================================
+    void runFloatWavKeepsOversTest()
+    {
+        beginTest("Recorder: float WAV keeps samples above 0 dBFS and carries BWF metadata");
+
+        auto const tempFile = juce::File::createTempFile(".wav");
+        juce::AudioBuffer<float> buffer(2, 1000);
+        buffer.clear();
+        buffer.setSample(0, 10, 1.5f);
+        buffer.setSample(1, 20, -2.25f);
+
+        {
+            AudioRecorder recorder;
+            recorder.setFormat(AudioRecorder::Format::wavFloat);
+            expect(recorder.startRecording(tempFile, 48000.0, 2));
+            recorder.pushSamples(buffer, buffer.getNumSamples());
+            expect(recorder.stopRecording());
+        }
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(tempFile));
+        expect(reader != nullptr);
+
+        if (reader != nullptr)
+        {
+            expect(reader->usesFloatingPointData, "32-bit float data");
+            expectEquals(static_cast<int>(reader->bitsPerSample), 32);
+            expectEquals(reader->metadataValues[juce::WavAudioFormat::bwavOriginator], juce::String("GRAIN"));
+
+            juce::AudioBuffer<float> readBack(2, 1000);
+            reader->read(&readBack, 0, 1000, 0, true, true);
+            expectEquals(readBack.getSample(0, 10), 1.5f);
+            expectEquals(readBack.getSample(1, 20), -2.25f);
+        }
+
+        reader.reset();
+        tempFile.deleteFile();
+    }
+
+    //==========================================================================
+    void runFlacExportTest()
+    {
+        beginTest("Recorder: FLAC export is chosen by extension and round-trips at 24 bits");
+
+        auto const tempFile = juce::File::createTempFile(".flac");
+        expect(AudioRecorder::getFormatForFile(tempFile, AudioRecorder::Format::wavFloat)
+               == AudioRecorder::Format::flac);
+        expect(AudioRecorder::getFormatForFile(tempFile.withFileExtension(".wav"), AudioRecorder::Format::wavFloat)
+               == AudioRecorder::Format::wavFloat);
+
+        constexpr int kBlockSize = 512;
+        constexpr int kNumBlocks = 430;  // ~5 s, pushed far faster than real time
+        auto const source = generateSineBuffer(44100.0, 2, kBlockSize * kNumBlocks);
+
+        {
+            AudioRecorder recorder;
+            recorder.setFormat(AudioRecorder::Format::flac);
+            expect(recorder.startRecording(tempFile, 44100.0, 2));
+
+            // Compression runs on the writer thread: the ring absorbs it without loss
+            juce::AudioBuffer<float> block(2, kBlockSize);
+
+            for (int offset = 0; offset < source.getNumSamples(); offset += kBlockSize)
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    block.copyFrom(ch, 0, source, ch, offset, kBlockSize);
+                }
+
+                recorder.pushSamples(block, kBlockSize);
+            }
+
+            expectEquals(recorder.getNumOverflows(), 0);
+            expect(recorder.stopRecording(), recorder.getLastError());
+        }
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(tempFile));
+        expect(reader != nullptr, "FLAC file readable");
+
+        if (reader != nullptr)
+        {
+            expectEquals(reader->getFormatName(), juce::String("FLAC file"));
+            expectEquals(static_cast<int>(reader->bitsPerSample), 24);
+            expectEquals(reader->lengthInSamples, static_cast<juce::int64>(kBlockSize * kNumBlocks));
+
+            juce::AudioBuffer<float> readBack(2, kBlockSize * kNumBlocks);
+            reader->read(&readBack, 0, kBlockSize * kNumBlocks, 0, true, true);
+
+            float maxError = 0.0f;
+
+            for (int i = 0; i < readBack.getNumSamples(); ++i)
+            {
+                maxError = std::max(maxError, std::abs(readBack.getSample(0, i) - source.getSample(0, i)));
+            }
+
+            expectLessThan(maxError, 1.0e-6f);
+        }
+
+        reader.reset();
+        tempFile.deleteFile();
+    }
+
+    //==========================================================================
+    void runNullTestDifferenceTest()
+    {
+        beginTest("Recorder: difference tap is output minus the already-aligned dry, with a JSON report");
+
+        constexpr int kLatency = 64;
+        constexpr int kBlockSize = 480;
+        constexpr int kNumBlocks = 100;
+        constexpr int kTotalSamples = kBlockSize * kNumBlocks;
+        constexpr float kResidual = 0.001f;
+
+        // The processor pushes the dry tap already delayed by its latency: the output is that dry signal
+        // plus a small constant residual, and the recorder must not delay the dry again
+        auto const dry = generateSineBuffer(48000.0, 2, kTotalSamples);
+        juce::AudioBuffer<float> output(2, kTotalSamples);
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            for (int i = 0; i < kTotalSamples; ++i)
+            {
+                output.setSample(ch, i, dry.getSample(ch, i) + kResidual);
+            }
+        }
+
+        auto const outputFile = juce::File::createTempFile(".wav");
+        auto const differenceFile = AudioRecorder::getTapFile(outputFile, AudioRecorder::Tap::difference);
+        auto const reportFile = AudioRecorder::getNullTestReportFile(differenceFile);
+
+        // No dry file: the dry ring is still fed for the difference
+        AudioRecorder::TapFiles tapFiles;
+        tapFiles[static_cast<size_t>(AudioRecorder::Tap::output)] = outputFile;
+        tapFiles[static_cast<size_t>(AudioRecorder::Tap::difference)] = differenceFile;
+
+        NullTestAnalyzer::Report report;
+
+        {
+            AudioRecorder recorder;
+            recorder.setFormat(AudioRecorder::Format::wavFloat);
+            recorder.setNullTestLatency(kLatency);
+            expect(recorder.startRecording(tapFiles, 48000.0, 2));
+
+            juce::AudioBuffer<float> dryBlock(2, kBlockSize);
+            juce::AudioBuffer<float> outputBlock(2, kBlockSize);
+
+            for (int offset = 0; offset < kTotalSamples; offset += kBlockSize)
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    dryBlock.copyFrom(ch, 0, dry, ch, offset, kBlockSize);
+                    outputBlock.copyFrom(ch, 0, output, ch, offset, kBlockSize);
+                }
+
+                recorder.pushSamples(AudioRecorder::Tap::dry, dryBlock, kBlockSize);
+                recorder.pushSamples(outputBlock, kBlockSize);
+            }
+
+            expect(recorder.stopRecording(), recorder.getLastError());
+            report = recorder.getNullTestReport();
+        }
+
+        expectEquals(report.numSamples, static_cast<juce::int64>(kTotalSamples));
+        expectEquals(report.latencySamples, kLatency);
+        expectWithinAbsoluteError(report.peak, kResidual, 1.0e-6f);
+        expectWithinAbsoluteError(report.rms, kResidual, 1.0e-6f);
+        expect(reportFile.existsAsFile(), "Report written beside the difference file");
+        expect(juce::JSON::parse(reportFile).isObject());
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(differenceFile));
+        expect(reader != nullptr);
+
+        if (reader != nullptr)
+        {
+            expectEquals(reader->lengthInSamples, static_cast<juce::int64>(kTotalSamples));
+
+            juce::AudioBuffer<float> readBack(2, kTotalSamples);
+            reader->read(&readBack, 0, kTotalSamples, 0, true, true);
+
+            float maxError = 0.0f;
+
+            for (int i = 0; i < kTotalSamples; ++i)
+            {
+                maxError = std::max(maxError, std::abs(readBack.getSample(1, i) - kResidual));
+            }
+
+            expectLessThan(maxError, 1.0e-6f);
+        }
+
+        reader.reset();
+        outputFile.deleteFile();
+        differenceFile.deleteFile();
+        reportFile.deleteFile();
+    }
+
+    /**
+     * Record a sine through GRAINAudioProcessor with the recorder attached, as the standalone app does.
+     * @param nonRealtime Selects the processor's 4x (true) or 2x (false) oversampling
+     * @return The null-test report
+     */
+    NullTestAnalyzer::Report recordProcessedNullTest(bool nonRealtime, float mix)
+    {
+        constexpr double kSampleRate = 48000.0;
+        constexpr int kBlockSize = 480;
+        constexpr int kNumBlocks = 100;
+
+        GRAINAudioProcessor processor;
+        TestFixtures::setParameter(processor.getAPVTS(), "mix", mix);
+        processor.setNonRealtime(nonRealtime);
+        processor.prepareToPlay(kSampleRate, kBlockSize);
+
+        auto const input = generateSineBuffer(kSampleRate, 2, kBlockSize * kNumBlocks);
+        auto const outputFile = juce::File::createTempFile(".wav");
+        auto const differenceFile = AudioRecorder::getTapFile(outputFile, AudioRecorder::Tap::difference);
+
+        AudioRecorder::TapFiles tapFiles;
+        tapFiles[static_cast<size_t>(AudioRecorder::Tap::output)] = outputFile;
+        tapFiles[static_cast<size_t>(AudioRecorder::Tap::difference)] = differenceFile;
+
+        NullTestAnalyzer::Report report;
+
+        {
+            AudioRecorder recorder;
+            recorder.setFormat(AudioRecorder::Format::wavFloat);
+            recorder.setNullTestLatency(processor.getLatencySamples());
+            expect(recorder.startRecording(tapFiles, kSampleRate, 2));
+            processor.setAudioRecorder(&recorder);
+
+            juce::AudioBuffer<float> buffer(2, kBlockSize);
+            juce::MidiBuffer midi;
+
+            for (int offset = 0; offset < input.getNumSamples(); offset += kBlockSize)
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    buffer.copyFrom(ch, 0, input, ch, offset, kBlockSize);
+                }
+
+                processor.processBlock(buffer, midi);
+            }
+
+            processor.setAudioRecorder(nullptr);
+            expect(recorder.stopRecording(), recorder.getLastError());
+            report = recorder.getNullTestReport();
+        }
+
+        processor.releaseResources();
+        outputFile.deleteFile();
+        differenceFile.deleteFile();
+        AudioRecorder::getNullTestReportFile(differenceFile).deleteFile();
+        return report;
+    }
+
+    void runProcessedNullTest()
+    {
+        beginTest("Recorder: the processing chain at mix 0 (bypass) nulls below -120 dBFS at 2x and 4x");
+
+        constexpr float kMinus120Db = 1.0e-6f;
+
+        for (const bool nonRealtime : {false, true})
+        {
+            const auto report = recordProcessedNullTest(nonRealtime, 0.0f);
+            expect(report.latencySamples > 0, "The oversampler reports a latency");
+            expectLessThan(report.peak, kMinus120Db, nonRealtime ? "4x (non-realtime)" : "2x (realtime)");
+        }
+
+        // The test can fail: a wet mix leaves the saturation
+        expectGreaterThan(recordProcessedNullTest(true, 1.0f).peak, 0.001f);
+    }
 };
 
 //==============================================================================
@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    RefreshSchedulerTest.cpp
+    Unit tests for the shared, change-driven UI refresh scheduler.
+    Verifies zero wakeups while idle, vblank/watch routing per mode and
+    that hidden clients are never refreshed.
+
+  ==============================================================================
+*/
+
+#include "../UI/RefreshScheduler.h"
+
+#include <JuceHeader.h>
+
+//==============================================================================
+class RefreshSchedulerTest : public juce::UnitTest
+{
+public:
+    RefreshSchedulerTest() : juce::UnitTest("GRAIN RefreshScheduler") {}
+
+    void runTest() override
+    {
+        runIdleHasNoWakeupsTest();
+        runWakeRefreshesUntilIdleTest();
+        runWatchModeTest();
+        runHiddenClientTest();
+        runSharedInstanceTest();
+    }
+
+private:
+    /** Client with scripted visibility and next mode; counts refreshes. */
+    struct FakeClient : RefreshScheduler::Client
+    {
+        RefreshScheduler::Mode refreshTick() override
+        {
+            ++refreshes;
+            return nextMode;
+        }
+
+        juce::Component& getRefreshComponent() override { return component; }
+        bool isVisibleForRefresh() override { return visible; }
+
+        juce::Component component;
+        bool visible = true;
+        int refreshes = 0;
+        RefreshScheduler::Mode nextMode = RefreshScheduler::Mode::kIdle;
+    };
+
+    //==============================================================================
+    void runIdleHasNoWakeupsTest()
+    {
+        beginTest("RefreshScheduler: idle clients cause no vblank and no timer");
+
+        FakeClient client;
+        RefreshScheduler::Registration registration(client, RefreshScheduler::Mode::kIdle);
+        auto& scheduler = registration.getScheduler();
+
+        expect(!scheduler.isVBlankAttached(), "No vblank callback while idle");
+        expect(!scheduler.isWatching(), "No watch timer while idle");
+
+        scheduler.tick(true);
+        scheduler.tick(false);
+        expectEquals(client.refreshes, 0);
+    }
+
+    void runWakeRefreshesUntilIdleTest()
+    {
+        beginTest("RefreshScheduler: wake() refreshes on vblank until the client goes idle");
+
+        FakeClient client;
+        client.nextMode = RefreshScheduler::Mode::kActive;
+        RefreshScheduler::Registration registration(client, RefreshScheduler::Mode::kIdle);
+        auto& scheduler = registration.getScheduler();
+
+        registration.wake();
+        expect(scheduler.isVBlankAttached(), "Active visible client needs the vblank");
+
+        scheduler.tick(true);
+        scheduler.tick(true);
+        expectEquals(client.refreshes, 2);
+
+        // A watch pass does not double-refresh active clients while vblank runs
+        scheduler.tick(false);
+        expectEquals(client.refreshes, 2);
+
+        client.nextMode = RefreshScheduler::Mode::kIdle;
+        scheduler.tick(true);
+        expectEquals(client.refreshes, 3);
+        expect(registration.getMode() == RefreshScheduler::Mode::kIdle);
+        expect(!scheduler.isVBlankAttached(), "vblank detached once idle");
+        expect(!scheduler.isWatching(), "Timer stopped once idle");
+    }
+
+    void runWatchModeTest()
+    {
+        beginTest("RefreshScheduler: watch clients refresh only on the slow pass");
+
+        FakeClient client;
+        client.nextMode = RefreshScheduler::Mode::kWatch;
+        RefreshScheduler::Registration registration(client, RefreshScheduler::Mode::kWatch);
+        auto& scheduler = registration.getScheduler();
+
+        expect(!scheduler.isVBlankAttached(), "Watching needs no vblank");
+        expect(scheduler.isWatching());
+
+        scheduler.tick(true);
+        expectEquals(client.refreshes, 0);
+
+        scheduler.tick(false);
+        expectEquals(client.refreshes, 1);
+
+        // A change seen during the watch pass switches back to vblank refreshes
+        client.nextMode = RefreshScheduler::Mode::kActive;
+        scheduler.tick(false);
+        expect(scheduler.isVBlankAttached());
+    }
+
+    void runHiddenClientTest()
+    {
+        beginTest("RefreshScheduler: hidden clients are not refreshed");
+
+        FakeClient client;
+        client.visible = false;
+        client.nextMode = RefreshScheduler::Mode::kActive;
+        RefreshScheduler::Registration registration(client, RefreshScheduler::Mode::kIdle);
+        auto& scheduler = registration.getScheduler();
+
+        registration.wake();
+        expect(!scheduler.isVBlankAttached(), "No vblank anchored on a hidden component");
+        expect(scheduler.isWatching(), "Watch timer notices the client becoming visible");
+
+        scheduler.tick(false);
+        expectEquals(client.refreshes, 0);
+
+        client.visible = true;
+        scheduler.tick(false);
+        expectEquals(client.refreshes, 1);
+        expect(scheduler.isVBlankAttached());
+    }
+
+    void runSharedInstanceTest()
+    {
+        beginTest("RefreshScheduler: one scheduler shared by all clients");
+
+        FakeClient first;
+        FakeClient second;
+        first.nextMode = RefreshScheduler::Mode::kActive;
+        second.nextMode = RefreshScheduler::Mode::kActive;
+
+        RefreshScheduler::Registration firstRegistration(first, RefreshScheduler::Mode::kIdle);
+        RefreshScheduler::Registration secondRegistration(second, RefreshScheduler::Mode::kIdle);
+        expect(&firstRegistration.getScheduler() == &secondRegistration.getScheduler());
+
+        firstRegistration.wake();
+        secondRegistration.wake();
+
+        auto& scheduler = firstRegistration.getScheduler();
+        const auto vblankTicksBefore = scheduler.getStats().vblankTicks;
+        scheduler.tick(true);
+
+        // One coalesced pass refreshes both
+        expectEquals(first.refreshes, 1);
+        expectEquals(second.refreshes, 1);
+        expectEquals(static_cast<int>(scheduler.getStats().vblankTicks - vblankTicksBefore), 1);
+    }
+};
+
+//==============================================================================
+static RefreshSchedulerTest
+    refreshSchedulerTest;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables,misc-use-anonymous-namespace)
@@ -0,0 +1,244 @@
+/*
+  ==============================================================================
+
+    StateCodecTest.cpp
+    Unit tests for the compact binary plugin state.
+    Verifies round-trips, legacy XML sessions, unknown and missing records,
+    rejection of damaged data, and benchmarks save/load per instance
+    against the XML state it replaces.
+
+  ==============================================================================
+*/
+
+#include "../PluginProcessor.h"
+#include "../State/ParameterStateCodec.h"
+
+#include <JuceHeader.h>
+
+#include <memory>
+#include <vector>
+
+//==============================================================================
+namespace
+{
+
+/** The state format GRAIN saved before the binary codec: the APVTS state as XML. */
+juce::MemoryBlock getXmlState(GRAINAudioProcessor& processor)
+{
+    const auto state = processor.getAPVTS().copyState();
+    const std::unique_ptr<juce::XmlElement> xml(state.createXml());
+    juce::MemoryBlock destData;
+    juce::AudioProcessor::copyXmlToBinary(*xml, destData);
+    return destData;
+}
+
+float getValue(GRAINAudioProcessor& processor, const juce::String& parameterId)
+{
+    return processor.getAPVTS().getParameter(parameterId)->getValue();
+}
+
+void setValue(GRAINAudioProcessor& processor, const juce::String& parameterId, float value)
+{
+    processor.getAPVTS().getParameter(parameterId)->setValueNotifyingHost(value);
+}
+
+/** A typical session: a handful of parameters moved away from their defaults. */
+void applySession(GRAINAudioProcessor& processor)
+{
+    setValue(processor, "drive", 0.73f);
+    setValue(processor, "mix", 0.41f);
+    setValue(processor, "output", 0.45f);
+    setValue(processor, "warmth", 0.3f);
+    setValue(processor, "focus", 1.0f);
+    setValue(processor, "autoGain", 1.0f);
+}
+
+void appendRecord(juce::MemoryOutputStream& stream, const juce::String& parameterId, float value)
+{
+    stream.writeInt(static_cast<int>(ParameterStateCodec::hashParameterId(parameterId)));
+    stream.writeFloat(value);
+}
+
+}  // namespace
+
+//==============================================================================
+class StateCodecTest : public juce::UnitTest
+{
+public:
+    StateCodecTest() : juce::UnitTest("GRAIN StateCodec") {}
+
+    void runTest() override
+    {
+        runRoundTripTest();
+        runLegacyXmlTest();
+        runUnknownAndMissingRecordsTest();
+        runDamagedDataTest();
+        runBenchmark();
+    }
+
+private:
+    static constexpr const char* kParameterIds[] = {"drive",  "mix",       "output", "bypass",
+                                                    "warmth", "inputGain", "focus",  "autoGain"};
+
+    /** @return the largest normalised difference between two processors' parameters */
+    static float maxParameterDifference(GRAINAudioProcessor& a, GRAINAudioProcessor& b)
+    {
+        float difference = 0.0f;
+
+        for (const auto* id : kParameterIds)
+        {
+            difference = std::max(difference, std::abs(getValue(a, id) - getValue(b, id)));
+        }
+
+        return difference;
+    }
+
+    //==============================================================================
+    void runRoundTripTest()
+    {
+        beginTest("StateCodec: binary state restores every parameter and is smaller than XML");
+
+        GRAINAudioProcessor source;
+        applySession(source);
+
+        juce::MemoryBlock binary;
+        source.getStateInformation(binary);
+        expect(ParameterStateCodec::isBinaryState(binary.getData(), static_cast<int>(binary.getSize())));
+        expectEquals(static_cast<int>(binary.getSize()),
+                     ParameterStateCodec::kHeaderBytes + (8 * ParameterStateCodec::kRecordBytes));
+
+        GRAINAudioProcessor restored;
+        restored.setStateInformation(binary.getData(), static_cast<int>(binary.getSize()));
+        expectLessThan(maxParameterDifference(source, restored), 1.0e-6f);
+
+        const auto xml = getXmlState(source);
+        expect(!ParameterStateCodec::isBinaryState(xml.getData(), static_cast<int>(xml.getSize())));
+        expectLessThan(binary.getSize() * 4, xml.getSize());
+    }
+
+    void runLegacyXmlTest()
+    {
+        beginTest("StateCodec: XML states from older sessions still load");
+
+        GRAINAudioProcessor source;
+        applySession(source);
+
+        const auto xml = getXmlState(source);
+
+        GRAINAudioProcessor restored;
+        restored.setStateInformation(xml.getData(), static_cast<int>(xml.getSize()));
+        expectLessThan(maxParameterDifference(source, restored), 1.0e-6f);
+    }
+
+    void runUnknownAndMissingRecordsTest()
+    {
+        beginTest("StateCodec: unknown records are ignored and missing parameters return to default");
+
+        juce::MemoryOutputStream stream;
+        stream.writeInt(static_cast<int>(ParameterStateCodec::kMagic));
+        stream.writeShort(static_cast<short>(ParameterStateCodec::kVersion));
+        stream.writeShort(3);
+        appendRecord(stream, "removedInAnOlderVersion", 0.9f);
+        appendRecord(stream, "warmth", 0.6f);
+        appendRecord(stream, "drive", 0.8f);
+
+        GRAINAudioProcessor processor;
+        setValue(processor, "mix", 0.9f);
+
+        const auto state = stream.getMemoryBlock();
+        const auto size = static_cast<int>(state.getSize());
+        expect(ParameterStateCodec::read(processor.getParameters(), state.getData(), size));
+        expectWithinAbsoluteError(getValue(processor, "drive"), 0.8f, 1.0e-6f);
+        expectWithinAbsoluteError(getValue(processor, "warmth"), 0.6f, 1.0e-6f);
+        expectEquals(getValue(processor, "mix"), processor.getAPVTS().getParameter("mix")->getDefaultValue());
+    }
+
+    void runDamagedDataTest()
+    {
+        beginTest("StateCodec: truncated or newer-version data is rejected without touching parameters");
+
+        GRAINAudioProcessor source;
+        applySession(source);
+        juce::MemoryBlock state;
+        source.getStateInformation(state);
+
+        GRAINAudioProcessor target;
+        const auto truncatedSize = static_cast<int>(state.getSize()) - 1;
+        expect(!ParameterStateCodec::read(target.getParameters(), state.getData(), truncatedSize));
+        expect(!ParameterStateCodec::read(target.getParameters(), state.getData(), 4));
+
+        auto newer = state;
+        newer[4] = static_cast<char>(ParameterStateCodec::kVersion + 1);
+        expect(!ParameterStateCodec::read(target.getParameters(), newer.getData(), static_cast<int>(newer.getSize())));
+
+        GRAINAudioProcessor untouched;
+        expectEquals(maxParameterDifference(target, untouched), 0.0f);
+    }
+
+    //==============================================================================
+    /** Save and load time per instance for a 150-instance session, XML against binary. */
+    void runBenchmark()
+    {
+        beginTest("StateCodec: save/load benchmark, 150 instances");
+
+        constexpr int kNumInstances = 150;
+        GRAINAudioProcessor session;
+        applySession(session);
+
+        struct Result
+        {
+            double saveMicroseconds = 0.0;
+            double loadMicroseconds = 0.0;
+        };
+
+        // Fresh instances per format, so every load really changes parameters
+        const auto measure = [&](bool binary)
+        {
+            std::vector<std::unique_ptr<GRAINAudioProcessor>> instances;
+
+            for (int i = 0; i < kNumInstances; ++i)
+            {
+                instances.push_back(std::make_unique<GRAINAudioProcessor>());
+            }
+
+            std::vector<juce::MemoryBlock> states(static_cast<size_t>(kNumInstances));
+            const double saveStart = juce::Time::getMillisecondCounterHiRes();
+
+            for (auto& state : states)
+            {
+                if (binary)
+                {
+                    session.getStateInformation(state);
+                }
+                else
+                {
+                    state = getXmlState(session);
+                }
+            }
+
+            const double loadStart = juce::Time::getMillisecondCounterHiRes();
+
+            for (size_t i = 0; i < instances.size(); ++i)
+            {
+                instances[i]->setStateInformation(states[i].getData(), static_cast<int>(states[i].getSize()));
+            }
+
+            const double end = juce::Time::getMillisecondCounterHiRes();
+            expectLessThan(maxParameterDifference(session, *instances.back()), 1.0e-6f);
+
+            return Result{(loadStart - saveStart) * 1000.0 / kNumInstances, (end - loadStart) * 1000.0 / kNumInstances};
+        };
+
+        const auto xml = measure(false);
+        const auto binary = measure(true);
+
+        logMessage("Per instance, XML:    save " + juce::String(xml.saveMicroseconds, 2) + " us, load "
+                   + juce::String(xml.loadMicroseconds, 2) + " us");
+        logMessage("Per instance, binary: save " + juce::String(binary.saveMicroseconds, 2) + " us, load "
+                   + juce::String(binary.loadMicroseconds, 2) + " us");
+    }
+};
+
+//==============================================================================
+static StateCodecTest
+    stateCodecTest;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables,misc-use-anonymous-namespace)
@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    StateTest.cpp
+    Unit tests for DSP state snapshots.
+    Verifies that LinearSmoother matches juce::SmoothedValue, that pipeline
+    and smoother state resume bit-exactly, and the blob header checks.
+
+  ==============================================================================
+*/
+
+#include "../DSP/LinearSmoother.h"
+#include "../DSP/ProcessorState.h"
+
+#include <JuceHeader.h>
+#include <vector>
+
+//==============================================================================
+class StateTest : public juce::UnitTest
+{
+public:
+    StateTest() : juce::UnitTest("GRAIN State") {}
+
+    void runTest() override
+    {
+        runSmootherMatchesJuceTest();
+        runSmootherResumesMidRampTest();
+        runPipelineResumesTest();
+        runBlobValidationTest();
+    }
+
+private:
+    static constexpr float kSampleRate = 88200.0f;
+
+    //==============================================================================
+    void runSmootherMatchesJuceTest()
+    {
+        beginTest("State: LinearSmoother is sample-identical to juce::SmoothedValue");
+
+        juce::SmoothedValue<float> reference;
+        GrainDSP::LinearSmoother smoother;
+        reference.reset(kSampleRate, 0.02);
+        smoother.reset(kSampleRate, 0.02);
+        reference.setCurrentAndTargetValue(0.25f);
+        smoother.setCurrentAndTargetValue(0.25f);
+
+        bool identical = true;
+        const float targets[] = {0.8f, 0.8f, -0.3f, 1.0f};
+
+        for (const float target : targets)
+        {
+            reference.setTargetValue(target);
+            smoother.setTargetValue(target);
+
+            // Retarget mid-ramp as well as after it completes
+            for (int i = 0; i < 1500; ++i)
+            {
+                identical = identical && juce::exactlyEqual(reference.getNextValue(), smoother.getNextValue());
+            }
+        }
+
+        expect(identical, "Every value matches exactly");
+        expectEquals(smoother.getCurrentValue(), 1.0f);
+    }
+
+    void runSmootherResumesMidRampTest()
+    {
+        beginTest("State: a smoother copied mid-ramp continues identically");
+
+        GrainDSP::LinearSmoother original;
+        original.reset(kSampleRate, 0.02);
+        original.setCurrentAndTargetValue(0.0f);
+        original.setTargetValue(1.0f);
+
+        for (int i = 0; i < 700; ++i)
+        {
+            original.getNextValue();
+        }
+
+        expect(original.isSmoothing());
+
+        const GrainDSP::LinearSmoother snapshot = original;
+        GrainDSP::LinearSmoother restored;
+        restored = snapshot;
+
+        bool identical = true;
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            identical = identical && juce::exactlyEqual(original.getNextValue(), restored.getNextValue());
+        }
+
+        expect(identical);
+    }
+
+    void runPipelineResumesTest()
+    {
+        beginTest("State: a pipeline restored from getState() continues bit-exactly");
+
+        GrainDSP::DSPPipeline original;
+        original.prepare(kSampleRate, GrainDSP::FocusMode::kHigh, GrainDSP::kDefaultCalibration);
+
+        auto sine = [](int i) { return 0.7f * std::sin(0.05f * static_cast<float>(i)); };
+
+        for (int i = 0; i < 4000; ++i)
+        {
+            original.processSample(sine(i), 0.3f, 0.8f, 0.5f, 0.6f, 1.0f);
+        }
+
+        // Same parameters, fresh memory, then the captured state
+        GrainDSP::DSPPipeline restored;
+        restored.prepare(kSampleRate, GrainDSP::FocusMode::kHigh, GrainDSP::kDefaultCalibration);
+        restored.setState(original.getState());
+
+        GrainDSP::DSPPipeline cold;
+        cold.prepare(kSampleRate, GrainDSP::FocusMode::kHigh, GrainDSP::kDefaultCalibration);
+
+        bool identical = true;
+        float coldError = 0.0f;
+
+        for (int i = 4000; i < 6000; ++i)
+        {
+            const float expected = original.processSample(sine(i), 0.3f, 0.8f, 0.5f, 0.6f, 1.0f);
+            identical = identical
+                        && juce::exactlyEqual(expected, restored.processSample(sine(i), 0.3f, 0.8f, 0.5f, 0.6f, 1.0f));
+            coldError = std::max(coldError,
+                                 std::abs(expected - cold.processSample(sine(i), 0.3f, 0.8f, 0.5f, 0.6f, 1.0f)));
+        }
+
+        expect(identical, "Restored pipeline matches");
+        expect(coldError > 1.0e-4f, "A cold pipeline differs, so the state matters");
+    }
+
+    void runBlobValidationTest()
+    {
+        beginTest("State: ProcessorState round-trips as bytes and rejects foreign blobs");
+
+        auto state = std::make_unique<GrainDSP::ProcessorState>();
+        state->sampleRate = 48000.0;
+        state->oversamplingFactor = 2;
+        state->numChannels = 2;
+        state->pipelines[1].highShelfZ2 = 0.125f;
+        state->mix.countdown = 17;
+        state->wetHistory[1][100] = -0.5f;
+
+        std::vector<char> bytes(sizeof(GrainDSP::ProcessorState));
+        std::memcpy(bytes.data(), state.get(), bytes.size());
+
+        auto loaded = std::make_unique<GrainDSP::ProcessorState>();
+        expect(GrainDSP::ProcessorState::fromBytes(bytes.data(), bytes.size(), *loaded));
+        expectEquals(loaded->pipelines[1].highShelfZ2, 0.125f);
+        expectEquals(loaded->mix.countdown, 17);
+        expectEquals(loaded->wetHistory[1][100], -0.5f);
+
+        expect(!GrainDSP::ProcessorState::fromBytes(bytes.data(), bytes.size() - 1, *loaded), "Wrong size");
+
+        bytes[0] ^= 0x01;
+        loaded->mix.countdown = 3;
+        expect(!GrainDSP::ProcessorState::fromBytes(bytes.data(), bytes.size(), *loaded), "Wrong magic");
+        expectEquals(loaded->mix.countdown, 3);
+    }
+};
+
+//==============================================================================
+static StateTest stateTest;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables,misc-use-anonymous-namespace)
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    TelemetryTest.cpp
+    Unit tests for the packed WebView telemetry frames.
+    Checks the wire layout the JS decoder relies on, the base64 round trip
+    and change detection used to skip unchanged frames.
+
+  ==============================================================================
+*/
+
+#include "../UI/TelemetryPacker.h"
+
+#include <JuceHeader.h>
+#include <cstring>
+
+//==============================================================================
+class TelemetryTest : public juce::UnitTest
+{
+public:
+    TelemetryTest() : juce::UnitTest("GRAIN Telemetry") {}
+
+    void runTest() override
+    {
+        runLayoutTest();
+        runSectionOrderTest();
+        runBase64RoundTripTest();
+        runChangeDetectionTest();
+    }
+
+private:
+    static juce::uint32 readWord(const juce::uint8* bytes, size_t offset)
+    {
+        return static_cast<juce::uint32>(bytes[offset]) | (static_cast<juce::uint32>(bytes[offset + 1]) << 8)
+               | (static_cast<juce::uint32>(bytes[offset + 2]) << 16)
+               | (static_cast<juce::uint32>(bytes[offset + 3]) << 24);
+    }
+
+    static float readFloat(const juce::uint8* bytes, size_t offset)
+    {
+        const juce::uint32 bits = readWord(bytes, offset);
+        float value = 0.0f;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    //==============================================================================
+    void runLayoutTest()
+    {
+        beginTest("Telemetry: header, count and little-endian floats");
+
+        TelemetryPacker packer;
+        packer.beginFrame();
+        packer.addSection(TelemetryPacker::kMeters, {0.5f, -1.0f, 0.25f, 1.0f, -3.0f});
+
+        const auto& frame = packer.getFrameBytes();
+        expectEquals(static_cast<int>(frame.size()), 8 + 4 + 5 * 4);
+        expectEquals(static_cast<int>(readWord(frame.data(), 0)), static_cast<int>(TelemetryPacker::kVersion));
+        expectEquals(static_cast<int>(readWord(frame.data(), 4)), static_cast<int>(TelemetryPacker::kMeters));
+        expectEquals(static_cast<int>(readWord(frame.data(), 8)), 5);
+        expectEquals(readFloat(frame.data(), 12), 0.5f);
+        expectEquals(readFloat(frame.data(), 16), -1.0f);
+        expectEquals(readFloat(frame.data(), 28), -3.0f);
+    }
+
+    void runSectionOrderTest()
+    {
+        beginTest("Telemetry: optional sections are skipped in the flags");
+
+        TelemetryPacker packer;
+        packer.beginFrame();
+        packer.addSection(TelemetryPacker::kMeters, {1.0f});
+        packer.addSection(TelemetryPacker::kEnvelope, {0.125f});
+
+        const auto& frame = packer.getFrameBytes();
+        const auto flags = readWord(frame.data(), 4);
+        expectEquals(static_cast<int>(flags), static_cast<int>(TelemetryPacker::kMeters | TelemetryPacker::kEnvelope));
+
+        // Envelope section directly follows the meters section
+        expectEquals(static_cast<int>(readWord(frame.data(), 16)), 1);
+        expectEquals(readFloat(frame.data(), 20), 0.125f);
+
+        // beginFrame() clears sections
+        packer.beginFrame();
+        expectEquals(static_cast<int>(packer.getFrameBytes().size()), 8);
+        expectEquals(static_cast<int>(readWord(packer.getFrameBytes().data(), 4)), 0);
+    }
+
+    void runBase64RoundTripTest()
+    {
+        beginTest("Telemetry: committed base64 decodes to the packed bytes");
+
+        TelemetryPacker packer;
+        packer.beginFrame();
+        packer.addSection(TelemetryPacker::kLoudness, {-23.0f, -18.5f, -20.25f, 1.5f});
+
+        std::array<float, 36> analysis{};
+        for (size_t i = 0; i < analysis.size(); ++i)
+        {
+            analysis[i] = static_cast<float>(i) * 0.5f - 4.0f;
+        }
+        packer.addSection(TelemetryPacker::kAnalysis, analysis.data(), static_cast<int>(analysis.size()));
+
+        const auto expected = packer.getFrameBytes();
+        const auto encoded = packer.commit();
+
+        juce::MemoryBlock decoded;
+        expect(decoded.fromBase64Encoding(encoded));
+        expectEquals(static_cast<int>(decoded.getSize()), static_cast<int>(expected.size()));
+        expect(std::memcmp(decoded.getData(), expected.data(), expected.size()) == 0,
+               "Base64 payload must carry the exact packed frame");
+    }
+
+    void runChangeDetectionTest()
+    {
+        beginTest("Telemetry: identical frames are reported unchanged");
+
+        TelemetryPacker packer;
+        packer.beginFrame();
+        packer.addSection(TelemetryPacker::kMeters, {0.1f, 0.2f, 0.3f, 0.4f, -6.0f});
+        expect(packer.hasChangedSinceLastCommit(), "First frame must be sent");
+        packer.commit();
+
+        packer.beginFrame();
+        packer.addSection(TelemetryPacker::kMeters, {0.1f, 0.2f, 0.3f, 0.4f, -6.0f});
+        expect(!packer.hasChangedSinceLastCommit(), "Same values must not be resent");
+
+        packer.beginFrame();
+        packer.addSection(TelemetryPacker::kMeters, {0.1f, 0.2f, 0.3f, 0.4f, -5.9f});
+        expect(packer.hasChangedSinceLastCommit(), "Any value change must be sent");
+    }
+};
+
+//==============================================================================
+static TelemetryTest
+    telemetryTest;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables,misc-use-anonymous-namespace)
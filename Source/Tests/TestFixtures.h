@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+    TestFixtures.h
+    Helpers shared by the GRAIN unit tests.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace TestFixtures
+{
+//==============================================================================
+/**
+ * Peak cache directory for FilePlayerSource instances under test, so test runs
+ * never write into the user's app-data cache. Emptied on first use in each run.
+ */
+inline juce::File getPeakCacheDirectory()
+{
+    static const juce::File directory = []
+    {
+        auto dir = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("GRAINTestPeakCache");
+        dir.deleteRecursively();
+        return dir;
+    }();
+
+    return directory;
+}
+
+//==============================================================================
+/** Set a parameter of the shipped processor to a plain (unnormalised) value, as host automation would. */
+inline void setParameter(juce::AudioProcessorValueTreeState& apvts, const juce::String& parameterId, float value)
+{
+    auto* parameter = apvts.getParameter(parameterId);
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+}
+
+//==============================================================================
+/**
+ * Write a buffer to a temporary audio file, which the caller deletes.
+ * @param format Container to write (the file takes its first extension)
+ * @return The file, or File() if it could not be written
+ */
+inline juce::File writeTempAudioFile(juce::AudioFormat& format, const juce::AudioBuffer<float>& buffer,
+                                     double sampleRate, int bitsPerSample)
+{
+    auto tempFile = juce::File::createTempFile(format.getFileExtensions()[0]);
+    std::unique_ptr<juce::OutputStream> outputStream = tempFile.createOutputStream();
+
+    if (outputStream == nullptr)
+    {
+        return {};
+    }
+
+    auto options = juce::AudioFormatWriterOptions()
+                       .withSampleRate(sampleRate)
+                       .withNumChannels(buffer.getNumChannels())
+                       .withBitsPerSample(bitsPerSample);
+    auto writer = format.createWriterFor(outputStream, options);
+
+    if (writer == nullptr)
+    {
+        return {};
+    }
+
+    writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+    writer.reset();
+
+    return tempFile;
+}
+
+/** Write a buffer to a temporary WAV file (32-bit float unless told otherwise). */
+inline juce::File writeTempWavFile(const juce::AudioBuffer<float>& buffer, double sampleRate, int bitsPerSample = 32)
+{
+    juce::WavAudioFormat wavFormat;
+    return writeTempAudioFile(wavFormat, buffer, sampleRate, bitsPerSample);
+}
+
+/** @return A sine at half scale, the same on every channel. */
+inline juce::AudioBuffer<float> createSineBuffer(double sampleRate, int numChannels, double durationSeconds,
+                                                 float frequency = 440.0f)
+{
+    auto const totalSamples = static_cast<int>(sampleRate * durationSeconds);
+    juce::AudioBuffer<float> buffer(numChannels, totalSamples);
+
+    for (int i = 0; i < totalSamples; ++i)
+    {
+        auto const sample = 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * frequency * static_cast<float>(i) /
+                                            static_cast<float>(sampleRate));
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            buffer.setSample(ch, i, sample);
+        }
+    }
+
+    return buffer;
+}
+
+/** @return A buffer holding one constant value per channel. */
+inline juce::AudioBuffer<float> createConstantBuffer(const juce::Array<float>& channelValues, int numSamples)
+{
+    juce::AudioBuffer<float> buffer(channelValues.size(), numSamples);
+
+    for (int ch = 0; ch < channelValues.size(); ++ch)
+    {
+        juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), channelValues[ch], numSamples);
+    }
+
+    return buffer;
+}
+
+/** Temporary 16-bit WAV holding createSineBuffer(): the file the player and display tests load. */
+inline juce::File createSineWavFile(double sampleRate, int numChannels, double durationSeconds,
+                                    float frequency = 440.0f)
+{
+    return writeTempWavFile(createSineBuffer(sampleRate, numChannels, durationSeconds, frequency), sampleRate, 16);
+}
+
+//==============================================================================
+/** Stateless stereo gain behind a fixed reported delay (0 for none), for renderer and streamer tests. */
+class DelayGainProcessor : public juce::AudioProcessor
+{
+public:
+    DelayGainProcessor(float gainToUse, int latencyToUse)
+        : juce::AudioProcessor(BusesProperties()
+                                   .withInput("Input", juce::AudioChannelSet::stereo(), true)
+                                   .withOutput("Output", juce::AudioChannelSet::stereo(), true))
+        , gain(gainToUse)
+        , latency(latencyToUse)
+    {
+    }
+
+    void prepareToPlay(double, int) override
+    {
+        delayLines.assign(2, std::vector<float>(static_cast<size_t>(std::max(latency, 1)), 0.0f));
+        delayIndex = 0;
+        setLatencySamples(latency);
+    }
+
+    void releaseResources() override {}
+
+    void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override
+    {
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                float sample = buffer.getSample(ch, i) * gain;
+
+                if (latency > 0)
+                {
+                    std::swap(sample, delayLines[static_cast<size_t>(ch)][static_cast<size_t>(delayIndex)]);
+                }
+
+                buffer.setSample(ch, i, sample);
+            }
+
+            delayIndex = latency > 0 ? (delayIndex + 1) % latency : 0;
+        }
+    }
+
+    const juce::String getName() const override { return "DelayGain"; }
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+    double getTailLengthSeconds() const override { return 0.0; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    bool hasEditor() const override { return false; }
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+    void getStateInformation(juce::MemoryBlock&) override {}
+    void setStateInformation(const void*, int) override {}
+
+private:
+    float gain;
+    int latency;
+    std::vector<std::vector<float>> delayLines;
+    int delayIndex = 0;
+};
+
+}  // namespace TestFixtures
@@ -11,56 +11,10 @@
 #include "../Standalone/TransportBar.h"
 
 #include "../Standalone/FilePlayerSource.h"
+#include "TestFixtures.h"
 
 #include <JuceHeader.h>
 
-//==============================================================================
-namespace
-{
-
-/** Create a temporary WAV file with a sine wave (shared with FilePlayerTest). */
-juce::File createTestWavFileForTransport(double sampleRate, int numChannels, double durationSeconds)
-{
-    auto tempFile = juce::File::createTempFile(".wav");
-    std::unique_ptr<juce::OutputStream> outputStream = tempFile.createOutputStream();
-
-    if (outputStream == nullptr)
-    {
-        return {};
-    }
-
-    juce::WavAudioFormat wavFormat;
-    auto options =
-        juce::AudioFormatWriterOptions().withSampleRate(sampleRate).withNumChannels(numChannels).withBitsPerSample(16);
-    auto writer = wavFormat.createWriterFor(outputStream, options);
-
-    if (writer == nullptr)
-    {
-        return {};
-    }
-
-    int const totalSamples = static_cast<int>(sampleRate * durationSeconds);
-    juce::AudioBuffer<float> buffer(numChannels, totalSamples);
-
-    for (int i = 0; i < totalSamples; ++i)
-    {
-        float const sample = 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 440.0f * static_cast<float>(i) /
-                                             static_cast<float>(sampleRate));
-
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            buffer.setSample(ch, i, sample);
-        }
-    }
-
-    writer->writeFromAudioSampleBuffer(buffer, 0, totalSamples);
-    writer.reset();
-
-    return tempFile;
-}
-
-}  // namespace
-
 //==============================================================================
 class TransportBarTest : public juce::UnitTest
 {
@@ -95,7 +49,7 @@ private:
     {
         beginTest("TransportBar: initial button states (no file loaded)");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         TransportBar bar(player);
 
         // With no file loaded, play/stop and loop should be disabled
@@ -113,10 +67,10 @@ private:
     {
         beginTest("TransportBar: button states after file load");
 
-        auto tempFile = createTestWavFileForTransport(44100.0, 2, 1.0);
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 1.0);
         expect(tempFile.existsAsFile(), "Failed to create test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         player.loadFile(tempFile);
         player.prepareToPlay(44100.0, 512);
 
@@ -135,10 +89,10 @@ private:
     {
         beginTest("TransportBar: play/stop button reflects state");
 
-        auto tempFile = createTestWavFileForTransport(44100.0, 2, 1.0);
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 1.0);
         expect(tempFile.existsAsFile(), "Failed to create test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         player.loadFile(tempFile);
         player.prepareToPlay(44100.0, 512);
 
@@ -167,10 +121,10 @@ private:
     {
         beginTest("TransportBar: progress tracking with seek");
 
-        auto tempFile = createTestWavFileForTransport(44100.0, 2, 2.0);
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 2.0);
         expect(tempFile.existsAsFile(), "Failed to create test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         player.loadFile(tempFile);
         player.prepareToPlay(44100.0, 512);
 
@@ -9,58 +9,14 @@
   ==============================================================================
 */
 
+#include "../DSP/PeakDecimator.h"
+#include "../DSP/PeakPyramid.h"
 #include "../Standalone/FilePlayerSource.h"
 #include "../Standalone/WaveformDisplay.h"
+#include "TestFixtures.h"
 
 #include <JuceHeader.h>
 
-//==============================================================================
-namespace
-{
-
-/** Create a temporary WAV file with a sine wave for testing. */
-juce::File createTestWavFileForWaveform(double sampleRate, int numChannels, double durationSeconds)
-{
-    auto tempFile = juce::File::createTempFile(".wav");
-    std::unique_ptr<juce::OutputStream> outputStream = tempFile.createOutputStream();
-
-    if (outputStream == nullptr)
-    {
-        return {};
-    }
-
-    juce::WavAudioFormat wavFormat;
-    auto options =
-        juce::AudioFormatWriterOptions().withSampleRate(sampleRate).withNumChannels(numChannels).withBitsPerSample(16);
-    auto writer = wavFormat.createWriterFor(outputStream, options);
-
-    if (writer == nullptr)
-    {
-        return {};
-    }
-
-    auto const totalSamples = static_cast<int>(sampleRate * durationSeconds);
-    juce::AudioBuffer<float> buffer(numChannels, totalSamples);
-
-    for (int i = 0; i < totalSamples; ++i)
-    {
-        auto const sample = 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 440.0f * static_cast<float>(i) /
-                                            static_cast<float>(sampleRate));
-
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            buffer.setSample(ch, i, sample);
-        }
-    }
-
-    writer->writeFromAudioSampleBuffer(buffer, 0, totalSamples);
-    writer.reset();
-
-    return tempFile;
-}
-
-}  // namespace
-
 //==============================================================================
 class WaveformDisplayTest : public juce::UnitTest
 {
@@ -73,6 +29,11 @@ public:
         runLoadedFileRenderTest();
         runClickPositionMappingTest();
         runWetBufferAccumulationTest();
+        runPeakDecimatorBlockSizeTest();
+        runPeakDecimatorDiscontinuityTest();
+        runPeakPyramidLevelsTest();
+        runPeakPyramidLimitTest();
+        runZoomMappingTest();
     }
 
 private:
@@ -81,7 +42,7 @@ private:
     {
         beginTest("WaveformDisplay: renders without crash for empty state");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         WaveformDisplay display(player);
 
         // Set a reasonable size
@@ -102,10 +63,10 @@ private:
     {
         beginTest("WaveformDisplay: renders without crash for loaded file");
 
-        auto tempFile = createTestWavFileForWaveform(44100.0, 2, 1.0);
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 1.0);
         expect(tempFile.existsAsFile(), "Failed to create test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         player.loadFile(tempFile);
         player.prepareToPlay(44100.0, 512);
 
@@ -131,10 +92,10 @@ private:
     {
         beginTest("WaveformDisplay: click position maps correctly to file time");
 
-        auto tempFile = createTestWavFileForWaveform(44100.0, 2, 2.0);
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 2, 2.0);
         expect(tempFile.existsAsFile(), "Failed to create test WAV file");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         player.loadFile(tempFile);
         player.prepareToPlay(44100.0, 512);
 
@@ -177,7 +138,7 @@ private:
     {
         beginTest("WaveformDisplay: wet waveform buffer accumulates samples");
 
-        FilePlayerSource player;
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
         WaveformDisplay display(player);
         display.setSize(400, 120);
 
@@ -196,7 +157,7 @@ private:
         display.pushWetSamples(testSamples.data(), kNumSamples, 0);
 
         // After pushing, the FIFO has data but wet columns aren't updated
-        // until timerCallback drains the FIFO. We check hasWetData is still false
+        // until the next refresh tick drains the FIFO. We check hasWetData is still false
         // because the data is in the FIFO, not yet in the columns.
         // This verifies the push didn't crash and FIFO accepted data.
 
@@ -204,6 +165,205 @@ private:
         display.clearWetBuffer();
         expect(!display.hasWetData(), "Should have no wet data after clear");
     }
+
+    //==========================================================================
+    /** Decimate `total` samples of a ramp in blocks of `blockSize`, return the emitted peaks. */
+    static std::vector<GrainDSP::PeakSummary> decimateRamp(int total, int blockSize)
+    {
+        std::vector<float> ramp(static_cast<size_t>(total));
+        for (int i = 0; i < total; ++i)
+        {
+            ramp[static_cast<size_t>(i)] = static_cast<float>(i) / static_cast<float>(total);
+        }
+
+        GrainDSP::PeakDecimator decimator;
+        std::vector<GrainDSP::PeakSummary> peaks;
+        auto const collect = [&peaks](const GrainDSP::PeakSummary& p) { peaks.push_back(p); };
+
+        for (int start = 0; start < total; start += blockSize)
+        {
+            decimator.process(ramp.data() + start, std::min(blockSize, total - start), start, collect);
+        }
+
+        decimator.flush(collect);
+        return peaks;
+    }
+
+    void runPeakDecimatorBlockSizeTest()
+    {
+        beginTest("PeakDecimator: same peaks for any block size, every sample covered");
+
+        constexpr int kTotal = 48000;
+        auto const reference = decimateRamp(kTotal, 512);
+
+        // 48000 / 128 = 375 full peaks
+        expectEquals(static_cast<int>(reference.size()), kTotal / GrainDSP::PeakDecimator::kSamplesPerPeak);
+
+        for (const int blockSize : {1, 37, 128, 1000, 4096})
+        {
+            auto const peaks = decimateRamp(kTotal, blockSize);
+            expectEquals(static_cast<int>(peaks.size()), static_cast<int>(reference.size()));
+
+            int covered = 0;
+            bool identical = true;
+            for (size_t i = 0; i < peaks.size() && i < reference.size(); ++i)
+            {
+                covered += peaks[i].numSamples;
+                identical = identical && peaks[i].startPosition == reference[i].startPosition
+                            && peaks[i].minVal == reference[i].minVal && peaks[i].maxVal == reference[i].maxVal;
+            }
+
+            expectEquals(covered, kTotal);
+            expect(identical, "Peaks must not depend on block size");
+        }
+    }
+
+    void runPeakDecimatorDiscontinuityTest()
+    {
+        beginTest("PeakDecimator: seek emits the partial peak and realigns");
+
+        GrainDSP::PeakDecimator decimator;
+        std::vector<GrainDSP::PeakSummary> peaks;
+        auto const collect = [&peaks](const GrainDSP::PeakSummary& p) { peaks.push_back(p); };
+
+        const std::vector<float> block(100, 0.25f);
+        decimator.process(block.data(), 100, 0, collect);
+        expect(peaks.empty(), "Partial peak is held until complete");
+
+        // Jump (seek / loop wrap): the 100-sample partial is emitted first; the new data
+        // starts at 1000, off the 128 grid, so its first peak ends at the 1024 boundary
+        decimator.process(block.data(), 100, 1000, collect);
+        expectEquals(static_cast<int>(peaks.size()), 2);
+        expectEquals(peaks[0].numSamples, 100);
+        expectEquals(static_cast<int>(peaks[1].startPosition), 1000);
+        expectEquals(peaks[1].numSamples, 24);
+
+        decimator.flush(collect);
+        expectEquals(static_cast<int>(peaks.size()), 3);
+        expectEquals(static_cast<int>(peaks[2].startPosition), 1024);
+        expectEquals(peaks[2].numSamples, 76);
+    }
+
+    //==========================================================================
+    void runPeakPyramidLevelsTest()
+    {
+        beginTest("PeakPyramid: every level matches a brute-force min/max");
+
+        constexpr int kTotal = 100000;
+        auto const peaks = decimateRamp(kTotal, 4096);
+
+        GrainDSP::PeakPyramid pyramid;
+        pyramid.reset(kTotal);
+
+        // Arrival order does not matter
+        for (auto it = peaks.rbegin(); it != peaks.rend(); ++it)
+        {
+            pyramid.merge(*it);
+        }
+
+        // 782 base buckets -> 391 -> 196 -> ... -> 1
+        expectEquals(pyramid.getNumLevels(), 11);
+
+        for (int level = 0; level < pyramid.getNumLevels(); ++level)
+        {
+            bool allMatch = true;
+            auto const bucketSamples = GrainDSP::PeakPyramid::getBucketSamples(level);
+
+            for (juce::int64 start = 0; start < kTotal; start += bucketSamples)
+            {
+                auto const end = std::min<juce::int64>(start + bucketSamples, kTotal);
+                GrainDSP::PeakPyramid::Bucket bucket;
+                pyramid.getRange(level, start, end, kTotal, bucket);
+
+                // Ramp: min at the first sample, max at the last
+                allMatch = allMatch && bucket.minVal == static_cast<float>(start) / static_cast<float>(kTotal)
+                           && bucket.maxVal == static_cast<float>(end - 1) / static_cast<float>(kTotal);
+            }
+
+            expect(allMatch, "Level " + juce::String(level) + " disagrees with the samples");
+        }
+
+        // One pixel per 1000 samples reads level 2 (512-sample buckets), at most three per pixel
+        expectEquals(pyramid.getLevelForSpan(1000.0), 2);
+        expectEquals(pyramid.getLevelForSpan(10.0), 0);
+
+        pyramid.clear();
+        GrainDSP::PeakPyramid::Bucket bucket;
+        expect(!pyramid.getRange(0, 0, kTotal, kTotal, bucket), "clear() empties every bucket");
+    }
+
+    void runPeakPyramidLimitTest()
+    {
+        beginTest("PeakPyramid: reads stop at the published limit");
+
+        constexpr int kTotal = 4096;
+        auto const peaks = decimateRamp(kTotal, 512);
+
+        GrainDSP::PeakPyramid pyramid;
+        pyramid.reset(kTotal);
+
+        // Half the file summarised so far
+        for (size_t i = 0; i < peaks.size() / 2; ++i)
+        {
+            pyramid.merge(peaks[i]);
+        }
+
+        GrainDSP::PeakPyramid::Bucket bucket;
+        expect(pyramid.getRange(0, 0, kTotal, kTotal / 2, bucket));
+        expectEquals(bucket.maxVal, static_cast<float>(kTotal / 2 - 1) / static_cast<float>(kTotal));
+
+        // The top bucket covers the whole file, so it is not final yet
+        expect(!pyramid.getRange(pyramid.getNumLevels() - 1, 0, kTotal, kTotal / 2, bucket));
+    }
+
+    void runZoomMappingTest()
+    {
+        beginTest("WaveformDisplay: zoom and scroll keep the click mapping in file time");
+
+        auto tempFile = TestFixtures::createSineWavFile(44100.0, 1, 2.0);
+        expect(tempFile.existsAsFile(), "Failed to create test WAV file");
+
+        FilePlayerSource player(TestFixtures::getPeakCacheDirectory());
+        player.loadFile(tempFile);
+
+        WaveformDisplay display(player);
+        display.setSize(408, 120);  // 400-pixel waveform area
+
+        auto const total = static_cast<double>(player.getFileLengthInSamples());
+        expectEquals(display.getVisibleRange().getLength(), total);
+
+        // Second half of the file
+        display.setVisibleRange(total * 0.5, total * 0.5);
+        auto bounds = display.getWaveformBounds();
+        expectWithinAbsoluteError(display.pixelToNormalized(bounds.getX()), 0.5f, 0.001f);
+        expectWithinAbsoluteError(display.pixelToNormalized(bounds.getRight()), 1.0f, 0.001f);
+        expectEquals(display.normalizedToPixel(0.75f), bounds.getCentreX());
+
+        // Zooming around an anchor keeps it under the same pixel
+        const int anchorPixel = display.normalizedToPixel(0.6f);
+        display.zoomAround(total * 0.6, 8.0);
+        expect(std::abs(display.normalizedToPixel(0.6f) - anchorPixel) <= 1, "Anchor moved while zooming");
+
+        // Clamped at sample level and to the file
+        display.setVisibleRange(1000.0, 1.0);
+        expectWithinAbsoluteError(display.getVisibleRange().getLength(),
+                                  bounds.getWidth() * WaveformDisplay::kMinSamplesPerPixel, 1.0e-9);
+        display.setVisibleRange(total, total * 0.25);
+        expectWithinAbsoluteError(display.getVisibleRange().getEnd(), total, 1.0e-6);
+
+        // Painting at sample level and resizing must not crash or reset the view
+        juce::Image const image(juce::Image::ARGB, 408, 120, true);
+        juce::Graphics g(image);
+        display.setVisibleRange(1000.0, 50.0);
+        display.paint(g);
+        display.setSize(208, 120);
+        expectWithinAbsoluteError(display.getVisibleRange().getStart(), 1000.0, 1.0e-9);
+
+        display.zoomToFit();
+        expectEquals(display.getVisibleRange().getLength(), total);
+
+        tempFile.deleteFile();
+    }
 };
 
 //==============================================================================
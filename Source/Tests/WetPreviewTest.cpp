@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    WetPreviewTest.cpp
+    Unit tests for the background wet waveform renderer.
+    Verifies full peak coverage, latency compensation and that a new job
+    bumps the generation so readers restart.
+
+  ==============================================================================
+*/
+
+#include "../Standalone/WetPreviewRenderer.h"
+#include "TestFixtures.h"
+
+#include <JuceHeader.h>
+
+//==============================================================================
+class WetPreviewTest : public juce::UnitTest
+{
+public:
+    WetPreviewTest() : juce::UnitTest("GRAIN WetPreview") {}
+
+    void runTest() override
+    {
+        runCoversWholeFileTest();
+        runLatencyCompensationTest();
+        runGenerationTest();
+    }
+
+private:
+    static constexpr double kSampleRate = 44100.0;
+    static constexpr int kNumSamples = 20000;
+
+    static WetPreviewRenderer::ProcessorFactory makeFactory(float gain, int latency)
+    {
+        return [gain, latency]() { return std::make_unique<TestFixtures::DelayGainProcessor>(gain, latency); };
+    }
+
+    /** @return A temporary mono float WAV holding 0.5 throughout. */
+    static juce::File createConstantWavFile()
+    {
+        return TestFixtures::writeTempWavFile(TestFixtures::createConstantBuffer({0.5f}, kNumSamples), kSampleRate);
+    }
+
+    //==============================================================================
+    void runCoversWholeFileTest()
+    {
+        beginTest("WetPreview: renders one peak per 128 samples of processed output");
+
+        auto file = createConstantWavFile();
+        WetPreviewRenderer renderer(makeFactory(0.5f, 0));
+        renderer.setFile(file);
+        renderer.renderNow();
+
+        expect(renderer.waitForCompletion(10000), "Render finishes");
+        expectWithinAbsoluteError(renderer.getProgress(), 1.0f, 1.0e-6f);
+
+        const int expectedPeaks =
+            (kNumSamples + GrainDSP::PeakDecimator::kSamplesPerPeak - 1) / GrainDSP::PeakDecimator::kSamplesPerPeak;
+        expectEquals(renderer.getNumPeaksReady(), expectedPeaks);
+
+        juce::int64 covered = 0;
+
+        for (int i = 0; i < renderer.getNumPeaksReady(); ++i)
+        {
+            const auto& peak = renderer.getPeak(i);
+            expectEquals(static_cast<juce::int64>(peak.startPosition), covered);
+            expectWithinAbsoluteError(peak.maxVal, 0.25f, 1.0e-6f);
+            covered += peak.numSamples;
+        }
+
+        expectEquals(covered, static_cast<juce::int64>(kNumSamples));
+        file.deleteFile();
+    }
+
+    void runLatencyCompensationTest()
+    {
+        beginTest("WetPreview: processor latency is compensated");
+
+        auto file = createConstantWavFile();
+        WetPreviewRenderer renderer(makeFactory(1.0f, 1000));
+        renderer.setFile(file);
+        renderer.renderNow();
+
+        expect(renderer.waitForCompletion(10000), "Render finishes");
+        expect(renderer.getNumPeaksReady() > 0);
+
+        // Without compensation the first peaks would hold the delay line's silence
+        expectWithinAbsoluteError(renderer.getPeak(0).minVal, 0.5f, 1.0e-6f);
+
+        const auto& last = renderer.getPeak(renderer.getNumPeaksReady() - 1);
+        expectEquals(static_cast<juce::int64>(last.startPosition + last.numSamples),
+                     static_cast<juce::int64>(kNumSamples));
+        expectWithinAbsoluteError(last.minVal, 0.5f, 1.0e-6f);
+        file.deleteFile();
+    }
+
+    void runGenerationTest()
+    {
+        beginTest("WetPreview: each job starts a new generation");
+
+        auto file = createConstantWavFile();
+        WetPreviewRenderer renderer(makeFactory(1.0f, 0));
+        int jobsStarted = 0;
+        renderer.onJobStarted = [&jobsStarted]() { ++jobsStarted; };
+
+        renderer.setFile(file);
+        renderer.renderNow();
+        const auto first = renderer.getGeneration();
+        renderer.waitForCompletion(10000);
+
+        renderer.parametersChanged();
+        expect(!renderer.isRendering(), "Parameter change cancels until the debounce fires");
+
+        renderer.renderNow();
+        expect(renderer.getGeneration() != first, "New job, new generation");
+        renderer.waitForCompletion(10000);
+        expectEquals(jobsStarted, 2);
+
+        // Unloading stops and publishes nothing
+        renderer.setFile({});
+        renderer.renderNow();
+        expectEquals(renderer.getNumPeaksReady(), 0);
+        expect(!renderer.isRendering());
+        file.deleteFile();
+    }
+};
+
+//==============================================================================
+static WetPreviewTest
+    wetPreviewTest;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables,misc-use-anonymous-namespace)
@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+    RefreshScheduler.cpp
+    GRAIN — Shared, change-driven UI refresh implementation.
+
+  ==============================================================================
+*/
+
+#include "RefreshScheduler.h"
+
+//==============================================================================
+RefreshScheduler::Registration::Registration(Client& clientToRegister, Mode initialMode) : client(clientToRegister)
+{
+    scheduler->add(client, initialMode);
+}
+
+RefreshScheduler::Registration::~Registration()
+{
+    scheduler->remove(client);
+}
+
+void RefreshScheduler::Registration::wake()
+{
+    scheduler->setMode(client, Mode::kActive);
+}
+
+RefreshScheduler::Mode RefreshScheduler::Registration::getMode() const
+{
+    return scheduler->getMode(client);
+}
+
+//==============================================================================
+RefreshScheduler::~RefreshScheduler()
+{
+    // All registrations hold a reference, so nothing can still be registered here
+    jassert(entries.empty());
+    stopTimer();
+}
+
+//==============================================================================
+void RefreshScheduler::add(Client& client, Mode initialMode)
+{
+    entries.push_back({&client, initialMode});
+    updateSources();
+}
+
+void RefreshScheduler::remove(Client& client)
+{
+    const auto isClient = [&client](const Entry& e) { return e.client == &client; };
+    entries.erase(std::remove_if(entries.begin(), entries.end(), isClient), entries.end());
+
+    if (vblankAnchor == &client)
+    {
+        retireVBlank();
+    }
+
+    updateSources();
+}
+
+void RefreshScheduler::setMode(Client& client, Mode mode)
+{
+    for (auto& entry : entries)
+    {
+        if (entry.client == &client)
+        {
+            if (entry.mode == mode)
+            {
+                return;
+            }
+
+            entry.mode = mode;
+            break;
+        }
+    }
+
+    updateSources();
+}
+
+RefreshScheduler::Mode RefreshScheduler::getMode(const Client& client) const
+{
+    for (const auto& entry : entries)
+    {
+        if (entry.client == &client)
+        {
+            return entry.mode;
+        }
+    }
+
+    return Mode::kIdle;
+}
+
+//==============================================================================
+void RefreshScheduler::tick(bool fromVBlank)
+{
+    if (fromVBlank)
+    {
+        ++stats.vblankTicks;
+    }
+    else
+    {
+        ++stats.watchTicks;
+    }
+
+    // Index loop: a client may wake another client from inside refreshTick()
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const Mode mode = entries[i].mode;
+
+        // Active clients refresh on vblank (or on the watch pass while no vblank is attached);
+        // watch clients only on the watch pass
+        const bool due = mode == Mode::kActive ? (fromVBlank || vblank == nullptr)
+                                               : (mode == Mode::kWatch && !fromVBlank);
+
+        if (!due || !entries[i].client->isVisibleForRefresh())
+        {
+            continue;
+        }
+
+        ++stats.clientRefreshes;
+        entries[i].mode = entries[i].client->refreshTick();
+    }
+
+    updateSources();
+}
+
+void RefreshScheduler::vblankCallback()
+{
+    inVBlankCallback = true;
+    tick(true);
+    inVBlankCallback = false;
+}
+
+void RefreshScheduler::timerCallback()
+{
+    tick(false);
+}
+
+void RefreshScheduler::handleAsyncUpdate()
+{
+    // The vblank pass that retired these has returned. A parked attachment may have fired once more
+    // in between; that is only an extra coalesced pass.
+    retiredVBlanks.clear();
+}
+
+//==============================================================================
+void RefreshScheduler::updateSources()
+{
+    bool anyPending = false;
+    Client* anchorCandidate = nullptr;
+
+    for (const auto& entry : entries)
+    {
+        if (entry.mode == Mode::kIdle)
+        {
+            continue;
+        }
+
+        anyPending = true;
+
+        if (entry.mode == Mode::kActive && entry.client->isVisibleForRefresh())
+        {
+            // Keep the current anchor while it is still a valid one
+            if (anchorCandidate == nullptr || entry.client == vblankAnchor)
+            {
+                anchorCandidate = entry.client;
+            }
+        }
+    }
+
+    // One vblank callback for every active client, attached to a showing one
+    if (anchorCandidate == nullptr)
+    {
+        retireVBlank();
+    }
+    else if (anchorCandidate != vblankAnchor)
+    {
+        retireVBlank();
+        vblankAnchor = anchorCandidate;
+        vblank = std::make_unique<juce::VBlankAttachment>(&anchorCandidate->getRefreshComponent(),
+                                                          [this]() { vblankCallback(); });
+    }
+
+    // The watch timer covers kWatch clients and notices hidden active clients becoming visible.
+    // With every client idle it stops too: zero wakeups.
+    if (anyPending && !isTimerRunning())
+    {
+        startTimerHz(kWatchHz);
+    }
+    else if (!anyPending && isTimerRunning())
+    {
+        stopTimer();
+    }
+}
+
+void RefreshScheduler::retireVBlank()
+{
+    vblankAnchor = nullptr;
+
+    if (vblank == nullptr)
+    {
+        return;
+    }
+
+    // Destroying the attachment here would destroy the std::function that is still on the stack
+    if (inVBlankCallback)
+    {
+        retiredVBlanks.push_back(std::move(vblank));
+        triggerAsyncUpdate();
+        return;
+    }
+
+    vblank.reset();
+}
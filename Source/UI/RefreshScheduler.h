@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    RefreshScheduler.h
+    GRAIN — Shared, change-driven UI refresh for all GRAIN components.
+    Coalesces the editor, waveform and transport updates into one
+    vsync-aligned tick and stops waking up when nothing changes.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+//==============================================================================
+/**
+ * One refresh source shared by every GRAIN UI component in the process.
+ *
+ * Components register as Clients and say, on every tick, how they want to be
+ * refreshed next:
+ *   - kActive: every display refresh (VBlankAttachment on a showing client)
+ *   - kWatch:  a slow poll, for state the UI cannot be notified about
+ *              (e.g. audio-thread meters going from silent to moving)
+ *   - kIdle:   not at all, until someone calls wake()
+ *
+ * Clients whose component is not showing (closed, hidden, minimised) are not
+ * ticked. With every client idle there is no vblank callback and no timer, so
+ * the message thread gets zero wakeups from GRAIN.
+ *
+ * Shared via juce::SharedResourcePointer, so several editors in one host
+ * still produce a single coalesced tick.
+ *
+ * All methods are message-thread only.
+ */
+class RefreshScheduler : private juce::Timer,
+                         private juce::AsyncUpdater
+{
+public:
+    //==============================================================================
+    enum class Mode
+    {
+        kIdle,
+        kActive,
+        kWatch
+    };
+
+    static constexpr int kWatchHz = 10;
+
+    //==============================================================================
+    /** A component refreshed by the scheduler. */
+    class Client
+    {
+    public:
+        virtual ~Client() = default;
+
+        /** Refresh once (drain FIFOs, repaint what changed).
+         *  @return How this client wants to be refreshed from now on. */
+        virtual Mode refreshTick() = 0;
+
+        /** @return The component whose visibility gates refreshes (and may anchor the vblank). */
+        virtual juce::Component& getRefreshComponent() = 0;
+
+        /** @return true if the client is currently visible on screen. */
+        virtual bool isVisibleForRefresh() { return getRefreshComponent().isShowing(); }
+    };
+
+    /** Tick counters, for profiling the message-thread cost of the UI. */
+    struct Stats
+    {
+        juce::uint64 vblankTicks = 0;     ///< Coalesced vblank passes
+        juce::uint64 watchTicks = 0;      ///< Slow watch-timer passes
+        juce::uint64 clientRefreshes = 0; ///< Individual refreshTick() calls
+    };
+
+    //==============================================================================
+    /**
+     * RAII registration — hold one as the *last* member of the client so it is
+     * removed before anything refreshTick() uses is destroyed.
+     */
+    class Registration
+    {
+    public:
+        Registration(Client& clientToRegister, Mode initialMode);
+        ~Registration();
+
+        /** Request a refresh on the next tick (and keep refreshing while the client asks to). */
+        void wake();
+
+        /** @return The client's current mode. */
+        Mode getMode() const;
+
+        /** @return The shared scheduler (for stats and tests). */
+        RefreshScheduler& getScheduler() { return *scheduler; }
+
+    private:
+        juce::SharedResourcePointer<RefreshScheduler> scheduler;
+        Client& client;
+
+        JUCE_DECLARE_NON_COPYABLE(Registration)
+    };
+
+    //==============================================================================
+    RefreshScheduler() = default;
+    ~RefreshScheduler() override;
+
+    /** Run one refresh pass. Called by the vblank and watch sources; public for tests.
+     *  @param fromVBlank true for a display-refresh pass, false for a watch pass */
+    void tick(bool fromVBlank);
+
+    /** @return true if a vblank callback is currently attached. */
+    bool isVBlankAttached() const { return vblank != nullptr; }
+
+    /** @return true if the slow watch timer is running. */
+    bool isWatching() const { return isTimerRunning(); }
+
+    /** @return Tick counters since construction. */
+    const Stats& getStats() const { return stats; }
+
+private:
+    //==============================================================================
+    struct Entry
+    {
+        Client* client = nullptr;
+        Mode mode = Mode::kIdle;
+    };
+
+    void add(Client& client, Mode initialMode);
+    void remove(Client& client);
+    void setMode(Client& client, Mode mode);
+    Mode getMode(const Client& client) const;
+
+    /** Attach/detach the vblank callback and start/stop the watch timer to match the client modes. */
+    void updateSources();
+
+    /** Drop the vblank attachment; parked until handleAsyncUpdate() while its own callback is running. */
+    void retireVBlank();
+
+    void vblankCallback();
+    void timerCallback() override;
+    void handleAsyncUpdate() override;
+
+    //==============================================================================
+    std::vector<Entry> entries;
+    std::unique_ptr<juce::VBlankAttachment> vblank;
+    Client* vblankAnchor = nullptr;
+
+    // tick(true) runs inside the attachment's std::function, so an attachment replaced
+    // during that pass must outlive the call
+    bool inVBlankCallback = false;
+    std::vector<std::unique_ptr<juce::VBlankAttachment>> retiredVBlanks;
+    Stats stats;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RefreshScheduler)
+};
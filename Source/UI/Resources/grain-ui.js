@@ -441,6 +441,188 @@ class MeterBar {
     }
 }
 
+/* ================================================================
+   TruePeakReadout Component — max-hold dBTP, click to reset
+   ================================================================ */
+
+class TruePeakReadout {
+    constructor(container) {
+        this.container = container;
+        this.lastText = "";
+
+        this.el = document.createElement("div");
+        this.el.className = "truepeak-readout";
+        this.el.title = "True peak hold (click to reset)";
+        this.el.addEventListener("click", function() {
+            window.__JUCE__.backend.emitEvent("resetTruePeakHold", {});
+        });
+        this.container.appendChild(this.el);
+
+        this.update(-120);
+    }
+
+    update(holdDb) {
+        var text = holdDb <= -120 ? "-inf dBTP" : (holdDb > 0 ? "+" : "") + holdDb.toFixed(1) + " dBTP";
+
+        // Avoid DOM writes at meter rate when nothing changed
+        if (text === this.lastText) {
+            return;
+        }
+
+        this.lastText = text;
+        this.el.textContent = text;
+        this.el.classList.toggle("over", holdDb > 0);
+    }
+}
+
+/* ================================================================
+   LoudnessReadout Component — short-term LUFS (+ integrated, click to reset)
+   ================================================================ */
+
+function formatLufs(value) {
+    return value <= -70 ? "--" : value.toFixed(1);
+}
+
+class LoudnessReadout {
+    constructor(container, showIntegrated) {
+        this.container = container;
+        this.lastText = "";
+
+        this.el = document.createElement("div");
+        this.el.className = "loudness-readout";
+        this.showIntegrated = showIntegrated;
+
+        if (showIntegrated) {
+            this.el.title = "Short-term / integrated loudness (click to reset integrated)";
+            this.el.classList.add("resettable");
+            this.el.addEventListener("click", function() {
+                window.__JUCE__.backend.emitEvent("resetLoudness", {});
+            });
+        } else {
+            this.el.title = "Short-term loudness";
+        }
+
+        this.container.appendChild(this.el);
+        this.update(-120, -120);
+    }
+
+    update(shortTerm, integrated) {
+        var text = formatLufs(shortTerm) + " LUFS";
+        if (this.showIntegrated) {
+            text += " \u00b7 I " + formatLufs(integrated);
+        }
+
+        if (text !== this.lastText) {
+            this.lastText = text;
+            this.el.textContent = text;
+        }
+    }
+}
+
+/* ================================================================
+   AutoGainButton Component — loudness-matched output (shows trim)
+   ================================================================ */
+
+class AutoGainButton {
+    constructor(container) {
+        this.container = container;
+        this.state = new ToggleState("autoGainToggle");
+        this.trimDb = 0;
+
+        this.button = document.createElement("button");
+        this.button.className = "autogain-button";
+        this.button.title = "Match output loudness to input";
+
+        var self = this;
+        this.button.addEventListener("click", function() {
+            self.state.setValue(!self.state.getValue());
+            self._updateVisual();
+        });
+
+        this.container.appendChild(this.button);
+
+        this.state.addValueListener(() => this._updateVisual());
+        this.state.requestInitialUpdate();
+        this._updateVisual();
+    }
+
+    setTrim(trimDb) {
+        if (Math.abs(trimDb - this.trimDb) >= 0.05) {
+            this.trimDb = trimDb;
+            this._updateVisual();
+        }
+    }
+
+    _updateVisual() {
+        var on = this.state.getValue();
+        this.button.classList.toggle("active", on);
+
+        if (on) {
+            this.button.textContent = "AUTO " + (this.trimDb >= 0 ? "+" : "") + this.trimDb.toFixed(1) + " dB";
+        } else {
+            this.button.textContent = "AUTO";
+        }
+    }
+}
+
+/* ================================================================
+   HarmonicReadout Component — THD, even/odd balance, difference spectrum
+   ================================================================ */
+
+class HarmonicReadout {
+    constructor(container) {
+        this.container = container;
+
+        this.text = document.createElement("span");
+        this.text.className = "harmonic-text";
+        this.container.appendChild(this.text);
+
+        this.canvas = document.createElement("canvas");
+        this.canvas.className = "harmonic-spectrum";
+        this.canvas.width = 96;
+        this.canvas.height = 16;
+        this.canvas.title = "Output minus dry, 20 Hz - Nyquist";
+        this.container.appendChild(this.canvas);
+
+        this.update({ valid: false, diff: [] });
+    }
+
+    update(data) {
+        if (!data.valid) {
+            this.text.textContent = "THD -- \u00b7 E/O --";
+        } else {
+            var eo = (data.evenOdd >= 0 ? "+" : "") + data.evenOdd.toFixed(1);
+            this.text.textContent = "THD " + data.thd.toFixed(2) + "% \u00b7 E/O " + eo + " dB";
+        }
+
+        this._drawSpectrum(data.diff || []);
+    }
+
+    _drawSpectrum(diff) {
+        var ctx = this.canvas.getContext("2d");
+        var w = this.canvas.width;
+        var h = this.canvas.height;
+        var mid = h / 2;
+        var rangeDb = 24;
+
+        ctx.clearRect(0, 0, w, h);
+        ctx.fillStyle = "rgba(0,0,0,0.15)";
+        ctx.fillRect(0, mid, w, 1);
+
+        if (diff.length === 0) {
+            return;
+        }
+
+        var barW = w / diff.length;
+        for (var i = 0; i < diff.length; i++) {
+            var v = Math.max(-rangeDb, Math.min(rangeDb, diff[i])) / rangeDb;
+            var barH = Math.abs(v) * mid;
+            ctx.fillStyle = v >= 0 ? "#d97706" : "#4a4a4a";
+            ctx.fillRect(i * barW, v >= 0 ? mid - barH : mid, Math.max(1, barW - 1), barH);
+        }
+    }
+}
+
 /* ================================================================
    FocusSwitch Component
    ================================================================ */
@@ -561,6 +743,59 @@ class BypassButton {
     }
 }
 
+/* ================================================================
+   Telemetry Decoder — packed per-tick frame from TelemetryPacker
+   ================================================================ */
+
+var TELEMETRY_VERSION = 1;
+var TELEMETRY_METERS = 1;
+var TELEMETRY_LOUDNESS = 2;
+var TELEMETRY_ENVELOPE = 4;
+var TELEMETRY_ANALYSIS = 8;
+
+// Layout (little-endian): [u32 version][u32 flags], then per set flag in
+// ascending order [u32 count][count x f32]. Unknown sections are skipped.
+function decodeTelemetry(base64) {
+    var raw = atob(base64);
+    var bytes = new Uint8Array(raw.length);
+    for (var i = 0; i < raw.length; i++) {
+        bytes[i] = raw.charCodeAt(i);
+    }
+
+    var view = new DataView(bytes.buffer);
+    if (bytes.length < 8 || view.getUint32(0, true) !== TELEMETRY_VERSION) {
+        return null;
+    }
+
+    var flags = view.getUint32(4, true);
+    var offset = 8;
+    var sections = {};
+
+    for (var bit = 1; bit !== 0 && bit <= flags; bit <<= 1) {
+        if ((flags & bit) === 0) {
+            continue;
+        }
+        if (offset + 4 > bytes.length) {
+            return null;
+        }
+
+        var count = view.getUint32(offset, true);
+        offset += 4;
+        if (offset + count * 4 > bytes.length) {
+            return null;
+        }
+
+        var values = new Float32Array(count);
+        for (var j = 0; j < count; j++) {
+            values[j] = view.getFloat32(offset + j * 4, true);
+        }
+        offset += count * 4;
+        sections[bit] = values;
+    }
+
+    return sections;
+}
+
 /* ================================================================
    Initialization
    ================================================================ */
@@ -613,6 +848,11 @@ document.addEventListener("DOMContentLoaded", function() {
     // Meters
     var inMeter = new MeterBar(document.getElementById("meter-in"), "IN");
     var outMeter = new MeterBar(document.getElementById("meter-out"), "OUT");
+    var truePeak = new TruePeakReadout(document.getElementById("meter-out"));
+    var loudnessIn = new LoudnessReadout(document.getElementById("meter-in"), false);
+    var loudnessOut = new LoudnessReadout(document.getElementById("meter-out"), true);
+    var autoGain = new AutoGainButton(document.getElementById("meter-out"));
+    var harmonics = new HarmonicReadout(document.getElementById("harmonic-analysis"));
 
     // Focus switch
     var focusSwitch = new FocusSwitch(document.getElementById("focus-switch"));
@@ -620,9 +860,46 @@ document.addEventListener("DOMContentLoaded", function() {
     // Bypass button
     var bypassBtn = new BypassButton(document.getElementById("bypass-btn"));
 
-    // Meter updates from C++ (custom event, not relay)
-    window.__JUCE__.backend.addEventListener("meterUpdate", function(data) {
-        inMeter.update(data.inL, data.inR);
-        outMeter.update(data.outL, data.outR);
+    // Scoped to the knob so an envelope change only restyles its glow
+    var grainKnobElement = document.getElementById("knob-grain");
+
+    // One packed telemetry frame per tick from C++ (sent only when something changed)
+    window.__JUCE__.backend.addEventListener("telemetry", function(payload) {
+        var t = decodeTelemetry(payload);
+        if (t === null) {
+            return;
+        }
+
+        var m = t[TELEMETRY_METERS];
+        if (m && m.length >= 5) {
+            inMeter.update(m[0], m[1]);
+            outMeter.update(m[2], m[3]);
+            truePeak.update(m[4]);
+        }
+
+        var l = t[TELEMETRY_LOUDNESS];
+        if (l && l.length >= 4) {
+            loudnessIn.update(l[0], -120);
+            loudnessOut.update(l[1], l[2]);
+            autoGain.setTrim(l[3]);
+        }
+
+        // Dynamic Bias envelope: drives the glow around the GRAIN knob (see grain-ui.css)
+        var e = t[TELEMETRY_ENVELOPE];
+        if (e && e.length >= 1) {
+            grainKnobElement.style.setProperty("--grain-envelope", Math.min(1, e[0]).toFixed(3));
+        }
+
+        // Harmonic analysis: only present when the analyzer published a new result (~10 Hz)
+        var a = t[TELEMETRY_ANALYSIS];
+        if (a && a.length >= 4) {
+            harmonics.update({
+                valid: a[0] > 0.5,
+                f0: a[1],
+                thd: a[2],
+                evenOdd: a[3],
+                diff: Array.prototype.slice.call(a, 4)
+            });
+        }
     });
 });
@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    TelemetryPacker.cpp
+    GRAIN — Compact binary telemetry frames implementation.
+
+  ==============================================================================
+*/
+
+#include "TelemetryPacker.h"
+
+namespace
+{
+constexpr size_t kFlagsOffset = 4;          // after the version word
+constexpr size_t kTypicalFrameBytes = 256;  // meters + loudness + envelope + analysis
+}  // namespace
+
+//==============================================================================
+TelemetryPacker::TelemetryPacker()
+{
+    frame.reserve(kTypicalFrameBytes);
+    lastCommitted.reserve(kTypicalFrameBytes);
+    beginFrame();
+}
+
+void TelemetryPacker::beginFrame()
+{
+    frame.clear();
+    sectionFlags = 0;
+    appendWord(kVersion);
+    appendWord(0);  // flags, patched as sections are added
+}
+
+void TelemetryPacker::appendWord(juce::uint32 word)
+{
+    const auto littleEndian = juce::ByteOrder::swapIfBigEndian(word);
+    const auto* bytes = reinterpret_cast<const juce::uint8*>(&littleEndian);
+    frame.insert(frame.end(), bytes, bytes + sizeof(littleEndian));
+}
+
+//==============================================================================
+void TelemetryPacker::addSection(Section section, const float* values, int count)
+{
+    // Decoder relies on ascending order and one occurrence per section
+    jassert(static_cast<juce::uint32>(section) > sectionFlags);
+
+    sectionFlags |= static_cast<juce::uint32>(section);
+    const auto flagsLittleEndian = juce::ByteOrder::swapIfBigEndian(sectionFlags);
+    std::memcpy(frame.data() + kFlagsOffset, &flagsLittleEndian, sizeof(flagsLittleEndian));
+
+    appendWord(static_cast<juce::uint32>(std::max(0, count)));
+
+    for (int i = 0; i < count; ++i)
+    {
+        juce::uint32 bits = 0;
+        std::memcpy(&bits, values + i, sizeof(bits));
+        appendWord(bits);
+    }
+}
+
+void TelemetryPacker::addSection(Section section, std::initializer_list<float> values)
+{
+    addSection(section, values.begin(), static_cast<int>(values.size()));
+}
+
+//==============================================================================
+bool TelemetryPacker::hasChangedSinceLastCommit() const
+{
+    return frame != lastCommitted;
+}
+
+juce::String TelemetryPacker::commit()
+{
+    lastCommitted = frame;
+    return juce::Base64::toBase64(frame.data(), frame.size());
+}
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    TelemetryPacker.h
+    GRAIN — Compact binary telemetry frames for the WebView UI.
+    Packs all per-frame meter/loudness/envelope/analysis values into one
+    base64 string instead of building a DynamicObject per event.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <initializer_list>
+#include <vector>
+
+//==============================================================================
+/**
+ * Builds one telemetry frame per UI tick.
+ *
+ * Wire format (little-endian, 4-byte words), base64 encoded:
+ *   [u32 version][u32 section flags]
+ *   then, for each set flag in ascending bit order:
+ *   [u32 count][count × f32]
+ *
+ * Sections are optional per frame (e.g. analysis only when a new result
+ * exists), and the decoder in grain-ui.js skips sections it does not know,
+ * so fields can be appended without breaking older UIs.
+ *
+ * Usage (message thread):
+ *   packer.beginFrame();
+ *   packer.addSection(TelemetryPacker::kMeters, {inL, inR, outL, outR, tp});
+ *   if (packer.hasChangedSinceLastCommit())
+ *       webView.emitEventIfBrowserIsVisible("telemetry", packer.commit());
+ */
+class TelemetryPacker
+{
+public:
+    //==============================================================================
+    static constexpr juce::uint32 kVersion = 1;
+
+    /** Section flags (bit order = order in the frame). */
+    enum Section : juce::uint32
+    {
+        kMeters = 1u << 0,    ///< inL, inR, outL, outR (linear), true-peak hold (dBTP)
+        kLoudness = 1u << 1,  ///< input short-term, output short-term, output integrated (LUFS), auto-gain trim (dB)
+        kEnvelope = 1u << 2,  ///< Dynamic Bias RMS envelope
+        kAnalysis = 1u << 3,  ///< valid, f0, THD %, even/odd dB, then the difference bands (dB)
+    };
+
+    //==============================================================================
+    TelemetryPacker();
+
+    /** Start a new frame (keeps allocated storage). */
+    void beginFrame();
+
+    /** Append a section. Sections must be added in ascending flag order, each at most once. */
+    void addSection(Section section, const float* values, int count);
+    void addSection(Section section, std::initializer_list<float> values);
+
+    /** @return true if the current frame differs from the last committed one. */
+    bool hasChangedSinceLastCommit() const;
+
+    /** Encode the current frame and remember it as the last one sent.
+     *  @return Base64 string of the packed frame. */
+    juce::String commit();
+
+    /** @return The raw packed bytes of the current frame (for tests). */
+    const std::vector<juce::uint8>& getFrameBytes() const { return frame; }
+
+private:
+    //==============================================================================
+    void appendWord(juce::uint32 word);
+
+    std::vector<juce::uint8> frame;
+    std::vector<juce::uint8> lastCommitted;
+    juce::uint32 sectionFlags = 0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TelemetryPacker)
+};